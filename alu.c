@@ -11,10 +11,12 @@
  * @since 2019-01-15
  * @author philip gust
  */
-#include <stdlib.h>
 #include <stdio.h>
 
 #include "alu.h"
+#include "alu_instrument.h"
+#include "alu_native.h"
+#include "alu_ref.h"
 
 /**
  * Returns true if word is less than zero.
@@ -24,19 +26,19 @@
  *   testLtWord(1111 1111 0000 1111) -> true
  */
 bool testLtWord(const word op) {
-    bit bitofsign = getBitOfWord(op, 31);
-    if (bitofsign == 1) {
-        return true;
-    } else
-        return false;
-
-    // NOTES:
-    // A word is negative only if its sign bit
-    // (wordtopbit) is set.
+    INSTRUMENT_BEGIN(instTestLt);
+#ifdef ALU_REFERENCE
+    bool r = testLtWordRef(op);
+#else
+    // the sign bit is in the top byte in either byte order
+    bool r = (op[wordByteIndex(wordbytes - 1)] & 0x80) != 0;
+#endif
+    INSTRUMENT_END(instTestLt);
+    return r;
 }
 
 /**
- * Returns true if word is less than zero.
+ * Returns true if word is greater than or equal to zero.
  *
  * Examples (big-endian):
  *   testGeWord(0000 0000 0000 0000) -> true
@@ -44,14 +46,14 @@ bool testLtWord(const word op) {
  *   testGeWord(1111 1111 0000 1111) -> false
  */
 bool testGeWord(const word op) {
-    bit bitofsign = getBitOfWord(op, 31);
-    if (bitofsign == 1) {
-        return false;
-    } else
-        return true;
-    // NOTES:
-    // This is the inverse of the LT condition.
-
+    INSTRUMENT_BEGIN(instTestGe);
+#ifdef ALU_REFERENCE
+    bool r = testGeWordRef(op);
+#else
+    bool r = (op[wordByteIndex(wordbytes - 1)] & 0x80) == 0;
+#endif
+    INSTRUMENT_END(instTestGe);
+    return r;
 }
 
 /**
@@ -62,18 +64,167 @@ bool testGeWord(const word op) {
  *   testEqWord(0000 1111 1111 1111) -> false
  */
 bool testEqWord(const word op) {
+    INSTRUMENT_BEGIN(instTestEq);
+#ifdef ALU_REFERENCE
+    bool r = testEqWordRef(op);
+#else
+    bool r = loadWord(op) == 0;
+#endif
+    INSTRUMENT_END(instTestEq);
+    return r;
+}
 
-    for (int b = 0; b <= wordtopbit; b++) {
-        if (getBitOfWord(op, b) != 0) {
-            return false;
-        }
-    }
+/**
+ * Signed comparison of two word operands.
+ *
+ * Examples (big-endian):
+ *   cmpWord(1111 1111 1111 1111, 0000 0000 0000 0001) -> -1
+ *   cmpWord(0000 0000 0000 0010, 0000 0000 0000 0001) -> 1
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpWord(const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instCmp);
+#ifdef ALU_REFERENCE
+    int r = cmpWordRef(op1, op2);
+#else
+    int r = nativeCmp(loadWord(op1), loadWord(op2));
+#endif
+    INSTRUMENT_END(instCmp);
+    return r;
+}
+
+/**
+ * Unsigned comparison of two word operands.
+ *
+ * Examples (big-endian):
+ *   cmpuWord(1111 1111 1111 1111, 0000 0000 0000 0001) -> 1
+ *   cmpuWord(0000 0000 0000 0001, 0000 0000 0000 0001) -> 0
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpuWord(const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instCmpu);
+#ifdef ALU_REFERENCE
+    int r = cmpuWordRef(op1, op2);
+#else
+    int r = nativeCmpu(loadWord(op1), loadWord(op2));
+#endif
+    INSTRUMENT_END(instCmpu);
+    return r;
+}
+
+/**
+ * Returns true if op1 is less than op2 as unsigned words.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is less than op2
+ */
+bool cmpLtuWord(const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instCmpLtu);
+#ifdef ALU_REFERENCE
+    bool r = cmpLtuWordRef(op1, op2);
+#else
+    bool r = loadWord(op1) < loadWord(op2);
+#endif
+    INSTRUMENT_END(instCmpLtu);
+    return r;
+}
+
+/**
+ * Returns true if op1 is greater than or equal to op2 as
+ * unsigned words.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is greater than or equal to op2
+ */
+bool cmpGeuWord(const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instCmpGeu);
+#ifdef ALU_REFERENCE
+    bool r = cmpGeuWordRef(op1, op2);
+#else
+    bool r = loadWord(op1) >= loadWord(op2);
+#endif
+    INSTRUMENT_END(instCmpGeu);
+    return r;
+}
 
-    return true;
+/**
+ * Signed minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void sminWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instSmin);
+#ifdef ALU_REFERENCE
+    sminWordRef(result, op1, op2);
+#else
+    uword a = loadWord(op1), b = loadWord(op2);
+    storeWord(result, nativeSmin(a, b));
+#endif
+    INSTRUMENT_END(instSmin);
+}
 
-    // NOTES:
-    // Return true if all bits of word are 0
+/**
+ * Signed maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void smaxWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instSmax);
+#ifdef ALU_REFERENCE
+    smaxWordRef(result, op1, op2);
+#else
+    uword a = loadWord(op1), b = loadWord(op2);
+    storeWord(result, nativeSmax(a, b));
+#endif
+    INSTRUMENT_END(instSmax);
+}
 
+/**
+ * Unsigned minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void uminWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instUmin);
+#ifdef ALU_REFERENCE
+    uminWordRef(result, op1, op2);
+#else
+    uword a = loadWord(op1), b = loadWord(op2);
+    storeWord(result, nativeUmin(a, b));
+#endif
+    INSTRUMENT_END(instUmin);
+}
+
+/**
+ * Unsigned maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void umaxWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instUmax);
+#ifdef ALU_REFERENCE
+    umaxWordRef(result, op1, op2);
+#else
+    uword a = loadWord(op1), b = loadWord(op2);
+    storeWord(result, nativeUmax(a, b));
+#endif
+    INSTRUMENT_END(instUmax);
 }
 
 /**
@@ -90,39 +241,13 @@ bool testEqWord(const word op) {
  * @param count the shift count
  */
 void ashWord(word result, const word op, int count) {
-    int c = abs(count);
-    if (c >= wordsize) {
-        c = wordsize - 1;
-    }
-
-    // local copy in case op and result overlap
-    word localop;
-    setWord(localop, op);
-
-    bit sign = getBitOfWord(localop, wordtopbit);
-    if (count < 0) {
-        // move upper bits of word right
-        for (int b = wordtopbit - 1; b >= c; b--) {
-            bit t = getBitOfWord(localop, b);
-            setBitOfWord(result, b - c, t);
-        }
-        // clear upper bits of word to sign bit
-        for (int b = c; b >= 1; b--) {
-            setBitOfWord(result, wordtopbit - b, sign);
-        }
-    } else {
-        // move lower bits of word left
-        for (int b = wordtopbit - 1; b >= c; b--) {
-            bit t = getBitOfWord(localop, b - c);
-            setBitOfWord(result, b, t);
-        }
-        // clear lower bits of word
-        for (int b = c - 1; b >= 0; b--) {
-            setBitOfWord(result, b, 0);
-        }
-    }
-    // set top bit of word
-    setBitOfWord(result, wordtopbit, sign);
+    INSTRUMENT_BEGIN(instAsh);
+#ifdef ALU_REFERENCE
+    ashWordRef(result, op, count);
+#else
+    storeWord(result, nativeAsh(loadWord(op), count));
+#endif
+    INSTRUMENT_END(instAsh);
 }
 
 /**
@@ -139,52 +264,13 @@ void ashWord(word result, const word op, int count) {
  * @param count the shift count
  */
 void cshWord(word result, const word op, int count) {
-
-    int c = abs(count);
-    //If count > 32 scale down the count accordingly since the shift is circular
-    if (c > 32) {
-        c = c - 32;
-    }
-    //If count is 0 or a multiple of 32 the shift count is zero
-    if ((c == 0) || (c % 32 == 0)) {
-        setWord(result, op);
-    }
-
-    // local copy in case op and result overlap
-    word localop;
-    setWord(localop, op);
-    //Compute the bit position in result word using the C remainder operator (%) with wordsize
-
-    if (c < wordsize / 2) {
-        for (int b = wordtopbit; b > wordtopbit - c; b--) {
-            bit t = getBitOfWord(localop, b);
-            setBitOfWord(result, b % (32 - c), t);
-        }
-
-        for (int p = wordtopbit - c; p >= c; p--) {
-            bit t = getBitOfWord(localop, p);
-            setBitOfWord(result, (p % (32 - c)) + c, t);
-        }
-    }
-
-    if (c >= wordsize / 2) {
-        for (int b = wordtopbit; b > wordtopbit - c; b--) {
-            bit t = getBitOfWord(localop, b);
-            setBitOfWord(result, b - (32 - c), t);
-        }
-
-        for (int p = wordtopbit - c; p >= 0; p--) {
-            bit t = getBitOfWord(localop, p);
-            setBitOfWord(result, (p % c) + c, t);
-        }
-    }
-    // NOTES:
-    // Set bits in result, from op, shifted left or right
-    // based on the sign of the count. Compute the position
-    // in result word using the C remainder operator (%) with
-    // wordsize to "wrap around" to the position on the other
-    // end of result word.
-
+    INSTRUMENT_BEGIN(instCsh);
+#ifdef ALU_REFERENCE
+    cshWordRef(result, op, count);
+#else
+    storeWord(result, nativeCsh(loadWord(op), count));
+#endif
+    INSTRUMENT_END(instCsh);
 }
 
 /**
@@ -200,40 +286,13 @@ void cshWord(word result, const word op, int count) {
  * @param count the shift count
  */
 void lshWord(word result, const word op, int count) {
-    int c = abs(count);
-    if (c >= wordsize) {
-        c = wordsize - 1;
-    }
-    word localop; //localcopy
-    setWord(localop, op);
-
-    if (count < 0) {
-        // move upper bits of word right
-        for (int b = wordtopbit; b >= c; b--) {
-            bit t = getBitOfWord(localop, b);
-            setBitOfWord(result, b - c, t);
-        }
-        // clear upper bits of word to zero
-        for (int b = c - 1; b >= 0; b--) {
-            setBitOfWord(result, wordtopbit - b, 0);
-        }
-    } else {
-        // move lower bits of word left
-        for (int b = wordtopbit; b >= c; b--) {
-            bit t = getBitOfWord(localop, b - c);
-            setBitOfWord(result, b, t);
-        }
-        // clear lower bits of word
-        for (int b = c - 1; b >= 0; b--) {
-            setBitOfWord(result, b, 0);
-        }
-    }
-
-    // NOTES:
-    // Set bits in result from op, shifted left or
-    // right based on the sign o the count. Then fill
-    // in result bits from left or right with 0 bits.
-
+    INSTRUMENT_BEGIN(instLsh);
+#ifdef ALU_REFERENCE
+    lshWordRef(result, op, count);
+#else
+    storeWord(result, nativeLsh(loadWord(op), count));
+#endif
+    INSTRUMENT_END(instLsh);
 }
 
 /**
@@ -249,36 +308,13 @@ void lshWord(word result, const word op, int count) {
  * @param count the mask count
  */
 void maskWord(word result, const word op, int count) {
-    int c = abs(count);
-    if (c > wordsize) {
-        c = wordsize;
-    }
-
-    if (count < 0) {
-        int wtbc = wordtopbit - c;
-
-        // copy upper bits of word
-        for (int b = wordtopbit; b > wtbc; b--) {
-            bit t = getBitOfWord(op, b);
-            setBitOfWord(result, b, t);
-        }
-
-        // clear lower bits of word
-        for (int b = wtbc; b >= 0; b--) {
-            setBitOfWord(result, b, 0);
-        }
-    } else {
-        // copy lower bits of word
-        for (int b = 0; b < c; b++) {
-            bit t = getBitOfWord(op, b);
-            setBitOfWord(result, b, t);
-        }
-
-        // clear upper bits of word
-        for (int b = c; b <= wordtopbit; b++) {
-            setBitOfWord(result, b, 0);
-        }
-    }
+    INSTRUMENT_BEGIN(instMask);
+#ifdef ALU_REFERENCE
+    maskWordRef(result, op, count);
+#else
+    storeWord(result, nativeMask(loadWord(op), count));
+#endif
+    INSTRUMENT_END(instMask);
 }
 
 /**
@@ -292,19 +328,13 @@ void maskWord(word result, const word op, int count) {
  * @param op2 the second operand
  */
 void andWord(word result, const word op1, const word op2) {
-
-    //Extract each corresponding bit of both words and  perform AND operation
-    // to store the result bit in result at the corresponding position
-    for (int b = 0; b <= wordtopbit; b++) {
-        bit t1 = getBitOfWord(op1, b);
-        bit t2 = getBitOfWord(op2, b);
-        setBitOfWord(result, b, t1 & t2);
-    }
-
-    // NOTES:
-    // Use bit-wise AND operator (&) on each bit of op1
-    // and op2 to set each bit of the result.
-
+    INSTRUMENT_BEGIN(instAnd);
+#ifdef ALU_REFERENCE
+    andWordRef(result, op1, op2);
+#else
+    storeWord(result, loadWord(op1) & loadWord(op2));
+#endif
+    INSTRUMENT_END(instAnd);
 }
 
 /**
@@ -318,18 +348,13 @@ void andWord(word result, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void orWord(word result, const word op1, const word op2) {
-
-    //Extract each corresponding bit of both words and  perform OR operation
-    // to store the result bit in result at the corresponding position
-    for (int b = 0; b <= wordtopbit; b++) {
-        bit t1 = getBitOfWord(op1, b);
-        bit t2 = getBitOfWord(op2, b);
-        setBitOfWord(result, b, t1 | t2);
-    }
-    // NOTES:
-    // Use bit-wise OR operator (|) on each bit of op1
-    // and op2 to set each bit of the result.
-
+    INSTRUMENT_BEGIN(instOr);
+#ifdef ALU_REFERENCE
+    orWordRef(result, op1, op2);
+#else
+    storeWord(result, loadWord(op1) | loadWord(op2));
+#endif
+    INSTRUMENT_END(instOr);
 }
 
 /**
@@ -343,18 +368,13 @@ void orWord(word result, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void xorWord(word result, const word op1, const word op2) {
-
-    //Extract each corresponding bit of both words and  perform XOR operation
-    // to store the result bit in result at the corresponding position
-    for (int b = 0; b <= wordtopbit; b++) {
-        bit t1 = getBitOfWord(op1, b);
-        bit t2 = getBitOfWord(op2, b);
-        setBitOfWord(result, b, t1 ^ t2);
-    }
-    // NOTES:
-    // Use bit-wise XOR operator (^) on each bit of op1
-    // and op2 to set each bit of the result.
-
+    INSTRUMENT_BEGIN(instXor);
+#ifdef ALU_REFERENCE
+    xorWordRef(result, op1, op2);
+#else
+    storeWord(result, loadWord(op1) ^ loadWord(op2));
+#endif
+    INSTRUMENT_END(instXor);
 }
 
 /**
@@ -367,10 +387,13 @@ void xorWord(word result, const word op1, const word op2) {
  * @param op the operand
  */
 void notWord(word result, const word op) {
-    //Use notBit function to negate for each bit extracted and store it in result bit
-    for (int b = 0; b <= wordtopbit; b++) {
-        setBitOfWord(result, b, notBit(getBitOfWord(op, b)));
-    }
+    INSTRUMENT_BEGIN(instNot);
+#ifdef ALU_REFERENCE
+    notWordRef(result, op);
+#else
+    storeWord(result, ~loadWord(op));
+#endif
+    INSTRUMENT_END(instNot);
 }
 
 /**
@@ -384,12 +407,13 @@ void notWord(word result, const word op) {
  * @param op the operand
  */
 void negativeWord(word result, const word op) {
-
-    //Subtracting from zero to get negative word
-    subWord(result, zeroWord, op);
-    // NOTES:
-    // Equivalent to (0 - op).
-
+    INSTRUMENT_BEGIN(instNegative);
+#ifdef ALU_REFERENCE
+    negativeWordRef(result, op);
+#else
+    storeWord(result, -loadWord(op));
+#endif
+    INSTRUMENT_END(instNegative);
 }
 
 /**
@@ -400,40 +424,13 @@ void negativeWord(word result, const word op) {
  * @param op2 the second operand
  */
 void addWord(word result, const word op1, const word op2) {
-
-    bit carry = 0;
-    for (uint8_t b = 0; b <= wordtopbit; b++) {
-        // can be 0..3
-        uint8_t r = getBitOfWord(op1, b) + getBitOfWord(op2, b) + carry;
-        carry = r >> 1;
-        setBitOfWord(result, b, toBit(r));
-    }
-
-    // NOTES:
-    // The algorithm requires adding the bits of
-    // op1 and op2 starting from the least significant
-    // bit. If the sum is greater than 1, then use the
-    // lower bit of the sum as the bit for that position
-    // and carry 1 to the next bits if the sum is 2 or 3.
-    // The initial value of the carry bit is 0.
-    //
-    //     0 1 1 0  (6)
-    //   + 1 1 1 1  (-1)
-    //     -------
-    //           1  sum
-    //         0    carry
-    //     -------
-    //         0 1  sum
-    //       1      carry
-    //     -------
-    //       1 0 1  sum
-    //     1        carry
-    //     -------
-    //     0 1 0 1  sum
-    //   1          carry
-    //
-    // Final sum is 0101 (5)
-
+    INSTRUMENT_BEGIN(instAdd);
+#ifdef ALU_REFERENCE
+    addWordRef(result, op1, op2);
+#else
+    storeWord(result, loadWord(op1) + loadWord(op2));
+#endif
+    INSTRUMENT_END(instAdd);
 }
 
 /**
@@ -444,98 +441,128 @@ void addWord(word result, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void subWord(word result, const word op1, const word op2) {
-    bit carry = 1;
-    for (uint8_t b = 0; b <= wordtopbit; b++) {
-        // can be 0..3
-        uint8_t r = getBitOfWord(op1, b) + notBit(getBitOfWord(op2, b)) + carry;
-        carry = r >> 1;
-        setBitOfWord(result, b, toBit(r));
-    }
+    INSTRUMENT_BEGIN(instSub);
+#ifdef ALU_REFERENCE
+    subWordRef(result, op1, op2);
+#else
+    storeWord(result, loadWord(op1) - loadWord(op2));
+#endif
+    INSTRUMENT_END(instSub);
 }
 
 /**
- * Product of two word operands.
+ * Sum of two word operands also returning the carry out
+ * of the top bit and whether the signed sum overflowed.
  *
  * @param result the result
+ * @param carry the carry out, or NULL
+ * @param overflow the signed overflow, or NULL
  * @param op1 the first operand
  * @param op2 the second operand
  */
-void mulWord(word result, const word op1, const word op2) {
-
-    word localop1; //localcopy
-    setWord(localop1, op1);
-
-    word localop2; //localcopy
-    setWord(localop2, op2);
-
-    //Setting result to zero
-    setWord(result, zeroWord);
-
-    //Setting up a word of value 1 to compute 2's complement
-    word one;
-    setWord(one, zeroWord);
-    setBitOfWord(one, 0, 1);
-
-    bool negativeProduct = false;
-
-    bit msb1 = getBitOfWord(localop1, 31);
-    bit msb2 = getBitOfWord(localop2, 31);
-
-    //Checking if any one operand is negative
-    if ((msb1 ^ msb2) == 1)
-        negativeProduct = true;
-
-    //Convert the negative numbers to positive ones
-    if (msb1 == 1) {
-        notWord(localop1, localop1);
-        addWord(localop1, localop1, one);
+void addCarryWord(word result, bit *carry, bit *overflow,
+                  const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instAddCarry);
+#ifdef ALU_REFERENCE
+    addCarryWordRef(result, carry, overflow, op1, op2);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword r = a + b;
+    if (carry != NULL) {
+        *carry = r < a;  // sum wrapped around
     }
-
-    if (msb2 == 1) {
-        notWord(localop2, localop2);
-        addWord(localop2, localop2, one);
+    if (overflow != NULL) {
+        // operands have same sign and result sign differs
+        *overflow = toBit(((a ^ r) & (b ^ r)) >> wordtopbit);
     }
+    storeWord(result, r);
+#endif
+    INSTRUMENT_END(instAddCarry);
+}
 
-    while (testEqWord(localop2) == false) {
-
-        if (getBitOfWord(localop2, 0) != 0) {
-            addWord(result, result, localop1);
-        }
-
-        lshWord(localop1, localop1, 1);
-        lshWord(localop2, localop2, -1);
-
+/**
+ * Difference of two word operands also returning the carry
+ * out of the top bit and whether the signed difference
+ * overflowed. Carry is set if no borrow occurred.
+ *
+ * @param result the result
+ * @param carry the carry out (set if no borrow), or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subCarryWord(word result, bit *carry, bit *overflow,
+                  const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instSubCarry);
+#ifdef ALU_REFERENCE
+    subCarryWordRef(result, carry, overflow, op1, op2);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword r = a - b;
+    if (carry != NULL) {
+        *carry = a >= b;  // no borrow
     }
-
-    //Negate the result if one of the operands is negative
-    if (negativeProduct == true) {
-        notWord(result, result);
-        addWord(result, result, one);
+    if (overflow != NULL) {
+        // operands have different signs and result sign differs from op1
+        *overflow = toBit(((a ^ b) & (a ^ r)) >> wordtopbit);
     }
+    storeWord(result, r);
+#endif
+    INSTRUMENT_END(instSubCarry);
+}
 
-    // NOTES:
-    // The algorithm require making op2 positive.
-    // Can be done by making taking the negative of
-    // both operands if op2 is negative, or by making
-    // both operands positive and applying the sign at
-    // the end.
-    //
-    // Here is how to multiply two binary numbers. For
-    // each bit in op2 from the least to most significant
-    // bit, left shift op1 left by 1, and if bit of op2
-    // is set, add shifted op1 into results. Here is an
-    // example for a 4-bit number.
-    //
-    //          0 0 1 1
-    //       x  1 1 0 1
-    //       ----------
-    //          0 0 1 1
-    //        0 0 0 0
-    //      0 0 1 1
-    //  + 0 0 1 1
-    //    -------------
-    //    0 1 0 0 1 1 1
+/**
+ * Product of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instMul);
+#ifdef ALU_REFERENCE
+    mulWordRef(result, op1, op2);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+
+    // low word of the product is the same for signed and unsigned operands
+    storeWord(result, nativeMul(a, b));
+#endif
+    INSTRUMENT_END(instMul);
+}
 
+/**
+ * Full product of two word operands. The signed product of
+ * two words needs two words: hi receives the upper wordsize
+ * bits and lo the lower wordsize bits, which are the same
+ * as the result of mulWord(). hi and lo must be different
+ * words, but either may be the same as an operand.
+ *
+ * Examples:
+ *   mulWide(0100 0000 0000 0000, 0000 0000 0000 0100)
+ *     -> hi 0000 0000 0000 0001, lo 0000 0000 0000 0000
+ *   mulWide(1111 1111 1111 1111, 0000 0000 0000 0010)
+ *     -> hi 1111 1111 1111 1111, lo 1111 1111 1111 1110
+ *
+ * @param hi the upper word of the product
+ * @param lo the lower word of the product
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWideWord(word hi, word lo, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instMulWide);
+#ifdef ALU_REFERENCE
+    mulWideWordRef(hi, lo, op1, op2);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    storeWord(lo, nativeMul(a, b));
+    storeWord(hi, nativeMulHigh(a, b));
+#endif
+    INSTRUMENT_END(instMulWide);
 }
 
 /**
@@ -550,52 +577,16 @@ void mulWord(word result, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void div2Word(word result, word remainder, const word op1, const word op2) {
-    setWord(result, zeroWord);
-    setWord(remainder, zeroWord);
-
-    if (testEqWord(op2)) {
-        // handle divide by 0 by returning largest
-        // positive or negative number
-        setWord(result, (testGeWord(op1) ? maxWord : minWord));
-    } else {
-        word w1, w2;
-        bool resultNegative = false;
-        // operands must be positive
-        if (testLtWord(op1)) {
-            negativeWord(w1, op1);
-            resultNegative = !resultNegative;
-        } else {
-            setWord(w1, op1);
-        }
-        if (testLtWord(op2)) {
-            negativeWord(w2, op2);
-            resultNegative = !resultNegative;
-        } else {
-            setWord(w2, op2);
-        }
-
-        //
-        for (int b = wordtopbit; b >= 0; b--) {
-            lshWord(remainder, remainder, 1);    // position remainder
-            bit t = getBitOfWord(w1, b);    // bring down next bit
-            setBitOfWord(remainder, 0, t);
-
-            word test;
-            subWord(test, remainder, w2);  // do trial subtract
-            if (testGeWord(test)) {    // division successful if still positive
-                setBitOfWord(result, b, 1);    // shift bit into result
-                setWord(remainder, test);   // update remainder
-            }
-        }
-
-        if (resultNegative) {    // set correct sign of result
-            negativeWord(result, result);
-        }
-
-        if (testLtWord(op1)) { // remainder negative if op1 is negative
-            negativeWord(remainder, remainder);
-        }
-    }
+    INSTRUMENT_BEGIN(instDiv2);
+#ifdef ALU_REFERENCE
+    div2WordRef(result, remainder, op1, op2);
+#else
+    uword r;
+    uword q = nativeDiv2(&r, loadWord(op1), loadWord(op2));
+    storeWord(result, q);
+    storeWord(remainder, r);
+#endif
+    INSTRUMENT_END(instDiv2);
 }
 
 /**
@@ -609,8 +600,10 @@ void div2Word(word result, word remainder, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void divWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instDiv);
     word remainder;
     div2Word(result, remainder, op1, op2);
+    INSTRUMENT_END(instDiv);
 }
 
 /**
@@ -622,6 +615,199 @@ void divWord(word result, const word op1, const word op2) {
  * @param op2 the second operand
  */
 void remainderWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instRemainder);
     word quotient;
     div2Word(quotient, result, op1, op2);
+    INSTRUMENT_END(instRemainder);
+}
+
+/**
+ * Upper word of the product of two unsigned word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulHighuWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instMulHighu);
+#ifdef ALU_REFERENCE
+    mulHighuWordRef(result, op1, op2);
+#else
+    storeWord(result, nativeMulHighu(loadWord(op1), loadWord(op2)));
+#endif
+    INSTRUMENT_END(instMulHighu);
+}
+
+/**
+ * Quotient of two unsigned word operands also returning
+ * remainder. Divide by 0 gives a quotient of all ones, the
+ * largest unsigned number, and a remainder of 0.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2uWord(word result, word remainder, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instDiv2u);
+#ifdef ALU_REFERENCE
+    div2uWordRef(result, remainder, op1, op2);
+#else
+    uword r;
+    uword q = nativeDiv2u(&r, loadWord(op1), loadWord(op2));
+    storeWord(result, q);
+    storeWord(remainder, r);
+#endif
+    INSTRUMENT_END(instDiv2u);
+}
+
+/**
+ * Quotient of two unsigned word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void divuWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instDivu);
+    word remainder;
+    div2uWord(result, remainder, op1, op2);
+    INSTRUMENT_END(instDivu);
+}
+
+/**
+ * Remainder of two unsigned word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void remainderuWord(word result, const word op1, const word op2) {
+    INSTRUMENT_BEGIN(instRemainderu);
+    word quotient;
+    div2uWord(quotient, result, op1, op2);
+    INSTRUMENT_END(instRemainderu);
+}
+
+/**
+ * Number of set bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of set bits
+ */
+int popcountWord(const word op) {
+    INSTRUMENT_BEGIN(instPopcount);
+#ifdef ALU_REFERENCE
+    int r = popcountWordRef(op);
+#else
+    int r = (int)populationCount(loadWord(op));
+#endif
+    INSTRUMENT_END(instPopcount);
+    return r;
+}
+
+/**
+ * Number of leading zero bits of word operand, above
+ * the top set bit, or wordsize if op is zero.
+ *
+ * @param op the operand
+ * @return the number of leading zero bits
+ */
+int clzWord(const word op) {
+    INSTRUMENT_BEGIN(instClz);
+#ifdef ALU_REFERENCE
+    int r = clzWordRef(op);
+#else
+    int r = (int)leadingZeros(loadWord(op));
+#endif
+    INSTRUMENT_END(instClz);
+    return r;
+}
+
+/**
+ * Number of trailing zero bits of word operand, below
+ * the bottom set bit, or wordsize if op is zero.
+ *
+ * @param op the operand
+ * @return the number of trailing zero bits
+ */
+int ctzWord(const word op) {
+    INSTRUMENT_BEGIN(instCtz);
+#ifdef ALU_REFERENCE
+    int r = ctzWordRef(op);
+#else
+    int r = (int)trailingZeros(loadWord(op));
+#endif
+    INSTRUMENT_END(instCtz);
+    return r;
+}
+
+/**
+ * Bits of word operand in reverse order.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void bitReverseWord(word result, const word op) {
+    INSTRUMENT_BEGIN(instBitReverse);
+#ifdef ALU_REFERENCE
+    bitReverseWordRef(result, op);
+#else
+    storeWord(result, nativeBitReverse(loadWord(op)));
+#endif
+    INSTRUMENT_END(instBitReverse);
+}
+
+/**
+ * Bytes of word operand in reverse order.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void byteSwapWord(word result, const word op) {
+    INSTRUMENT_BEGIN(instByteSwap);
+#ifdef ALU_REFERENCE
+    byteSwapWordRef(result, op);
+#else
+    storeWord(result, nativeByteSwap(loadWord(op)));
+#endif
+    INSTRUMENT_END(instByteSwap);
+}
+
+/**
+ * Extract the bits of word operand at the set bits of mask,
+ * packed into the lower bits of the result in order, with
+ * the upper bits zero (parallel bit extract).
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to extract
+ */
+void extractField(word result, const word op, const word mask) {
+    INSTRUMENT_BEGIN(instExtract);
+#ifdef ALU_REFERENCE
+    extractFieldRef(result, op, mask);
+#else
+    storeWord(result, nativeExtract(loadWord(op), loadWord(mask)));
+#endif
+    INSTRUMENT_END(instExtract);
+}
+
+/**
+ * Deposit the lower bits of word operand, in order, at the
+ * set bits of mask, with the other bits of the result zero
+ * (parallel bit deposit).
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to deposit to
+ */
+void depositField(word result, const word op, const word mask) {
+    INSTRUMENT_BEGIN(instDeposit);
+#ifdef ALU_REFERENCE
+    depositFieldRef(result, op, mask);
+#else
+    storeWord(result, nativeDeposit(loadWord(op), loadWord(mask)));
+#endif
+    INSTRUMENT_END(instDeposit);
 }
@@ -11,6 +11,9 @@
  * @since 2019-01-15
  * @author philip gust
  */
+#ifndef ALU_H_
+#define ALU_H_
+
 #include <stdbool.h>
 #include "word.h"
 
@@ -24,7 +27,7 @@
 bool testLtWord(const word op);
 
 /**
- * Returns true if word is less than zero.
+ * Returns true if word is greater than or equal to zero.
  *
  * Examples (little-endian):
  *   testGeWord(0000 0000 0000 0000) -> true
@@ -37,16 +40,107 @@ bool testGeWord(const word op);
  * Returns true if word is zero.
  *
  * Examples:
- *   testLtWord(0000 0000 0000 0000) -> true
- *   testLtWord(0000 1111 1111 1111) -> false
+ *   testEqWord(0000 0000 0000 0000) -> true
+ *   testEqWord(0000 1111 1111 1111) -> false
  */
 bool testEqWord(const word op);
 
+/**
+ * Signed comparison of two word operands.
+ *
+ * Examples (little-endian):
+ *   cmpWord(1111 1111 1111 1111, 1000 0000 0000 0000) -> -1
+ *   cmpWord(0100 0000 0000 0000, 1000 0000 0000 0000) -> 1
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpWord(const word op1, const word op2);
+
+/**
+ * Unsigned comparison of two word operands.
+ *
+ * Examples (little-endian):
+ *   cmpuWord(1111 1111 1111 1111, 1000 0000 0000 0000) -> 1
+ *   cmpuWord(1000 0000 0000 0000, 1000 0000 0000 0000) -> 0
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpuWord(const word op1, const word op2);
+
+/**
+ * Returns true if op1 is less than op2 as unsigned words.
+ *
+ * Examples:
+ *   cmpLtu(0111 1111 1111 1111, 1000 0000 0000 0000) -> true
+ *   cmpLtu(1111 1111 1111 1111, 0000 0000 0000 0001) -> false
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is less than op2
+ */
+bool cmpLtuWord(const word op1, const word op2);
+
+/**
+ * Returns true if op1 is greater than or equal to op2 as
+ * unsigned words.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is greater than or equal to op2
+ */
+bool cmpGeuWord(const word op1, const word op2);
+
+/**
+ * Signed minimum of two word operands. The result may be
+ * the same word as either operand.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void sminWord(word result, const word op1, const word op2);
+
+/**
+ * Signed maximum of two word operands. The result may be
+ * the same word as either operand.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void smaxWord(word result, const word op1, const word op2);
+
+/**
+ * Unsigned minimum of two word operands. The result may be
+ * the same word as either operand.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void uminWord(word result, const word op1, const word op2);
+
+/**
+ * Unsigned maximum of two word operands. The result may be
+ * the same word as either operand.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void umaxWord(word result, const word op1, const word op2);
+
 /**
  * Arithmetic shift word by count. Same as multiplying or
  * dividing by power of 2.  Shifts bits in word left (+) or
  * right (-) by the specified count. Fills in with 0 from
- * the right, and the sign bit from the left.
+ * the right, and the sign bit from the left. The sign bit
+ * is preserved, so counts beyond wordtopbit leave only the
+ * sign bit (left) or fill the word with it (right).
  *
  * Examples:
  * 	ash(1010 1011 1111 1111, 5)  -> 1111 1111 1110 0000
@@ -61,7 +155,8 @@ void ashWord(word result, const word op, int count);
  * Circular shift word by count. Shifts bits in word
  * left (+) or right (-) by the specified count. Bits
  * shifted off either end of word are rotated in to
- * the other end of word.
+ * the other end of word. The count is taken modulo
+ * wordsize.
  *
  * Examples:
  * 	csh(1010 1011 1111 1111, 4)  -> 1011 1111 1111 1010
@@ -76,6 +171,7 @@ void cshWord(word result, const word op, int count);
  * Logical shift word by count. Shifts bits in word
  * left (+) or right (-) by the specified count. Shifts
  * bits off end and fills in with 0 in either direction.
+ * Counts of wordsize or more shift out every bit.
  *
  * Examples:
  * 	lsh(1111 1111 1111 1111, 5)  -> 1111 1111 1110 0000
@@ -177,6 +273,47 @@ void addWord(word result, const word op1, const word op2);
  */
 void subWord(word result, const word op1, const word op2);
 
+/**
+ * Sum of two word operands also returning the carry out
+ * of the top bit and whether the signed sum overflowed.
+ * Both flags are produced by the same pass as the sum.
+ *
+ * Examples:
+ *   addCarry(1111 1111 1111 1111, 0000 0000 0000 0001)
+ *     -> 0000 0000 0000 0000, carry 1, overflow 0
+ *   addCarry(0111 1111 1111 1111, 0000 0000 0000 0001)
+ *     -> 1000 0000 0000 0000, carry 0, overflow 1
+ *
+ * @param result the result
+ * @param carry the carry out, or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addCarryWord(word result, bit *carry, bit *overflow,
+                  const word op1, const word op2);
+
+/**
+ * Difference of two word operands also returning the carry
+ * out of the top bit and whether the signed difference
+ * overflowed. As with subWord(), the difference is computed
+ * as op1 + ~op2 + 1, so carry is set if no borrow occurred.
+ *
+ * Examples:
+ *   subCarry(0000 0000 0000 0000, 0000 0000 0000 0001)
+ *     -> 1111 1111 1111 1111, carry 0, overflow 0
+ *   subCarry(1000 0000 0000 0000, 0000 0000 0000 0001)
+ *     -> 0111 1111 1111 1111, carry 1, overflow 1
+ *
+ * @param result the result
+ * @param carry the carry out (set if no borrow), or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subCarryWord(word result, bit *carry, bit *overflow,
+                  const word op1, const word op2);
+
 /**
  * Product of two word operands.
  *
@@ -186,6 +323,26 @@ void subWord(word result, const word op1, const word op2);
  */
 void mulWord(word result, const word op1, const word op2);
 
+/**
+ * Full product of two word operands. The signed product of
+ * two words needs two words: hi receives the upper wordsize
+ * bits and lo the lower wordsize bits, which are the same
+ * as the result of mulWord(). hi and lo must be different
+ * words, but either may be the same as an operand.
+ *
+ * Examples:
+ *   mulWide(0100 0000 0000 0000, 0000 0000 0000 0100)
+ *     -> hi 0000 0000 0000 0001, lo 0000 0000 0000 0000
+ *   mulWide(1111 1111 1111 1111, 0000 0000 0000 0010)
+ *     -> hi 1111 1111 1111 1111, lo 1111 1111 1111 1110
+ *
+ * @param hi the upper word of the product
+ * @param lo the lower word of the product
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWideWord(word hi, word lo, const word op1, const word op2);
+
 /**
  * Quotient of two word operands also returning remainder.
  * The sign of the quotient is positive if the signs of
@@ -221,3 +378,138 @@ void divWord(word result, const word op1, const word op2);
  * @param op2 the second operand
  */
 void remainderWord(word result, const word op1, const word op2);
+
+/**
+ * Upper word of the product of two unsigned word operands.
+ *
+ * Examples:
+ *   mulHighu(1111 1111 1111 1111, 0000 0000 0000 0010) -> 0000 0000 0000 0001
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulHighuWord(word result, const word op1, const word op2);
+
+/**
+ * Quotient of two unsigned word operands also returning
+ * remainder. Divide by 0 gives a quotient of all ones, the
+ * largest unsigned number, and a remainder of 0.
+ *
+ * Examples:
+ *   div2u(1111 1111 1111 1111, 0000 0000 0000 0010) -> 0111 1111 1111 1111, 0000 0000 0000 0001
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2uWord(word result, word remainder, const word op1, const word op2);
+
+/**
+ * Quotient of two unsigned word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void divuWord(word result, const word op1, const word op2);
+
+/**
+ * Remainder of two unsigned word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void remainderuWord(word result, const word op1, const word op2);
+
+/**
+ * Number of set bits of word operand.
+ *
+ * Examples:
+ * 	popcount(0000 0000 0001 0110) -> 3
+ * 	popcount(1111 1111 1111 1111) -> 16
+ *
+ * @param op the operand
+ * @return the number of set bits
+ */
+int popcountWord(const word op);
+
+/**
+ * Number of leading zero bits of word operand, above
+ * the top set bit, or wordsize if op is zero.
+ *
+ * Examples:
+ * 	clz(0000 0000 0001 0110) -> 11
+ * 	clz(1000 0000 0000 0000) -> 0
+ *
+ * @param op the operand
+ * @return the number of leading zero bits
+ */
+int clzWord(const word op);
+
+/**
+ * Number of trailing zero bits of word operand, below
+ * the bottom set bit, or wordsize if op is zero.
+ *
+ * Examples:
+ * 	ctz(0000 0000 0001 0110) -> 1
+ * 	ctz(1000 0000 0000 0000) -> 15
+ *
+ * @param op the operand
+ * @return the number of trailing zero bits
+ */
+int ctzWord(const word op);
+
+/**
+ * Bits of word operand in reverse order.
+ *
+ * Examples:
+ * 	bitReverse(0000 0000 0001 0110) -> 0110 1000 0000 0000
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void bitReverseWord(word result, const word op);
+
+/**
+ * Bytes of word operand in reverse order.
+ *
+ * Examples:
+ * 	byteSwap(0000 0000 0001 0110) -> 0001 0110 0000 0000
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void byteSwapWord(word result, const word op);
+
+/**
+ * Extract the bits of word operand at the set bits of mask,
+ * packed into the lower bits of the result in order, with
+ * the upper bits zero (parallel bit extract).
+ *
+ * Examples:
+ * 	extract(1010 1011 1100 1101, 0000 1111 0000 0011) -> 0000 0000 0010 1101
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to extract
+ */
+void extractField(word result, const word op, const word mask);
+
+/**
+ * Deposit the lower bits of word operand, in order, at the
+ * set bits of mask, with the other bits of the result zero
+ * (parallel bit deposit).
+ *
+ * Examples:
+ * 	deposit(0000 0000 0010 1101, 0000 1111 0000 0011) -> 0000 1011 0000 0001
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to deposit to
+ */
+void depositField(word result, const word op, const word mask);
+
+#endif /* ALU_H_ */
@@ -0,0 +1,13 @@
+#
+# aluConfig.cmake
+#
+# Package configuration of the installed alu libraries. Defines the
+# imported targets alu::<flavor> and alu::<flavor>_shared, which
+# carry the compile definitions their libraries were built with.
+#
+# @since 2026-10-14
+#
+include(CMakeFindDependencyMacro)
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_dependency(Threads)
+include(${CMAKE_CURRENT_LIST_DIR}/aluTargets.cmake)
@@ -0,0 +1,480 @@
+/*
+ * alu_async.c
+ *
+ * This file implements the asynchronous job queue. The ring is a
+ * bounded array of slots, each with a sequence number that says
+ * whether the slot is free for the producer of a position or holds
+ * the job of that position for the consumer. A producer reserves a
+ * position by advancing the tail with compare and swap, stores its
+ * job and publishes it through the slot's sequence number, so
+ * producers never wait for each other. One worker at a time holds
+ * the consumer's place: it takes jobs from the head until it has
+ * enough elements for one coalesced batch, gives up the place, and
+ * runs them while another worker takes the next jobs.
+ *
+ * Idle workers sleep on a condition variable. A producer locks and
+ * signals only when a worker sleeps, and a waiting thread is woken
+ * by a completion only when a thread waits.
+ *
+ * @since 2026-10-14
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "alu_async.h"
+#include "alu_wordbuf.h"
+
+/** size of a cache line in bytes */
+#define CACHE_LINE 64
+
+/** maximum number of jobs taken at once */
+#define ASYNC_GATHER 64
+
+/** definition of a slot of the ring */
+typedef struct asyncslot {
+    _Atomic size_t seq;  // position + 1 when it holds a job, position when free
+    asyncjob *job;
+} asyncslot;
+
+/** definition of a worker and its staging buffer */
+typedef struct asyncworker {
+    pthread_t thread;
+    wordarena arena;
+    wordbuf buf;         // ASYNC_COALESCE elements
+} asyncworker;
+
+/** the queue: ring, workers and counters */
+static struct {
+    pthread_mutex_t call;       // serializes starting and stopping
+    pthread_mutex_t take;       // held by the consumer of the ring
+    pthread_mutex_t lock;       // guards sleeping and waiting
+    pthread_cond_t work;        // signals a new job or stop
+    pthread_cond_t finished;    // signals a completed job
+    asyncworker workers[ASYNC_MAX_WORKERS];
+    int nworkers;
+    bool stop;                  // tells the workers to exit when idle
+    _Atomic bool running;       // accepts jobs
+    _Atomic int sleepers;       // workers waiting for jobs
+    _Atomic int waiters;        // threads waiting for completions
+    _Atomic uint64_t jobs;
+    _Atomic uint64_t coalesced;
+    _Atomic uint64_t calls;
+    _Alignas(CACHE_LINE) _Atomic size_t head;  // next position to take
+    _Alignas(CACHE_LINE) _Atomic size_t tail;  // next position to reserve
+    _Alignas(CACHE_LINE) asyncslot ring[ASYNC_RING];
+} queue = {
+    .call = PTHREAD_MUTEX_INITIALIZER,
+    .take = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .finished = PTHREAD_COND_INITIALIZER
+};
+
+_Static_assert((ASYNC_RING & (ASYNC_RING - 1)) == 0, "ASYNC_RING must be a power of 2");
+
+/**
+ * Returns whether the ring has positions reserved by producers
+ * and not yet taken.
+ *
+ * @return true if jobs are pending
+ */
+static bool pending(void) {
+    return atomic_load(&queue.tail) != atomic_load(&queue.head);
+}
+
+/**
+ * Takes the published job at the head of the ring. Only the holder
+ * of the take lock calls this.
+ *
+ * @return the job, or NULL if none is published
+ */
+static asyncjob *takeJob(void) {
+    size_t head = atomic_load_explicit(&queue.head, memory_order_relaxed);
+    asyncslot *slot = &queue.ring[head & (ASYNC_RING - 1)];
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != head + 1) {
+        return NULL;
+    }
+    asyncjob *job = slot->job;
+    atomic_store_explicit(&slot->seq, head + ASYNC_RING, memory_order_release);
+    atomic_store_explicit(&queue.head, head + 1, memory_order_relaxed);
+    return job;
+}
+
+/**
+ * Takes jobs from the ring until they hold enough elements for a
+ * coalesced batch, a job too large to coalesce is taken, or no
+ * published job remains.
+ *
+ * @param taken the jobs taken
+ * @return the number of jobs taken
+ */
+static int takeJobs(asyncjob **taken) {
+    int k = 0;
+    size_t small = 0;
+    pthread_mutex_lock(&queue.take);
+    while (k < ASYNC_GATHER && small < ASYNC_COALESCE) {
+        asyncjob *job = takeJob();
+        if (job == NULL) {
+            break;
+        }
+        taken[k++] = job;
+        if (job->n >= ASYNC_COALESCE) {
+            break;
+        }
+        small += job->n;
+    }
+    pthread_mutex_unlock(&queue.take);
+    return k;
+}
+
+/**
+ * Runs the batch call of a job on arrays.
+ *
+ * @param job the job
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array, used by asyncBinary
+ * @param n the number of elements
+ */
+static void runCall(const asyncjob *job, word *result,
+                    const word *op1, const word *op2, size_t n) {
+    switch (job->kind) {
+    case asyncUnary:
+        job->f.unary(result, op1, n);
+        break;
+    case asyncBinary:
+        job->f.binary(result, op1, op2, n);
+        break;
+    case asyncShift:
+        job->f.shift(result, op1, job->count, n);
+        break;
+    }
+}
+
+/**
+ * Returns whether two jobs make the same batch call apart from
+ * their arrays, so they can share one call.
+ *
+ * @param a a job
+ * @param b another job
+ * @return true if the kind, function and count match
+ */
+static bool sameCall(const asyncjob *a, const asyncjob *b) {
+    if (a->kind != b->kind) {
+        return false;
+    }
+    switch (a->kind) {
+    case asyncUnary:
+        return a->f.unary == b->f.unary;
+    case asyncBinary:
+        return a->f.binary == b->f.binary;
+    case asyncShift:
+        return a->f.shift == b->f.shift && a->count == b->count;
+    }
+    return false;
+}
+
+/**
+ * Completes a job: runs its callback, marks it complete and wakes
+ * the waiting threads. The job is not touched afterwards, since
+ * its owner may reuse it at once.
+ *
+ * @param job the job
+ */
+static void complete(asyncjob *job) {
+    if (job->done != NULL) {
+        job->done(job);
+    }
+    atomic_fetch_add_explicit(&queue.jobs, 1, memory_order_relaxed);
+    atomic_store(&job->complete, true);
+    if (atomic_load(&queue.waiters) > 0) {
+        pthread_mutex_lock(&queue.lock);
+        pthread_cond_broadcast(&queue.finished);
+        pthread_mutex_unlock(&queue.lock);
+    }
+}
+
+/**
+ * Runs a group of jobs of the same call as one batch call on a
+ * staging buffer: the operands of each are gathered into the
+ * buffer's columns, and the results scattered back.
+ *
+ * @param buf the staging buffer
+ * @param group the jobs, holding at most ASYNC_COALESCE elements
+ * @param m the number of jobs
+ */
+static void runGroup(wordbuf *buf, asyncjob **group, int m) {
+    size_t n = 0;
+    for (int i = 0; i < m; i++) {
+        const asyncjob *job = group[i];
+        memcpy(buf->op1 + n, job->op1, job->n * sizeof(word));
+        if (job->kind == asyncBinary) {
+            memcpy(buf->op2 + n, job->op2, job->n * sizeof(word));
+        }
+        n += job->n;
+    }
+    buf->n = n;
+
+    runCall(group[0], buf->result, (const word *)buf->op1, (const word *)buf->op2, n);
+
+    n = 0;
+    for (int i = 0; i < m; i++) {
+        memcpy(group[i]->result, buf->result + n, group[i]->n * sizeof(word));
+        n += group[i]->n;
+    }
+    atomic_fetch_add_explicit(&queue.calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&queue.coalesced, (uint64_t)m, memory_order_relaxed);
+    for (int i = 0; i < m; i++) {
+        complete(group[i]);
+    }
+}
+
+/**
+ * Runs the jobs taken by a worker. Jobs of the same call whose
+ * elements fit the staging buffer together share a batch call, and
+ * the others run on their own arrays.
+ *
+ * @param w the worker
+ * @param taken the jobs
+ * @param k the number of jobs
+ */
+static void runTaken(asyncworker *w, asyncjob **taken, int k) {
+    bool used[ASYNC_GATHER] = { false };
+    asyncjob *group[ASYNC_GATHER];
+
+    for (int i = 0; i < k; i++) {
+        if (used[i]) {
+            continue;
+        }
+        int m = 0;
+        size_t n = taken[i]->n;
+        group[m++] = taken[i];
+        if (n < ASYNC_COALESCE) {
+            for (int j = i + 1; j < k; j++) {
+                if (!used[j] && sameCall(taken[i], taken[j])
+                        && n + taken[j]->n <= ASYNC_COALESCE) {
+                    used[j] = true;
+                    n += taken[j]->n;
+                    group[m++] = taken[j];
+                }
+            }
+        }
+        if (m > 1) {
+            runGroup(&w->buf, group, m);
+        } else {
+            runCall(taken[i], taken[i]->result, taken[i]->op1, taken[i]->op2, taken[i]->n);
+            atomic_fetch_add_explicit(&queue.calls, 1, memory_order_relaxed);
+            complete(taken[i]);
+        }
+    }
+}
+
+/**
+ * Body of a worker: runs jobs until stopped and the ring is empty.
+ *
+ * @param arg the worker
+ * @return NULL
+ */
+static void *workerThread(void *arg) {
+    asyncworker *w = arg;
+    asyncjob *taken[ASYNC_GATHER];
+
+    for (;;) {
+        int k = takeJobs(taken);
+        if (k > 0) {
+            runTaken(w, taken, k);
+            continue;
+        }
+        if (pending()) {
+            // a producer has reserved a position but not yet published it
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&queue.lock);
+        atomic_fetch_add(&queue.sleepers, 1);
+        while (!pending() && !queue.stop) {
+            pthread_cond_wait(&queue.work, &queue.lock);
+        }
+        atomic_fetch_sub(&queue.sleepers, 1);
+        bool stop = queue.stop && !pending();
+        pthread_mutex_unlock(&queue.lock);
+        if (stop) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Stops the workers and frees their staging buffers.
+ */
+static void stopWorkers(void) {
+    pthread_mutex_lock(&queue.lock);
+    queue.stop = true;
+    pthread_cond_broadcast(&queue.work);
+    pthread_mutex_unlock(&queue.lock);
+    for (int i = 0; i < queue.nworkers; i++) {
+        pthread_join(queue.workers[i].thread, NULL);
+    }
+    for (int i = 0; i < ASYNC_MAX_WORKERS; i++) {
+        wordArenaFree(&queue.workers[i].arena);
+    }
+    queue.nworkers = 0;
+}
+
+/**
+ * Starts the worker threads of the queue. A count of 0 or less
+ * uses one thread for each online processor, and counts beyond
+ * ASYNC_MAX_WORKERS are clamped.
+ *
+ * @param nworkers the number of worker threads
+ * @return true if the queue was stopped and all workers started
+ */
+bool asyncStart(int nworkers) {
+    if (nworkers <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nworkers = online > 0 ? (int)(online < ASYNC_MAX_WORKERS
+                                      ? online : ASYNC_MAX_WORKERS) : 1;
+    }
+    if (nworkers > ASYNC_MAX_WORKERS) {
+        nworkers = ASYNC_MAX_WORKERS;
+    }
+
+    pthread_mutex_lock(&queue.call);
+    if (atomic_load(&queue.running)) {
+        pthread_mutex_unlock(&queue.call);
+        return false;
+    }
+
+    for (size_t i = 0; i < ASYNC_RING; i++) {
+        atomic_store_explicit(&queue.ring[i].seq, i, memory_order_relaxed);
+    }
+    atomic_store(&queue.head, 0);
+    atomic_store(&queue.tail, 0);
+    atomic_store(&queue.jobs, 0);
+    atomic_store(&queue.coalesced, 0);
+    atomic_store(&queue.calls, 0);
+    queue.stop = false;
+
+    bool ok = true;
+    for (int i = 0; i < nworkers; i++) {
+        asyncworker *w = &queue.workers[i];
+        if (!wordArenaInit(&w->arena, wordbufBytes(ASYNC_COALESCE))
+                || !wordbufInit(&w->buf, &w->arena, ASYNC_COALESCE)
+                || pthread_create(&w->thread, NULL, workerThread, w) != 0) {
+            ok = false;
+            break;
+        }
+        queue.nworkers++;
+    }
+    if (ok) {
+        atomic_store(&queue.running, true);
+    } else {
+        stopWorkers();
+    }
+
+    pthread_mutex_unlock(&queue.call);
+    return ok;
+}
+
+/**
+ * Completes the jobs already submitted, then stops the worker
+ * threads. No job may be submitted while the queue stops.
+ */
+void asyncStop(void) {
+    pthread_mutex_lock(&queue.call);
+    if (atomic_load(&queue.running)) {
+        atomic_store(&queue.running, false);
+        stopWorkers();
+    }
+    pthread_mutex_unlock(&queue.call);
+}
+
+/**
+ * Submits a job to run on the workers.
+ *
+ * @param job the job
+ * @return true if submitted, or false if the ring is full or the
+ *   queue is not started
+ */
+bool asyncSubmit(asyncjob *job) {
+    if (!atomic_load_explicit(&queue.running, memory_order_acquire)) {
+        return false;
+    }
+    atomic_store_explicit(&job->complete, false, memory_order_relaxed);
+
+    size_t tail = atomic_load_explicit(&queue.tail, memory_order_relaxed);
+    asyncslot *slot;
+    for (;;) {
+        slot = &queue.ring[tail & (ASYNC_RING - 1)];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq == tail) {
+            if (atomic_compare_exchange_weak(&queue.tail, &tail, tail + 1)) {
+                break;
+            }
+        } else if ((ptrdiff_t)(seq - tail) < 0) {
+            return false;  // the slot still holds the job of the previous lap
+        } else {
+            tail = atomic_load_explicit(&queue.tail, memory_order_relaxed);
+        }
+    }
+    slot->job = job;
+    atomic_store_explicit(&slot->seq, tail + 1, memory_order_release);
+
+    // pairs with the increment of sleepers before a worker checks pending()
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&queue.sleepers, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&queue.lock);
+        pthread_cond_signal(&queue.work);
+        pthread_mutex_unlock(&queue.lock);
+    }
+    return true;
+}
+
+/**
+ * Returns whether a submitted job has completed, after which its
+ * results may be read and the job reused.
+ *
+ * @param job the job
+ * @return true when the job has completed
+ */
+bool asyncDone(asyncjob *job) {
+    return atomic_load_explicit(&job->complete, memory_order_acquire);
+}
+
+/**
+ * Waits until a submitted job has completed.
+ *
+ * @param job the job
+ */
+void asyncWait(asyncjob *job) {
+    if (asyncDone(job)) {
+        return;
+    }
+    pthread_mutex_lock(&queue.lock);
+    atomic_fetch_add(&queue.waiters, 1);
+    while (!atomic_load(&job->complete)) {
+        pthread_cond_wait(&queue.finished, &queue.lock);
+    }
+    atomic_fetch_sub(&queue.waiters, 1);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+/**
+ * Returns the counters of the queue since it was started.
+ *
+ * @param stats the counters
+ */
+void asyncStats(asyncstats *stats) {
+    stats->jobs = atomic_load_explicit(&queue.jobs, memory_order_relaxed);
+    stats->coalesced = atomic_load_explicit(&queue.coalesced, memory_order_relaxed);
+    stats->calls = atomic_load_explicit(&queue.calls, memory_order_relaxed);
+}
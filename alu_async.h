@@ -0,0 +1,138 @@
+/*
+ * alu_async.h
+ *
+ * This file declares asynchronous execution of the batch functions
+ * of alu_batch.h. A thread submits a job, a batch call described
+ * by its function and arrays, and goes on with other work while a
+ * pool of worker threads runs it. The job serves as its own
+ * future: asyncDone() polls it and asyncWait() blocks until it
+ * completes, and an optional callback runs on the worker thread
+ * when it completes.
+ *
+ * Submission pushes the job onto a bounded ring without locks, so
+ * many threads can submit at once without blocking each other.
+ * The workers take turns as the single consumer of the ring. Small
+ * jobs of the same function taken together are coalesced: their
+ * operands are gathered into the columns of one wordbuf (see
+ * alu_wordbuf.h), the batch function runs once over all of them,
+ * and the results are scattered back, so the SIMD kernels see long
+ * arrays even when every job is short.
+ *
+ * Jobs are owned by the caller and are not copied: a job and its
+ * arrays must stay valid and unchanged until it completes. The
+ * aliasing rules of alu_batch.h apply within each job.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_ASYNC_H_
+#define ALU_ASYNC_H_
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "alu_parallel.h"
+#include "word.h"
+
+/** maximum number of worker threads */
+#define ASYNC_MAX_WORKERS 64
+
+/** number of jobs the ring holds, a power of 2 */
+#ifndef ASYNC_RING
+#define ASYNC_RING 1024
+#endif
+
+/** jobs of fewer elements are coalesced, into batches of up to this many */
+#ifndef ASYNC_COALESCE
+#define ASYNC_COALESCE 4096
+#endif
+
+/** kinds of batch functions of a job */
+typedef enum asynckind {
+    asyncUnary,   // f.unary(result, op1, n)
+    asyncBinary,  // f.binary(result, op1, op2, n)
+    asyncShift    // f.shift(result, op1, count, n)
+} asynckind;
+
+typedef struct asyncjob asyncjob;
+
+/**
+ * callback run on a worker thread when a job completes, before the
+ * job is marked complete, so it must not submit the job again
+ */
+typedef void (*asynccallback)(asyncjob *job);
+
+/** definition of a job, set by the caller before it is submitted */
+struct asyncjob {
+    asynckind kind;
+    union {
+        batchunary unary;
+        batchbinary binary;
+        batchshift shift;
+    } f;                  // batch function of the kind
+    word *result;         // result array
+    const word *op1;      // first operand array
+    const word *op2;      // second operand array of asyncBinary
+    int count;            // count of asyncShift
+    size_t n;             // number of elements
+    asynccallback done;   // callback, or NULL
+    void *arg;            // for the caller and its callback
+    _Atomic bool complete;  // set by the queue
+};
+
+/** definition of the counters of the queue */
+typedef struct asyncstats {
+    uint64_t jobs;        // jobs completed
+    uint64_t coalesced;   // jobs that shared a batch call with others
+    uint64_t calls;       // batch function calls
+} asyncstats;
+
+/**
+ * Starts the worker threads of the queue. A count of 0 or less
+ * uses one thread for each online processor, and counts beyond
+ * ASYNC_MAX_WORKERS are clamped.
+ *
+ * @param nworkers the number of worker threads
+ * @return true if the queue was stopped and all workers started
+ */
+bool asyncStart(int nworkers);
+
+/**
+ * Completes the jobs already submitted, then stops the worker
+ * threads. No job may be submitted while the queue stops.
+ */
+void asyncStop(void);
+
+/**
+ * Submits a job to run on the workers.
+ *
+ * @param job the job
+ * @return true if submitted, or false if the ring is full or the
+ *   queue is not started
+ */
+bool asyncSubmit(asyncjob *job);
+
+/**
+ * Returns whether a submitted job has completed, after which its
+ * results may be read and the job reused.
+ *
+ * @param job the job
+ * @return true when the job has completed
+ */
+bool asyncDone(asyncjob *job);
+
+/**
+ * Waits until a submitted job has completed.
+ *
+ * @param job the job
+ */
+void asyncWait(asyncjob *job);
+
+/**
+ * Returns the counters of the queue since it was started.
+ *
+ * @param stats the counters
+ */
+void asyncStats(asyncstats *stats);
+
+#endif /* ALU_ASYNC_H_ */
@@ -0,0 +1,1098 @@
+/*
+ * alu_batch.c
+ *
+ * This file implements batch versions of the arithmetic logic
+ * unit functions. The loops use the inline native engines from
+ * alu_native.h, or the alu.h functions in ALU_REFERENCE builds.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_batch.h"
+#include "alu_native.h"
+#include "alu_simd.h"
+
+/**
+ * Returns for each element whether the word is less than zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testLtWordN(bool *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = testLtWord(op[i]);
+#else
+        result[i] = (loadWord(op[i]) & topBit) != 0;
+#endif
+    }
+}
+
+/**
+ * Returns for each element whether the word is greater than
+ * or equal to zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testGeWordN(bool *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = testGeWord(op[i]);
+#else
+        result[i] = (loadWord(op[i]) & topBit) == 0;
+#endif
+    }
+}
+
+/**
+ * Returns for each element whether the word is zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testEqWordN(bool *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = testEqWord(op[i]);
+#else
+        result[i] = loadWord(op[i]) == 0;
+#endif
+    }
+}
+
+/**
+ * Returns for each element whether op1 is less than op2 as
+ * unsigned words.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtuWordN(bool *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = cmpLtuWord(op1[i], op2[i]);
+#else
+        result[i] = loadWord(op1[i]) < loadWord(op2[i]);
+#endif
+    }
+}
+
+/**
+ * Returns for each element whether op1 is greater than or equal
+ * to op2 as unsigned words.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpGeuWordN(bool *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = cmpGeuWord(op1[i], op2[i]);
+#else
+        result[i] = loadWord(op1[i]) >= loadWord(op2[i]);
+#endif
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * less than zero.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testLtWordMask(uint64_t *mask, const word *op, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->testLtWords != NULL) {
+        i = simd->testLtWords(mask, op, n);
+    }
+#endif
+    for (; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = testLtWord(op[i]);
+#else
+        bool t = (loadWord(op[i]) & topBit) != 0;
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * greater than or equal to zero.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testGeWordMask(uint64_t *mask, const word *op, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->testGeWords != NULL) {
+        i = simd->testGeWords(mask, op, n);
+    }
+#endif
+    for (; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = testGeWord(op[i]);
+#else
+        bool t = (loadWord(op[i]) & topBit) == 0;
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * zero.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testEqWordMask(uint64_t *mask, const word *op, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->testEqWords != NULL) {
+        i = simd->testEqWords(mask, op, n);
+    }
+#endif
+    for (; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = testEqWord(op[i]);
+#else
+        bool t = loadWord(op[i]) == 0;
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is less than op2 as signed words.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = cmpWord(op1[i], op2[i]) < 0;
+#else
+        bool t = nativeCmp(loadWord(op1[i]), loadWord(op2[i])) < 0;
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is less than op2 as unsigned words.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtuWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = cmpuWord(op1[i], op2[i]) < 0;
+#else
+        bool t = loadWord(op1[i]) < loadWord(op2[i]);
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is greater than or equal to op2 as unsigned words.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpGeuWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = cmpGeuWord(op1[i], op2[i]);
+#else
+        bool t = loadWord(op1[i]) >= loadWord(op2[i]);
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is equal to op2.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpEqWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (i % 64 == 0) {
+            mask[i / 64] = 0;
+        }
+#ifdef ALU_REFERENCE
+        bool t = cmpuWord(op1[i], op2[i]) == 0;
+#else
+        bool t = loadWord(op1[i]) == loadWord(op2[i]);
+#endif
+        mask[i / 64] |= (uint64_t)t << (i % 64);
+    }
+}
+
+/**
+ * Signed minimum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void sminWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        sminWord(result[i], op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]), b = loadWord(op2[i]);
+        storeWord(result[i], nativeSmin(a, b));
+#endif
+    }
+}
+
+/**
+ * Signed maximum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void smaxWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        smaxWord(result[i], op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]), b = loadWord(op2[i]);
+        storeWord(result[i], nativeSmax(a, b));
+#endif
+    }
+}
+
+/**
+ * Unsigned minimum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void uminWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        uminWord(result[i], op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]), b = loadWord(op2[i]);
+        storeWord(result[i], nativeUmin(a, b));
+#endif
+    }
+}
+
+/**
+ * Unsigned maximum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void umaxWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        umaxWord(result[i], op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]), b = loadWord(op2[i]);
+        storeWord(result[i], nativeUmax(a, b));
+#endif
+    }
+}
+
+/**
+ * Arithmetic shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void ashWordN(word *result, const word *op, int count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->ashWords != NULL) {
+        i = simd->ashWords(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        ashWord(result[i], op[i], count);
+#else
+        storeWord(result[i], nativeAsh(loadWord(op[i]), count));
+#endif
+    }
+}
+
+/**
+ * Circular shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void cshWordN(word *result, const word *op, int count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->cshWords != NULL) {
+        i = simd->cshWords(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        cshWord(result[i], op[i], count);
+#else
+        storeWord(result[i], nativeCsh(loadWord(op[i]), count));
+#endif
+    }
+}
+
+/**
+ * Logical shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void lshWordN(word *result, const word *op, int count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->lshWords != NULL) {
+        i = simd->lshWords(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        lshWord(result[i], op[i], count);
+#else
+        storeWord(result[i], nativeLsh(loadWord(op[i]), count));
+#endif
+    }
+}
+
+/**
+ * Arithmetic shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void ashWordNv(word *result, const word *op, const int *count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->ashWordsv != NULL) {
+        i = simd->ashWordsv(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        ashWord(result[i], op[i], count[i]);
+#else
+        storeWord(result[i], nativeAsh(loadWord(op[i]), count[i]));
+#endif
+    }
+}
+
+/**
+ * Circular shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void cshWordNv(word *result, const word *op, const int *count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->cshWordsv != NULL) {
+        i = simd->cshWordsv(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        cshWord(result[i], op[i], count[i]);
+#else
+        storeWord(result[i], nativeCsh(loadWord(op[i]), count[i]));
+#endif
+    }
+}
+
+/**
+ * Logical shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void lshWordNv(word *result, const word *op, const int *count, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->lshWordsv != NULL) {
+        i = simd->lshWordsv(result, op, count, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        lshWord(result[i], op[i], count[i]);
+#else
+        storeWord(result[i], nativeLsh(loadWord(op[i]), count[i]));
+#endif
+    }
+}
+
+/**
+ * Mask of all but the lower (+) or upper (-) count bits
+ * of each word.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the mask count
+ * @param n the number of elements
+ */
+void maskWordN(word *result, const word *op, int count, size_t n) {
+#ifdef ALU_REFERENCE
+    for (size_t i = 0; i < n; i++) {
+        maskWord(result[i], op[i], count);
+    }
+#else
+    // the mask is the same for every element
+    uword mask = nativeMask((uword)~(uword)0, count);
+    for (size_t i = 0; i < n; i++) {
+        storeWord(result[i], loadWord(op[i]) & mask);
+    }
+#endif
+}
+
+/**
+ * Logical AND of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void andWordN(word *result, const word *op1, const word *op2, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->andWords != NULL) {
+        i = simd->andWords(result, op1, op2, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        andWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], loadWord(op1[i]) & loadWord(op2[i]));
+#endif
+    }
+}
+
+/**
+ * Logical OR of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void orWordN(word *result, const word *op1, const word *op2, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->orWords != NULL) {
+        i = simd->orWords(result, op1, op2, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        orWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], loadWord(op1[i]) | loadWord(op2[i]));
+#endif
+    }
+}
+
+/**
+ * Logical XOR of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void xorWordN(word *result, const word *op1, const word *op2, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->xorWords != NULL) {
+        i = simd->xorWords(result, op1, op2, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        xorWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], loadWord(op1[i]) ^ loadWord(op2[i]));
+#endif
+    }
+}
+
+/**
+ * Logical NOT of each word operand.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void notWordN(word *result, const word *op, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->notWords != NULL) {
+        i = simd->notWords(result, op, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        notWord(result[i], op[i]);
+#else
+        storeWord(result[i], ~loadWord(op[i]));
+#endif
+    }
+}
+
+/**
+ * Negative of each word operand.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void negativeWordN(word *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        negativeWord(result[i], op[i]);
+#else
+        storeWord(result[i], 0u - loadWord(op[i]));
+#endif
+    }
+}
+
+/**
+ * Sum of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addWordN(word *result, const word *op1, const word *op2, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->addWords != NULL) {
+        i = simd->addWords(result, op1, op2, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        addWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], loadWord(op1[i]) + loadWord(op2[i]));
+#endif
+    }
+}
+
+/**
+ * Difference of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subWordN(word *result, const word *op1, const word *op2, size_t n) {
+    size_t i = 0;
+#ifndef ALU_REFERENCE
+    const simdkernels *simd = simdKernels();
+    if (simd->subWords != NULL) {
+        i = simd->subWords(result, op1, op2, n);
+    }
+#endif
+    for (; i < n; i++) {
+#ifdef ALU_REFERENCE
+        subWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], loadWord(op1[i]) - loadWord(op2[i]));
+#endif
+    }
+}
+
+/**
+ * Sum of word operands element by element also returning
+ * carry and overflow for each element.
+ *
+ * @param result the result array
+ * @param carry the carry out array, or NULL
+ * @param overflow the signed overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addCarryWordN(word *result, bit *carry, bit *overflow,
+                   const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        addCarryWord(result[i], (carry != NULL) ? &carry[i] : NULL,
+                     (overflow != NULL) ? &overflow[i] : NULL, op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]);
+        uword b = loadWord(op2[i]);
+        uword r = a + b;
+        if (carry != NULL) {
+            carry[i] = r < a;
+        }
+        if (overflow != NULL) {
+            overflow[i] = toBit(((a ^ r) & (b ^ r)) >> wordtopbit);
+        }
+        storeWord(result[i], r);
+#endif
+    }
+}
+
+/**
+ * Difference of word operands element by element also
+ * returning carry (set if no borrow) and overflow for each
+ * element.
+ *
+ * @param result the result array
+ * @param carry the carry out array, or NULL
+ * @param overflow the signed overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subCarryWordN(word *result, bit *carry, bit *overflow,
+                   const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        subCarryWord(result[i], (carry != NULL) ? &carry[i] : NULL,
+                     (overflow != NULL) ? &overflow[i] : NULL, op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]);
+        uword b = loadWord(op2[i]);
+        uword r = a - b;
+        if (carry != NULL) {
+            carry[i] = a >= b;
+        }
+        if (overflow != NULL) {
+            overflow[i] = toBit(((a ^ b) & (a ^ r)) >> wordtopbit);
+        }
+        storeWord(result[i], r);
+#endif
+    }
+}
+
+/**
+ * Product of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        mulWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], nativeMul(loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Full product of word operands element by element.
+ *
+ * @param hi the upper word array of the products
+ * @param lo the lower word array of the products
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulWideWordN(word *hi, word *lo, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        mulWideWord(hi[i], lo[i], op1[i], op2[i]);
+#else
+        uword a = loadWord(op1[i]);
+        uword b = loadWord(op2[i]);
+        storeWord(lo[i], nativeMul(a, b));
+        storeWord(hi[i], nativeMulHigh(a, b));
+#endif
+    }
+}
+
+/**
+ * Quotient of word operands element by element also
+ * returning remainders, with the sign conventions of div2Word().
+ *
+ * @param result the quotient array
+ * @param remainder the remainder array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void div2WordN(word *result, word *remainder,
+                const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        div2Word(result[i], remainder[i], op1[i], op2[i]);
+#else
+        uword r;
+        uword q = nativeDiv2(&r, loadWord(op1[i]), loadWord(op2[i]));
+        storeWord(result[i], q);
+        storeWord(remainder[i], r);
+#endif
+    }
+}
+
+/**
+ * Quotient of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void divWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        divWord(result[i], op1[i], op2[i]);
+#else
+        uword r;
+        storeWord(result[i], nativeDiv2(&r, loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Remainder of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void remainderWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        remainderWord(result[i], op1[i], op2[i]);
+#else
+        uword r;
+        nativeDiv2(&r, loadWord(op1[i]), loadWord(op2[i]));
+        storeWord(result[i], r);
+#endif
+    }
+}
+
+/**
+ * Upper word of the unsigned product of word operands element
+ * by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulHighuWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        mulHighuWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], nativeMulHighu(loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Unsigned quotient of word operands element by element also
+ * returning remainders, with the conventions of div2uWord().
+ *
+ * @param result the quotient array
+ * @param remainder the remainder array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void div2uWordN(word *result, word *remainder,
+                const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        div2uWord(result[i], remainder[i], op1[i], op2[i]);
+#else
+        uword r;
+        uword q = nativeDiv2u(&r, loadWord(op1[i]), loadWord(op2[i]));
+        storeWord(result[i], q);
+        storeWord(remainder[i], r);
+#endif
+    }
+}
+
+/**
+ * Unsigned quotient of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void divuWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        divuWord(result[i], op1[i], op2[i]);
+#else
+        uword r;
+        storeWord(result[i], nativeDiv2u(&r, loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Unsigned remainder of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void remainderuWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        remainderuWord(result[i], op1[i], op2[i]);
+#else
+        uword r;
+        nativeDiv2u(&r, loadWord(op1[i]), loadWord(op2[i]));
+        storeWord(result[i], r);
+#endif
+    }
+}
+
+/**
+ * Number of set bits of each word operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void popcountWordN(int *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = popcountWord(op[i]);
+#else
+        result[i] = (int)populationCount(loadWord(op[i]));
+#endif
+    }
+}
+
+/**
+ * Number of leading zero bits of each word operand, or
+ * wordsize for a zero operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void clzWordN(int *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = clzWord(op[i]);
+#else
+        result[i] = (int)leadingZeros(loadWord(op[i]));
+#endif
+    }
+}
+
+/**
+ * Number of trailing zero bits of each word operand, or
+ * wordsize for a zero operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void ctzWordN(int *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        result[i] = ctzWord(op[i]);
+#else
+        result[i] = (int)trailingZeros(loadWord(op[i]));
+#endif
+    }
+}
+
+/**
+ * Bits of each word operand in reverse order.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void bitReverseWordN(word *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        bitReverseWord(result[i], op[i]);
+#else
+        storeWord(result[i], nativeBitReverse(loadWord(op[i])));
+#endif
+    }
+}
+
+/**
+ * Bytes of each word operand in reverse order.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void byteSwapWordN(word *result, const word *op, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        byteSwapWord(result[i], op[i]);
+#else
+        storeWord(result[i], nativeByteSwap(loadWord(op[i])));
+#endif
+    }
+}
+
+/**
+ * Extract the bits of each word operand at the set bits of
+ * its mask, as extractField().
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param mask the mask array
+ * @param n the number of elements
+ */
+void extractFieldN(word *result, const word *op, const word *mask, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        extractField(result[i], op[i], mask[i]);
+#else
+        storeWord(result[i], nativeExtract(loadWord(op[i]), loadWord(mask[i])));
+#endif
+    }
+}
+
+/**
+ * Deposit the lower bits of each word operand at the set bits
+ * of its mask, as depositField().
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param mask the mask array
+ * @param n the number of elements
+ */
+void depositFieldN(word *result, const word *op, const word *mask, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        depositField(result[i], op[i], mask[i]);
+#else
+        storeWord(result[i], nativeDeposit(loadWord(op[i]), loadWord(mask[i])));
+#endif
+    }
+}
+
+/**
+ * Returns the name of the SIMD kernel set used by the batch
+ * functions.
+ *
+ * @return the name of the kernel set
+ */
+const char *batchKernels(void) {
+#ifdef ALU_REFERENCE
+    return "reference";
+#else
+    return simdKernels()->name;
+#endif
+}
+
+/**
+ * Selects the SIMD kernel set used by the batch functions.
+ *
+ * @param name the name of the kernel set, or NULL
+ * @return true if the kernel set was selected
+ */
+bool selectBatchKernels(const char *name) {
+    return simdSelectKernels(name);
+}
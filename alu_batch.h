@@ -0,0 +1,556 @@
+/*
+ * alu_batch.h
+ *
+ * This file declares batch versions of the arithmetic logic
+ * unit functions in alu.h. Each function named xxxWordN applies
+ * xxxWord to n elements of its operand arrays, so a buffer is
+ * processed with a single call that the compiler can unroll and
+ * vectorize.
+ *
+ * Aliasing: element i of a result depends only on element i of
+ * the operands. A result array may therefore be the same array
+ * as any operand array, so operations can be done in place, but
+ * arrays must not otherwise partially overlap. Functions with
+ * two result arrays (div2WordN, div2uWordN, mulWideWordN) require
+ * the two result arrays to be distinct.
+ *
+ * Logical, add, subtract, shift and test functions run on SIMD
+ * kernels chosen at run time for the CPU (see alu_simd.h), with
+ * the scalar engine finishing whatever the kernels leave.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_BATCH_H_
+#define ALU_BATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "word.h"
+
+/**
+ * Returns for each element whether the word is less than zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testLtWordN(bool *result, const word *op, size_t n);
+
+/**
+ * Returns for each element whether the word is greater than
+ * or equal to zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testGeWordN(bool *result, const word *op, size_t n);
+
+/**
+ * Returns for each element whether the word is zero.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testEqWordN(bool *result, const word *op, size_t n);
+
+/**
+ * Returns for each element whether op1 is less than op2 as
+ * unsigned words.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtuWordN(bool *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Returns for each element whether op1 is greater than or equal
+ * to op2 as unsigned words.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpGeuWordN(bool *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * less than zero. Bit i is bit (i % 64) of mask[i / 64], and
+ * bits of the last mask element beyond n are cleared.
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testLtWordMask(uint64_t *mask, const word *op, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * greater than or equal to zero. The mask layout is the same
+ * as for testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testGeWordMask(uint64_t *mask, const word *op, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i whose word is
+ * zero. The mask layout is the same as for testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void testEqWordMask(uint64_t *mask, const word *op, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is less than op2 as signed words. The mask layout is the same as for
+ * testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is less than op2 as unsigned words. The mask layout is the same as for
+ * testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpLtuWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is greater than or equal to op2 as unsigned words. The mask
+ * layout is the same as for testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpGeuWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sets bit i of the mask for each element i at which
+ * op1 is equal to op2. The mask layout is the same as for
+ * testLtWordMask().
+ *
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void cmpEqWordMask(uint64_t *mask, const word *op1, const word *op2, size_t n);
+
+/**
+ * Signed minimum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void sminWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Signed maximum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void smaxWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Unsigned minimum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void uminWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Unsigned maximum of each pair of word operands.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void umaxWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Arithmetic shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void ashWordN(word *result, const word *op, int count, size_t n);
+
+/**
+ * Circular shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void cshWordN(word *result, const word *op, int count, size_t n);
+
+/**
+ * Logical shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void lshWordN(word *result, const word *op, int count, size_t n);
+
+/**
+ * Arithmetic shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void ashWordNv(word *result, const word *op, const int *count, size_t n);
+
+/**
+ * Circular shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void cshWordNv(word *result, const word *op, const int *count, size_t n);
+
+/**
+ * Logical shift of each word by its own count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count array
+ * @param n the number of elements
+ */
+void lshWordNv(word *result, const word *op, const int *count, size_t n);
+
+/**
+ * Mask of all but the lower (+) or upper (-) count bits
+ * of each word.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the mask count
+ * @param n the number of elements
+ */
+void maskWordN(word *result, const word *op, int count, size_t n);
+
+/**
+ * Logical AND of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void andWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Logical OR of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void orWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Logical XOR of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void xorWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Logical NOT of each word operand.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void notWordN(word *result, const word *op, size_t n);
+
+/**
+ * Negative of each word operand.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void negativeWordN(word *result, const word *op, size_t n);
+
+/**
+ * Sum of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Difference of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sum of word operands element by element also returning
+ * carry and overflow for each element.
+ *
+ * @param result the result array
+ * @param carry the carry out array, or NULL
+ * @param overflow the signed overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addCarryWordN(word *result, bit *carry, bit *overflow,
+                   const word *op1, const word *op2, size_t n);
+
+/**
+ * Difference of word operands element by element also
+ * returning carry (set if no borrow) and overflow for each
+ * element.
+ *
+ * @param result the result array
+ * @param carry the carry out array, or NULL
+ * @param overflow the signed overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subCarryWordN(word *result, bit *carry, bit *overflow,
+                   const word *op1, const word *op2, size_t n);
+
+/**
+ * Product of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Full product of word operands element by element.
+ *
+ * @param hi the upper word array of the products
+ * @param lo the lower word array of the products
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulWideWordN(word *hi, word *lo, const word *op1, const word *op2, size_t n);
+
+/**
+ * Quotient of word operands element by element also
+ * returning remainders, with the sign conventions of div2Word().
+ *
+ * @param result the quotient array
+ * @param remainder the remainder array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void div2WordN(word *result, word *remainder,
+                const word *op1, const word *op2, size_t n);
+
+/**
+ * Quotient of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void divWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Remainder of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void remainderWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Upper word of the unsigned product of word operands element
+ * by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulHighuWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Unsigned quotient of word operands element by element also
+ * returning remainders, with the conventions of div2uWord().
+ *
+ * @param result the quotient array
+ * @param remainder the remainder array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void div2uWordN(word *result, word *remainder,
+                const word *op1, const word *op2, size_t n);
+
+/**
+ * Unsigned quotient of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void divuWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Unsigned remainder of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the dividend array
+ * @param op2 the divisor array
+ * @param n the number of elements
+ */
+void remainderuWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Number of set bits of each word operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void popcountWordN(int *result, const word *op, size_t n);
+
+/**
+ * Number of leading zero bits of each word operand, or
+ * wordsize for a zero operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void clzWordN(int *result, const word *op, size_t n);
+
+/**
+ * Number of trailing zero bits of each word operand, or
+ * wordsize for a zero operand.
+ *
+ * @param result the count array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void ctzWordN(int *result, const word *op, size_t n);
+
+/**
+ * Bits of each word operand in reverse order.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void bitReverseWordN(word *result, const word *op, size_t n);
+
+/**
+ * Bytes of each word operand in reverse order.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void byteSwapWordN(word *result, const word *op, size_t n);
+
+/**
+ * Extract the bits of each word operand at the set bits of
+ * its mask, as extractField().
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param mask the mask array
+ * @param n the number of elements
+ */
+void extractFieldN(word *result, const word *op, const word *mask, size_t n);
+
+/**
+ * Deposit the lower bits of each word operand at the set bits
+ * of its mask, as depositField().
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param mask the mask array
+ * @param n the number of elements
+ */
+void depositFieldN(word *result, const word *op, const word *mask, size_t n);
+
+/**
+ * Returns the name of the SIMD kernel set used by the batch
+ * functions: "avx2", "sse2", "neon" or "scalar", or "reference"
+ * in ALU_REFERENCE builds.
+ *
+ * @return the name of the kernel set
+ */
+const char *batchKernels(void);
+
+/**
+ * Selects the SIMD kernel set used by the batch functions, for
+ * example to compare kernel sets. The set must be built in and
+ * supported by the CPU; "scalar" always is, and NULL restores
+ * the set detected for the CPU.
+ *
+ * @param name the name of the kernel set, or NULL
+ * @return true if the kernel set was selected
+ */
+bool selectBatchKernels(const char *name);
+
+#endif /* ALU_BATCH_H_ */
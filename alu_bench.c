@@ -0,0 +1,1099 @@
+/*
+ * alu_bench.c
+ *
+ * This file contains a benchmark of the word and arithmetic logic
+ * unit functions. Each function in word.h and alu.h is timed for
+ * the native engine and, where one exists, the reference bit-serial
+ * engine from alu_ref.h, over operand distributions that affect the
+ * cost of the reference engines: small and large magnitudes for
+ * multiply, shift counts 0..64, and negative and zero divisors for
+ * divide. The batch functions are timed for each SIMD kernel set
+ * the CPU supports, and some on large arrays for several thread
+ * counts of alu_parallel.h. The caching functions of alu_memo.h
+ * are timed on repeated and on random operand pairs, with their
+ * hit rates, and batch division by a prepared divisor of
+ * alu_divisor.h against divWordN. Add with flags is timed over
+ * interleaved operand pairs and over the columns of a wordbuf of
+ * alu_wordbuf.h. Short jobs submitted to the queue of alu_async.h
+ * are timed against direct batch calls of the same size, which the
+ * queue coalesces into long ones. Each scalar function is also
+ * timed on classes of operands and counts, to show how far its
+ * latency depends on the data, as it should not in builds with
+ * ALU_CONSTANT_TIME (see alu_native.h).
+ *
+ * Results are written as JSON, one object per function and case,
+ * with the nanoseconds per operation and operations per second.
+ * ALU_INSTRUMENT builds add the instrumentation counters of the
+ * run (see alu_instrument.h).
+ *
+ * Usage: alu_bench [-t milliseconds] [-f filter] [-o file]
+ *   -t  minimum time to run each case (default 20)
+ *   -f  only run functions whose name contains filter
+ *   -o  write results to file instead of standard output
+ *
+ * @since 2026-10-14
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "alu.h"
+#include "alu_async.h"
+#include "alu_batch.h"
+#include "alu_divisor.h"
+#include "alu_exec.h"
+#include "alu_instrument.h"
+#include "alu_memo.h"
+#include "alu_micro.h"
+#include "alu_parallel.h"
+#include "alu_ref.h"
+#include "alu_sat.h"
+#include "alu_wordbuf.h"
+
+/** number of operand pairs in each case */
+#define BENCH_N 1024
+
+/** number of operand pairs in each parallel case */
+#define BENCH_PARALLEL_N (256 * BENCH_N)
+
+/** kinds of function signature */
+typedef enum benchkind {
+	predicate, relation, compare, counting, unary, binary, shift, twoResult, carryResult,
+	getBit, setBit, load, store
+} benchkind;
+
+/** definition of a benchmarked function */
+typedef struct benchfn {
+	const char *name;	// function name
+	const char *engine;	// "native" or "reference"
+	benchkind kind;		// signature of fn
+	void (*fn)(void);	// function, cast to the signature of kind
+	char cases;		// operand distributions: 'l'ogical, 'm'ultiply, 's'hift, 'd'ivide
+} benchfn;
+
+/** operand arrays of a case */
+typedef struct benchcase {
+	char name[32];
+	word op1[BENCH_N];
+	word op2[BENCH_N];
+	int count;
+} benchcase;
+
+/** sink for results so that they are not optimized away */
+static volatile byte sink;
+
+/** state of the operand generator */
+static uint64_t seed = 0x9E3779B97F4A7C15u;
+
+/**
+ * Returns the next pseudo-random 32 bits.
+ *
+ * @return the random bits
+ */
+static uint32_t nextRandom(void) {
+	// xorshift64*
+	seed ^= seed >> 12;
+	seed ^= seed << 25;
+	seed ^= seed >> 27;
+	return (uint32_t)((seed * 0x2545F4914F6CDD1Du) >> 32);
+}
+
+/**
+ * Returns a pseudo-random native word.
+ *
+ * @return the random word
+ */
+static uword randomWord(void) {
+	uint64_t r = ((uint64_t)nextRandom() << 32) | nextRandom();
+	return (uword)r;
+}
+
+/**
+ * Returns the current time in seconds.
+ *
+ * @return the time
+ */
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Run one pass of the function over the operands of the case.
+ *
+ * @param f the function
+ * @param c the case
+ */
+static void runPass(const benchfn *f, const benchcase *c) {
+	word r1, r2;
+	byte acc = 0;
+	switch (f->kind) {
+	case predicate: {
+		bool (*fn)(const word) = (bool (*)(const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= fn(c->op1[i]);
+		}
+		break;
+	}
+	case relation: {
+		bool (*fn)(const word, const word) = (bool (*)(const word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= fn(c->op1[i], c->op2[i]);
+		}
+		break;
+	}
+	case compare: {
+		int (*fn)(const word, const word) = (int (*)(const word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= (byte)fn(c->op1[i], c->op2[i]);
+		}
+		break;
+	}
+	case counting: {
+		int (*fn)(const word) = (int (*)(const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= (byte)fn(c->op1[i]);
+		}
+		break;
+	}
+	case unary: {
+		void (*fn)(word, const word) = (void (*)(word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			fn(r1, c->op1[i]);
+			acc ^= r1[0];
+		}
+		break;
+	}
+	case binary: {
+		void (*fn)(word, const word, const word) = (void (*)(word, const word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			fn(r1, c->op1[i], c->op2[i]);
+			acc ^= r1[0];
+		}
+		break;
+	}
+	case shift: {
+		void (*fn)(word, const word, int) = (void (*)(word, const word, int))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			fn(r1, c->op1[i], c->count);
+			acc ^= r1[0];
+		}
+		break;
+	}
+	case twoResult: {
+		void (*fn)(word, word, const word, const word) =
+			(void (*)(word, word, const word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			fn(r1, r2, c->op1[i], c->op2[i]);
+			acc ^= r1[0] ^ r2[0];
+		}
+		break;
+	}
+	case carryResult: {
+		void (*fn)(word, bit *, bit *, const word, const word) =
+			(void (*)(word, bit *, bit *, const word, const word))f->fn;
+		for (int i = 0; i < BENCH_N; i++) {
+			bit carry, overflow;
+			fn(r1, &carry, &overflow, c->op1[i], c->op2[i]);
+			acc ^= r1[0] ^ carry ^ overflow;
+		}
+		break;
+	}
+	case getBit:
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= getBitOfWord(c->op1[i], i & wordtopbit);
+		}
+		break;
+	case setBit:
+		setWord(r1, zeroWord);
+		for (int i = 0; i < BENCH_N; i++) {
+			setBitOfWord(r1, i & wordtopbit, c->op1[i][0] & 1);
+		}
+		acc ^= r1[0];
+		break;
+	case load:
+		for (int i = 0; i < BENCH_N; i++) {
+			acc ^= (byte)loadWord(c->op1[i]);
+		}
+		break;
+	case store:
+		for (int i = 0; i < BENCH_N; i++) {
+			storeWord(r1, (uword)i);
+			acc ^= r1[0];
+		}
+		break;
+	}
+	sink ^= acc;
+}
+
+/**
+ * Time the function over the operands of the case.
+ *
+ * @param f the function
+ * @param c the case
+ * @param seconds the minimum time
+ * @param ops set to the number of operations timed
+ * @return the nanoseconds per operation
+ */
+static double timeCase(const benchfn *f, const benchcase *c, double seconds, uint64_t *ops) {
+	runPass(f, c);  // warm up
+
+	*ops = 0;
+	double start = now();
+	double elapsed;
+	do {
+		runPass(f, c);
+		*ops += BENCH_N;
+		elapsed = now() - start;
+	} while (elapsed < seconds);
+	return elapsed * 1e9 / *ops;
+}
+
+/**
+ * Time the function over the operands of the case and write one
+ * JSON result.
+ *
+ * @param out the output file
+ * @param f the function
+ * @param c the case
+ * @param seconds the minimum time
+ * @param first true if this is the first result
+ */
+static void runCase(FILE *out, const benchfn *f, const benchcase *c,
+					double seconds, bool first) {
+	uint64_t ops;
+	double ns = timeCase(f, c, seconds, &ops);
+	fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"%s\", "
+			"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+			first ? "" : ",", f->name, f->engine, c->name,
+			ns, 1e9 / ns, (unsigned long long)ops);
+}
+
+/**
+ * Fill the case with operands from the generator, limited to the
+ * specified number of magnitude bits and optionally negated.
+ *
+ * @param c the case
+ * @param name the case name
+ * @param bits1 the magnitude bits of the first operands
+ * @param bits2 the magnitude bits of the second operands
+ * @param sign1 -1 for negative, 1 for positive, 0 for either first operands
+ * @param sign2 -1 for negative, 1 for positive, 0 for either second operands
+ */
+static void fillCase(benchcase *c, const char *name, int bits1, int bits2, int sign1, int sign2) {
+	snprintf(c->name, sizeof(c->name), "%s", name);
+	c->count = 0;
+	for (int i = 0; i < BENCH_N; i++) {
+		uword a = randomWord();
+		uword b = randomWord();
+		if (bits1 < wordsize) {
+			a &= ((uword)1 << bits1) - 1;
+		}
+		if (bits2 < wordsize) {
+			b &= ((uword)1 << bits2) - 1;
+		}
+		if (sign1 < 0 || (sign1 == 0 && (nextRandom() & 1))) {
+			a = 0u - a;
+		}
+		if (sign2 < 0 || (sign2 == 0 && (nextRandom() & 1))) {
+			b = 0u - b;
+		}
+		storeWord(c->op1[i], a);
+		storeWord(c->op2[i], b);
+	}
+}
+
+/** functions of word.h and alu.h, with their reference engines */
+static const benchfn functions[] = {
+	{"setWord", "native", unary, (void (*)(void))setWord, 'l'},
+	{"getBitOfWord", "native", getBit, NULL, 'l'},
+	{"setBitOfWord", "native", setBit, NULL, 'l'},
+	{"loadWord", "native", load, NULL, 'l'},
+	{"storeWord", "native", store, NULL, 'l'},
+
+	{"testLtWord", "native", predicate, (void (*)(void))testLtWord, 'l'},
+	{"testLtWord", "reference", predicate, (void (*)(void))testLtWordRef, 'l'},
+	{"testGeWord", "native", predicate, (void (*)(void))testGeWord, 'l'},
+	{"testGeWord", "reference", predicate, (void (*)(void))testGeWordRef, 'l'},
+	{"testEqWord", "native", predicate, (void (*)(void))testEqWord, 'l'},
+	{"testEqWord", "reference", predicate, (void (*)(void))testEqWordRef, 'l'},
+	{"cmpWord", "native", compare, (void (*)(void))cmpWord, 'l'},
+	{"cmpWord", "reference", compare, (void (*)(void))cmpWordRef, 'l'},
+	{"cmpuWord", "native", compare, (void (*)(void))cmpuWord, 'l'},
+	{"cmpuWord", "reference", compare, (void (*)(void))cmpuWordRef, 'l'},
+	{"cmpLtuWord", "native", relation, (void (*)(void))cmpLtuWord, 'l'},
+	{"cmpLtuWord", "reference", relation, (void (*)(void))cmpLtuWordRef, 'l'},
+	{"cmpGeuWord", "native", relation, (void (*)(void))cmpGeuWord, 'l'},
+	{"cmpGeuWord", "reference", relation, (void (*)(void))cmpGeuWordRef, 'l'},
+	{"sminWord", "native", binary, (void (*)(void))sminWord, 'l'},
+	{"sminWord", "reference", binary, (void (*)(void))sminWordRef, 'l'},
+	{"smaxWord", "native", binary, (void (*)(void))smaxWord, 'l'},
+	{"smaxWord", "reference", binary, (void (*)(void))smaxWordRef, 'l'},
+	{"uminWord", "native", binary, (void (*)(void))uminWord, 'l'},
+	{"uminWord", "reference", binary, (void (*)(void))uminWordRef, 'l'},
+	{"umaxWord", "native", binary, (void (*)(void))umaxWord, 'l'},
+	{"umaxWord", "reference", binary, (void (*)(void))umaxWordRef, 'l'},
+
+	{"ashWord", "native", shift, (void (*)(void))ashWord, 's'},
+	{"ashWord", "reference", shift, (void (*)(void))ashWordRef, 's'},
+	{"cshWord", "native", shift, (void (*)(void))cshWord, 's'},
+	{"cshWord", "reference", shift, (void (*)(void))cshWordRef, 's'},
+	{"lshWord", "native", shift, (void (*)(void))lshWord, 's'},
+	{"lshWord", "reference", shift, (void (*)(void))lshWordRef, 's'},
+	{"maskWord", "native", shift, (void (*)(void))maskWord, 's'},
+	{"maskWord", "reference", shift, (void (*)(void))maskWordRef, 's'},
+
+	{"andWord", "native", binary, (void (*)(void))andWord, 'l'},
+	{"andWord", "reference", binary, (void (*)(void))andWordRef, 'l'},
+	{"orWord", "native", binary, (void (*)(void))orWord, 'l'},
+	{"orWord", "reference", binary, (void (*)(void))orWordRef, 'l'},
+	{"xorWord", "native", binary, (void (*)(void))xorWord, 'l'},
+	{"xorWord", "reference", binary, (void (*)(void))xorWordRef, 'l'},
+	{"notWord", "native", unary, (void (*)(void))notWord, 'l'},
+	{"notWord", "reference", unary, (void (*)(void))notWordRef, 'l'},
+	{"negativeWord", "native", unary, (void (*)(void))negativeWord, 'l'},
+	{"negativeWord", "reference", unary, (void (*)(void))negativeWordRef, 'l'},
+
+	{"addWord", "native", binary, (void (*)(void))addWord, 'l'},
+	{"addWord", "reference", binary, (void (*)(void))addWordRef, 'l'},
+	{"subWord", "native", binary, (void (*)(void))subWord, 'l'},
+	{"subWord", "reference", binary, (void (*)(void))subWordRef, 'l'},
+	{"addCarryWord", "native", carryResult, (void (*)(void))addCarryWord, 'l'},
+	{"addCarryWord", "reference", carryResult, (void (*)(void))addCarryWordRef, 'l'},
+	{"subCarryWord", "native", carryResult, (void (*)(void))subCarryWord, 'l'},
+	{"subCarryWord", "reference", carryResult, (void (*)(void))subCarryWordRef, 'l'},
+
+	{"addSatWord", "native", binary, (void (*)(void))addSatWord, 'l'},
+	{"subSatWord", "native", binary, (void (*)(void))subSatWord, 'l'},
+	{"ashSatWord", "native", shift, (void (*)(void))ashSatWord, 's'},
+
+	{"mulWord", "native", binary, (void (*)(void))mulWord, 'm'},
+	{"mulWord", "reference", binary, (void (*)(void))mulWordRef, 'm'},
+	{"mulSatWord", "native", binary, (void (*)(void))mulSatWord, 'm'},
+	{"mulWideWord", "native", twoResult, (void (*)(void))mulWideWord, 'm'},
+	{"mulWideWord", "reference", twoResult, (void (*)(void))mulWideWordRef, 'm'},
+
+	{"div2Word", "native", twoResult, (void (*)(void))div2Word, 'd'},
+	{"div2Word", "reference", twoResult, (void (*)(void))div2WordRef, 'd'},
+	{"divWord", "native", binary, (void (*)(void))divWord, 'd'},
+	{"remainderWord", "native", binary, (void (*)(void))remainderWord, 'd'},
+	{"mulHighuWord", "native", binary, (void (*)(void))mulHighuWord, 'm'},
+	{"mulHighuWord", "reference", binary, (void (*)(void))mulHighuWordRef, 'm'},
+	{"div2uWord", "native", twoResult, (void (*)(void))div2uWord, 'd'},
+	{"div2uWord", "reference", twoResult, (void (*)(void))div2uWordRef, 'd'},
+	{"divuWord", "native", binary, (void (*)(void))divuWord, 'd'},
+	{"remainderuWord", "native", binary, (void (*)(void))remainderuWord, 'd'},
+
+	{"popcountWord", "native", counting, (void (*)(void))popcountWord, 'l'},
+	{"popcountWord", "reference", counting, (void (*)(void))popcountWordRef, 'l'},
+	{"clzWord", "native", counting, (void (*)(void))clzWord, 'm'},
+	{"clzWord", "reference", counting, (void (*)(void))clzWordRef, 'm'},
+	{"ctzWord", "native", counting, (void (*)(void))ctzWord, 'l'},
+	{"ctzWord", "reference", counting, (void (*)(void))ctzWordRef, 'l'},
+	{"bitReverseWord", "native", unary, (void (*)(void))bitReverseWord, 'l'},
+	{"bitReverseWord", "reference", unary, (void (*)(void))bitReverseWordRef, 'l'},
+	{"byteSwapWord", "native", unary, (void (*)(void))byteSwapWord, 'l'},
+	{"byteSwapWord", "reference", unary, (void (*)(void))byteSwapWordRef, 'l'},
+	{"extractField", "native", binary, (void (*)(void))extractField, 'l'},
+	{"extractField", "reference", binary, (void (*)(void))extractFieldRef, 'l'},
+	{"depositField", "native", binary, (void (*)(void))depositField, 'l'},
+	{"depositField", "reference", binary, (void (*)(void))depositFieldRef, 'l'},
+};
+
+/** number of benchmarked functions */
+static const int nfunctions = sizeof(functions) / sizeof(functions[0]);
+
+/**
+ * Time the scalar functions over the cases for their kind of operand.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runFunctions(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase logical, mulSmall, mulLarge, mulMixed, shiftCase;
+	static benchcase divPositive, divNegative, divSmall, divZero;
+	fillCase(&logical, "random", wordsize, wordsize, 0, 0);
+	fillCase(&mulSmall, "small", 8, 8, 0, 0);
+	fillCase(&mulLarge, "large", wordsize - 1, wordsize - 1, 0, 0);
+	fillCase(&mulMixed, "large_by_small", wordsize - 1, 8, 0, 0);
+	fillCase(&shiftCase, "count", wordsize, wordsize, 0, 0);
+	fillCase(&divPositive, "positive", wordsize - 1, 16, 1, 1);
+	fillCase(&divNegative, "negative_divisor", wordsize - 1, 16, 0, -1);
+	fillCase(&divSmall, "small_dividend", 8, 4, 0, 0);
+	fillCase(&divZero, "zero_divisor", wordsize - 1, 0, 0, 0);
+
+	for (int i = 0; i < nfunctions; i++) {
+		const benchfn *f = &functions[i];
+		if (filter != NULL && strstr(f->name, filter) == NULL) {
+			continue;
+		}
+		switch (f->cases) {
+		case 'l':
+			runCase(out, f, &logical, seconds, first);
+			first = false;
+			break;
+		case 'm':
+			runCase(out, f, &mulSmall, seconds, first);
+			runCase(out, f, &mulLarge, seconds, false);
+			runCase(out, f, &mulMixed, seconds, false);
+			first = false;
+			break;
+		case 's':
+			for (int count = 0; count <= 2 * wordsize; count++) {
+				snprintf(shiftCase.name, sizeof(shiftCase.name), "count_%d", count);
+				shiftCase.count = count;
+				runCase(out, f, &shiftCase, seconds, first);
+				first = false;
+			}
+			break;
+		case 'd':
+			runCase(out, f, &divPositive, seconds, first);
+			runCase(out, f, &divNegative, seconds, false);
+			runCase(out, f, &divSmall, seconds, false);
+			runCase(out, f, &divZero, seconds, false);
+			first = false;
+			break;
+		}
+	}
+	return first;
+}
+
+/** number of operand classes of the latency cases */
+#define LATENCY_CLASSES 8
+
+/** number of times each latency class is timed */
+#define LATENCY_TRIALS 3
+
+/**
+ * Fill the case with the same operand pair throughout.
+ *
+ * @param c the case
+ * @param name the case name
+ * @param a the first operand
+ * @param b the second operand
+ */
+static void fillConstant(benchcase *c, const char *name, uword a, uword b) {
+	snprintf(c->name, sizeof(c->name), "%s", name);
+	c->count = 0;
+	for (int i = 0; i < BENCH_N; i++) {
+		storeWord(c->op1[i], a);
+		storeWord(c->op2[i], b);
+	}
+}
+
+/**
+ * Time each scalar function on classes of operands that take the
+ * bit-serial engines and data-dependent native paths different
+ * times: zero, one, small, random, negative and the extreme words,
+ * with a zero divisor for divide, and for shifts random words by
+ * counts of 0, 1, wordtopbit, wordsize and beyond in both
+ * directions. One result is written per function with the
+ * nanoseconds per operation of each class and the spread, the
+ * ratio of the slowest class to the fastest, taking the fastest
+ * of LATENCY_TRIALS timings of each class. ALU_CONSTANT_TIME
+ * builds should give a spread near 1 for every native function.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each class
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runLatency(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase operands[LATENCY_CLASSES], counts[LATENCY_CLASSES];
+	fillConstant(&operands[0], "zero", 0, 0);
+	fillConstant(&operands[1], "one", 1, 1);
+	fillCase(&operands[2], "small", 8, 8, 1, 1);
+	fillCase(&operands[3], "random", wordsize, wordsize, 0, 0);
+	fillCase(&operands[4], "negative", wordsize - 1, wordsize - 1, -1, -1);
+	fillConstant(&operands[5], "min", loadWord(minWord), loadWord(minWord));
+	fillConstant(&operands[6], "max", loadWord(maxWord), loadWord(maxWord));
+	fillCase(&operands[7], "zero_divisor", wordsize, 0, 0, 1);
+
+	const int shiftCounts[LATENCY_CLASSES] = {
+		0, 1, wordtopbit, wordsize, 2 * wordsize, -1, -wordtopbit, -2 * wordsize
+	};
+	for (int k = 0; k < LATENCY_CLASSES; k++) {
+		fillCase(&counts[k], "", wordsize, wordsize, 0, 0);
+		snprintf(counts[k].name, sizeof(counts[k].name), "count_%d", shiftCounts[k]);
+		counts[k].count = shiftCounts[k];
+	}
+
+	for (int i = 0; i < nfunctions; i++) {
+		const benchfn *f = &functions[i];
+		if (filter != NULL && strstr(f->name, filter) == NULL) {
+			continue;
+		}
+		const benchcase *classes = (f->cases == 's') ? counts : operands;
+
+		// best of interleaved trials, so that noise and drift affect all classes alike
+		double ns[LATENCY_CLASSES], lo = 0, hi = 0, sum = 0;
+		for (int t = 0; t < LATENCY_TRIALS; t++) {
+			for (int k = 0; k < LATENCY_CLASSES; k++) {
+				uint64_t ops;
+				double trial = timeCase(f, &classes[k], seconds, &ops);
+				ns[k] = (t == 0 || trial < ns[k]) ? trial : ns[k];
+			}
+		}
+		for (int k = 0; k < LATENCY_CLASSES; k++) {
+			lo = (k == 0 || ns[k] < lo) ? ns[k] : lo;
+			hi = (k == 0 || ns[k] > hi) ? ns[k] : hi;
+			sum += ns[k];
+		}
+
+		fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"latency\", "
+				"\"ns_per_op\": %.3f, \"classes\": {", first ? "" : ",", f->name, f->engine,
+				sum / LATENCY_CLASSES);
+		for (int k = 0; k < LATENCY_CLASSES; k++) {
+			fprintf(out, "%s\"%s\": %.3f", k ? ", " : "", classes[k].name, ns[k]);
+		}
+		fprintf(out, "}, \"min_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, \"spread\": %.3f}",
+				lo, hi, lo > 0 ? hi / lo : 0.0);
+		first = false;
+	}
+	return first;
+}
+
+/**
+ * Time the caching multiply and divide on operands with many
+ * repeated pairs and on random operands, and write the hit rate
+ * with each result.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runMemo(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase repeated, random;
+	static const char *memoNames[] = {"memoMulWord", "memoDiv2Word"};
+
+	// 64 dividends by 4 constant divisors, and random pairs
+	fillCase(&repeated, "repeated", wordsize - 1, 8, 0, 1);
+	for (int i = 0; i < BENCH_N; i++) {
+		setWord(repeated.op1[i], repeated.op1[i % 64]);
+		setWord(repeated.op2[i], repeated.op2[i / 64 % 4]);
+	}
+	fillCase(&random, "random", wordsize, wordsize - 4, 0, 0);
+	const benchcase *cases[] = {&repeated, &random};
+
+	for (int b = 0; b < 2; b++) {
+		if (filter != NULL && strstr(memoNames[b], filter) == NULL) {
+			continue;
+		}
+		for (int k = 0; k < 2; k++) {
+			const benchcase *c = cases[k];
+			memoClear();
+			uint64_t ops = 0;
+			double start = now();
+			double elapsed;
+			do {
+				word r1, r2;
+				for (int i = 0; i < BENCH_N; i++) {
+					if (b == 0) {
+						memoMulWord(r1, c->op1[i], c->op2[i]);
+					} else {
+						memoDiv2Word(r1, r2, c->op1[i], c->op2[i]);
+					}
+					sink ^= r1[0];
+				}
+				ops += BENCH_N;
+				elapsed = now() - start;
+			} while (elapsed < seconds);
+
+			memostats stats;
+			memoStats(&stats);
+			uint64_t hits = b == 0 ? stats.mulHits : stats.divHits;
+			double ns = elapsed * 1e9 / ops;
+			fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"%s\", "
+					"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu, \"hit_rate\": %.3f}",
+					first ? "" : ",", memoNames[b],
+#ifdef ALU_REFERENCE
+					"reference",
+#else
+					"native",
+#endif
+					c->name, ns, 1e9 / ns, (unsigned long long)ops, (double)hits / ops);
+			first = false;
+		}
+	}
+	memoClear();
+	return first;
+}
+
+/**
+ * Time batch division by one divisor, both with divWordN and with
+ * a prepared divisor. Times are per element and include preparing
+ * the divisor once per batch.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runDivisor(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase c;
+	static word divisors[BENCH_N], result[BENCH_N];
+	static const char *divisorNames[] = {"divWordN", "divWordByN", "remainderWordByN"};
+	static const int ndivisor = sizeof(divisorNames) / sizeof(divisorNames[0]);
+	static const int values[] = {7, -10, 1000, 3};
+
+	for (int b = 0; b < ndivisor; b++) {
+		if (filter != NULL && strstr(divisorNames[b], filter) == NULL) {
+			continue;
+		}
+		for (size_t k = 0; k < sizeof(values) / sizeof(values[0]); k++) {
+			fillCase(&c, "", wordsize, wordsize, 0, 0);
+			snprintf(c.name, sizeof(c.name), "divisor_%d", values[k]);
+			for (int i = 0; i < BENCH_N; i++) {
+				storeWord(divisors[i], (uword)values[k]);
+			}
+			uint64_t ops = 0;
+			double start = now();
+			double elapsed;
+			do {
+				divisor d;
+				switch (b) {
+				case 0: divWordN(result, (const word *)c.op1, (const word *)divisors, BENCH_N); break;
+				case 1:
+					prepareDivisor(&d, divisors[0]);
+					divWordByN(result, (const word *)c.op1, &d, BENCH_N);
+					break;
+				case 2:
+					prepareDivisor(&d, divisors[0]);
+					remainderWordByN(result, (const word *)c.op1, &d, BENCH_N);
+					break;
+				}
+				sink ^= result[0][0];
+				ops += BENCH_N;
+				elapsed = now() - start;
+			} while (elapsed < seconds);
+
+			double ns = elapsed * 1e9 / ops;
+			fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"%s\", "
+					"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+					first ? "" : ",", divisorNames[b],
+#ifdef ALU_REFERENCE
+					"reference",
+#else
+					"native",
+#endif
+					c.name, ns, 1e9 / ns, (unsigned long long)ops);
+			first = false;
+		}
+	}
+	return first;
+}
+
+/**
+ * Time a few batch functions for each SIMD kernel set the CPU
+ * supports. Times are per element.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runBatch(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase c;
+	static word result[BENCH_N];
+	static uint64_t mask[BENCH_N / 64];
+	static const char *names[] = {"scalar", "sse2", "avx2", "neon"};
+	static const char *batchNames[] = {"andWordN", "addWordN", "lshWordN", "testLtWordMask",
+									   "expressionWordN", "microRunN"};
+	static const int nbatch = sizeof(batchNames) / sizeof(batchNames[0]);
+	fillCase(&c, "random", wordsize, wordsize, 0, 0);
+
+	// (a + b) << 3 ^ a, both as batch calls and as a microprogram
+	microprogram p;
+	microInit(&p, 2);
+	microFuse(&p, microBinary(&p, microXor, microShift(&p, microLsh,
+			  microBinary(&p, microAdd, 0, 1), 3), 0));
+	const word *inputs[] = {(const word *)c.op1, (const word *)c.op2};
+
+	for (size_t k = 0; k < sizeof(names) / sizeof(names[0]); k++) {
+		if (!selectBatchKernels(names[k])) {
+			continue;
+		}
+		for (int b = 0; b < nbatch; b++) {
+			if (filter != NULL && strstr(batchNames[b], filter) == NULL) {
+				continue;
+			}
+			uint64_t ops = 0;
+			double start = now();
+			double elapsed;
+			do {
+				switch (b) {
+				case 0: andWordN(result, (const word *)c.op1, (const word *)c.op2, BENCH_N); break;
+				case 1: addWordN(result, (const word *)c.op1, (const word *)c.op2, BENCH_N); break;
+				case 2: lshWordN(result, (const word *)c.op1, 5, BENCH_N); break;
+				case 3: testLtWordMask(mask, (const word *)c.op1, BENCH_N); result[0][0] ^= (byte)mask[0]; break;
+				case 4:
+					addWordN(result, (const word *)c.op1, (const word *)c.op2, BENCH_N);
+					lshWordN(result, (const word *)result, 3, BENCH_N);
+					xorWordN(result, (const word *)result, (const word *)c.op1, BENCH_N);
+					break;
+				case 5: microRunN(&p, result, inputs, BENCH_N); break;
+				}
+				sink ^= result[0][0];
+				ops += BENCH_N;
+				elapsed = now() - start;
+			} while (elapsed < seconds);
+
+			double ns = elapsed * 1e9 / ops;
+			fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"%s\", "
+					"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+					first ? "" : ",", batchNames[b], names[k], c.name,
+					ns, 1e9 / ns, (unsigned long long)ops);
+			first = false;
+		}
+	}
+	selectBatchKernels(NULL);
+	return first;
+}
+
+/**
+ * Time add with NZCV flags over interleaved operand pairs, one
+ * pair at a time with the scalar functions, against a wordbuf of
+ * alu_wordbuf.h, both loading the pairs into its columns first
+ * and with the operands already in them.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runWordbuf(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase c;
+	static word pairs[BENCH_N][2];
+	static byte flags[BENCH_N];
+	static const char *names[] = {"addCarryWord", "wordbufAddCarry", "wordbufAddCarry"};
+	static const char *caseNames[] = {"pairs", "pairs", "columns"};
+	fillCase(&c, "", wordsize, wordsize, 0, 0);
+	for (int i = 0; i < BENCH_N; i++) {
+		setWord(pairs[i][0], c.op1[i]);
+		setWord(pairs[i][1], c.op2[i]);
+	}
+
+	wordarena arena;
+	wordbuf buf;
+	if (!wordArenaInit(&arena, wordbufBytes(BENCH_N)) || !wordbufInit(&buf, &arena, BENCH_N)) {
+		return first;
+	}
+	wordbufLoadPairs(&buf, (const word (*)[2])pairs, BENCH_N);
+
+	for (int b = 0; b < 3; b++) {
+		if (filter != NULL && strstr(names[b], filter) == NULL) {
+			continue;
+		}
+		uint64_t ops = 0;
+		double start = now();
+		double elapsed;
+		do {
+			switch (b) {
+			case 0:
+				for (int i = 0; i < BENCH_N; i++) {
+					word r;
+					bit carry, overflow;
+					addCarryWord(r, &carry, &overflow, pairs[i][0], pairs[i][1]);
+					flags[i] = (byte)((testLtWord(r) ? WORDBUF_FLAG_N : 0) | (testEqWord(r) ? WORDBUF_FLAG_Z : 0)
+							| (carry ? WORDBUF_FLAG_C : 0) | (overflow ? WORDBUF_FLAG_V : 0));
+				}
+				break;
+			case 1:
+				wordbufLoadPairs(&buf, (const word (*)[2])pairs, BENCH_N);
+				wordbufAddCarry(&buf);
+				flags[0] = buf.flags[0];
+				break;
+			case 2:
+				wordbufAddCarry(&buf);
+				flags[0] = buf.flags[0];
+				break;
+			}
+			sink ^= flags[0];
+			ops += BENCH_N;
+			elapsed = now() - start;
+		} while (elapsed < seconds);
+
+		double ns = elapsed * 1e9 / ops;
+		fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"%s\", "
+				"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+				first ? "" : ",", names[b], batchKernels(), caseNames[b],
+				ns, 1e9 / ns, (unsigned long long)ops);
+		first = false;
+	}
+	wordArenaFree(&arena);
+	return first;
+}
+
+/** number of elements of each job of runAsync */
+#define ASYNC_JOB_N 32
+
+/**
+ * Time short batch jobs as direct batch calls and as jobs of the
+ * asynchronous queue, submitted together and then waited for.
+ * Times are per element.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runAsync(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase c;
+	static asyncjob jobs[BENCH_N / ASYNC_JOB_N];
+	static word result[BENCH_N];
+	static const char *names[] = {"mulWordN", "asyncSubmit/mulWordN"};
+	const int njobs = BENCH_N / ASYNC_JOB_N;
+	fillCase(&c, "", wordsize, wordsize, 0, 0);
+	for (int k = 0; k < njobs; k++) {
+		jobs[k] = (asyncjob){
+			.kind = asyncBinary, .f.binary = mulWordN, .result = result + k * ASYNC_JOB_N,
+			.op1 = (const word *)c.op1 + k * ASYNC_JOB_N,
+			.op2 = (const word *)c.op2 + k * ASYNC_JOB_N, .n = ASYNC_JOB_N
+		};
+	}
+
+	for (int b = 0; b < 2; b++) {
+		if (filter != NULL && strstr(names[b], filter) == NULL) {
+			continue;
+		}
+		if (b == 1 && !asyncStart(0)) {
+			break;
+		}
+		uint64_t ops = 0;
+		double start = now();
+		double elapsed;
+		do {
+			if (b == 0) {
+				for (int k = 0; k < njobs; k++) {
+					mulWordN(result + k * ASYNC_JOB_N, (const word *)c.op1 + k * ASYNC_JOB_N,
+							(const word *)c.op2 + k * ASYNC_JOB_N, ASYNC_JOB_N);
+				}
+			} else {
+				// the ring has room for all the jobs
+				for (int k = 0; k < njobs; k++) {
+					asyncSubmit(&jobs[k]);
+				}
+				for (int k = 0; k < njobs; k++) {
+					asyncWait(&jobs[k]);
+				}
+			}
+			sink ^= result[0][0];
+			ops += BENCH_N;
+			elapsed = now() - start;
+		} while (elapsed < seconds);
+
+		double ns = elapsed * 1e9 / ops;
+		fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"%s\", \"case\": \"jobs of %d\", "
+				"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+				first ? "" : ",", names[b], batchKernels(), ASYNC_JOB_N,
+				ns, 1e9 / ns, (unsigned long long)ops);
+		first = false;
+		if (b == 1) {
+			asyncStop();
+		}
+	}
+	return first;
+}
+
+/**
+ * Time a few batch functions on large arrays for several thread
+ * counts of the parallel pool. Times are per element.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time for each case
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runParallel(FILE *out, const char *filter, double seconds, bool first) {
+	static benchcase c;
+	static const char *parallelNames[] = {"parallelBinaryN/mulWordN", "parallelTwoResultN/div2WordN"};
+	static const int nparallel = sizeof(parallelNames) / sizeof(parallelNames[0]);
+	static const int threads[] = {1, 2, 4, 0};
+
+	word *op1 = malloc(BENCH_PARALLEL_N * sizeof(word));
+	word *op2 = malloc(BENCH_PARALLEL_N * sizeof(word));
+	word *result = malloc(BENCH_PARALLEL_N * sizeof(word));
+	word *result2 = malloc(BENCH_PARALLEL_N * sizeof(word));
+	if (op1 == NULL || op2 == NULL || result == NULL || result2 == NULL) {
+		free(op1);
+		free(op2);
+		free(result);
+		free(result2);
+		return first;
+	}
+	fillCase(&c, "random", wordsize, wordsize / 2, 0, 0);
+	for (int i = 0; i < BENCH_PARALLEL_N; i++) {
+		setWord(op1[i], c.op1[i % BENCH_N]);
+		setWord(op2[i], c.op2[(i / BENCH_N + i) % BENCH_N]);
+	}
+
+	for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+		if (!parallelSetThreads(threads[t])) {
+			continue;
+		}
+		char name[32];
+		snprintf(name, sizeof(name), "threads=%d", parallelThreads());
+		for (int b = 0; b < nparallel; b++) {
+			if (filter != NULL && strstr(parallelNames[b], filter) == NULL) {
+				continue;
+			}
+			uint64_t ops = 0;
+			double start = now();
+			double elapsed;
+			do {
+				switch (b) {
+				case 0: parallelBinaryN(mulWordN, result, (const word *)op1, (const word *)op2, BENCH_PARALLEL_N); break;
+				case 1: parallelTwoResultN(div2WordN, result, result2, (const word *)op1, (const word *)op2, BENCH_PARALLEL_N); break;
+				}
+				sink ^= result[BENCH_PARALLEL_N - 1][0];
+				ops += BENCH_PARALLEL_N;
+				elapsed = now() - start;
+			} while (elapsed < seconds);
+
+			double ns = elapsed * 1e9 / ops;
+			fprintf(out, "%s\n    {\"name\": \"%s\", \"engine\": \"parallel\", \"case\": \"%s\", "
+					"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+					first ? "" : ",", parallelNames[b], name,
+					ns, 1e9 / ns, (unsigned long long)ops);
+			first = false;
+		}
+	}
+	parallelSetThreads(1);
+
+	free(op1);
+	free(op2);
+	free(result);
+	free(result2);
+	return first;
+}
+
+/**
+ * Time the executor on a loop of ALU instructions and write one
+ * JSON result, unless the filter excludes it.
+ *
+ * @param out the output file
+ * @param filter the name filter, or NULL
+ * @param seconds the minimum time
+ * @param first true if no result has been written yet
+ * @return true if no result has been written yet
+ */
+static bool runExec(FILE *out, const char *filter, double seconds, bool first) {
+	if (filter != NULL && strstr("execRun", filter) == NULL) {
+		return first;
+	}
+
+	// r1 counts down from 1000 while r2..r4 mix the other registers
+	static const uint32_t program[] = {
+		execEncode(execLoadImmediate, 1, 0, 0, 1000),
+		execEncode(execLoadImmediate, 5, 0, 0, 1),
+		execEncode(execAdd, 2, 2, 6, 0),
+		execEncode(execXor, 3, 3, 2, 0),
+		execEncode(execLsh, 4, 3, 0, 3),
+		execEncode(execMul, 6, 4, 2, 0),
+		execEncode(execSub, 1, 1, 5, 0),
+		execEncode(execBranchNonzero, 0, 1, 0, -6),
+		execEncode(execHalt, 0, 0, 0, 0),
+	};
+	execstate s;
+	uint64_t ops = 0;
+	double start = now();
+	double elapsed;
+	do {
+		execInit(&s);
+		storeWord(s.regs[6], randomWord());
+		ops += execRun(&s, program, sizeof(program) / sizeof(program[0]), UINT64_MAX);
+		sink ^= s.regs[4][0];
+		elapsed = now() - start;
+	} while (elapsed < seconds);
+
+	double ns = elapsed * 1e9 / ops;
+	fprintf(out, "%s\n    {\"name\": \"execRun\", \"engine\": \"%s\", \"case\": \"loop\", "
+			"\"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"ops\": %llu}",
+			first ? "" : ",",
+#ifdef ALU_REFERENCE
+			"reference",
+#else
+			"native",
+#endif
+			ns, 1e9 / ns, (unsigned long long)ops);
+	return false;
+}
+
+/**
+ * Main program to run the benchmark.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return the exit status of the program
+ */
+int main(int argc, char *argv[]) {
+	double seconds = 0.020;
+	const char *filter = NULL;
+	const char *path = NULL;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+			seconds = atof(argv[++i]) / 1000.0;
+		} else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+			path = argv[++i];
+		} else {
+			fprintf(stderr, "usage: %s [-t milliseconds] [-f filter] [-o file]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	FILE *out = stdout;
+	if (path != NULL && (out = fopen(path, "w")) == NULL) {
+		perror(path);
+		return EXIT_FAILURE;
+	}
+
+#ifdef ALU_CONSTANT_TIME
+	const char *constantTime = "true";
+#else
+	const char *constantTime = "false";
+#endif
+	fprintf(out, "{\n  \"benchmark\": \"alu\",\n  \"wordsize\": %d,\n"
+			"  \"kernels\": \"%s\",\n  \"constant_time\": %s,\n"
+			"  \"min_seconds\": %g,\n  \"results\": [",
+			wordsize, batchKernels(), constantTime, seconds);
+	bool first = runFunctions(out, filter, seconds, true);
+	first = runLatency(out, filter, seconds, first);
+	first = runMemo(out, filter, seconds, first);
+	first = runDivisor(out, filter, seconds, first);
+	first = runBatch(out, filter, seconds, first);
+	first = runWordbuf(out, filter, seconds, first);
+	first = runParallel(out, filter, seconds, first);
+	first = runAsync(out, filter, seconds, first);
+	runExec(out, filter, seconds, first);
+	fprintf(out, "\n  ]");
+	if (instrumentEnabled()) {
+		// counters of the calling thread, which runs all but the parallel cases
+		instcounts counts;
+		instrumentGet(&counts);
+		fprintf(out, ",\n  \"instrument\": ");
+		instrumentDump(out, &counts);
+	}
+	fprintf(out, "\n}\n");
+
+	if (out != stdout) {
+		fclose(out);
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,399 @@
+/*
+ * alu_diff.c
+ *
+ * This file implements differential checking of the alu.h
+ * functions against the reference engines of alu_ref.h. The
+ * operands of case i of a seed come from a splitmix64 hash of the
+ * seed and i, so a case costs three hashes besides its two calls,
+ * and the cases of a run share no state.
+ *
+ * @since 2026-10-14
+ */
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "alu.h"
+#include "alu_diff.h"
+#include "alu_ref.h"
+
+/** number of edge values */
+#define DIFF_EDGE_WORDS 12
+
+/** number of edge shift counts */
+#define DIFF_EDGE_COUNTS 15
+
+/** names of the checked functions, by diffop */
+static const char *const names[diffOps] = {
+    [diffTestLt] = "testLtWord",
+    [diffTestGe] = "testGeWord",
+    [diffTestEq] = "testEqWord",
+    [diffCmp] = "cmpWord",
+    [diffCmpu] = "cmpuWord",
+    [diffCmpLtu] = "cmpLtuWord",
+    [diffCmpGeu] = "cmpGeuWord",
+    [diffSmin] = "sminWord",
+    [diffSmax] = "smaxWord",
+    [diffUmin] = "uminWord",
+    [diffUmax] = "umaxWord",
+    [diffAsh] = "ashWord",
+    [diffCsh] = "cshWord",
+    [diffLsh] = "lshWord",
+    [diffMask] = "maskWord",
+    [diffAnd] = "andWord",
+    [diffOr] = "orWord",
+    [diffXor] = "xorWord",
+    [diffNot] = "notWord",
+    [diffNegative] = "negativeWord",
+    [diffAdd] = "addWord",
+    [diffSub] = "subWord",
+    [diffAddCarry] = "addCarryWord",
+    [diffSubCarry] = "subCarryWord",
+    [diffMul] = "mulWord",
+    [diffMulWide] = "mulWideWord",
+    [diffDiv2] = "div2Word",
+    [diffDiv] = "divWord",
+    [diffRemainder] = "remainderWord",
+    [diffMulHighu] = "mulHighuWord",
+    [diffDiv2u] = "div2uWord",
+    [diffDivu] = "divuWord",
+    [diffRemainderu] = "remainderuWord",
+    [diffPopcount] = "popcountWord",
+    [diffClz] = "clzWord",
+    [diffCtz] = "ctzWord",
+    [diffBitReverse] = "bitReverseWord",
+    [diffByteSwap] = "byteSwapWord",
+    [diffExtract] = "extractField",
+    [diffDeposit] = "depositField",
+};
+
+/** edge shift counts */
+static const int edgeCounts[DIFF_EDGE_COUNTS] = {
+    0, 1, -1, WORDSIZE - 1, -(WORDSIZE - 1), WORDSIZE, -WORDSIZE,
+    WORDSIZE + 1, -(WORDSIZE + 1), 2 * WORDSIZE, -2 * WORDSIZE,
+    INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1
+};
+
+/**
+ * Returns the name of a checked function.
+ *
+ * @param op the function
+ * @return the name, or NULL for an invalid op
+ */
+const char *diffName(diffop op) {
+    return ((unsigned)op < diffOps) ? names[op] : NULL;
+}
+
+/**
+ * Returns whether a function takes a shift count.
+ *
+ * @param op the function
+ * @return true for the shift and mask functions
+ */
+bool diffHasCount(diffop op) {
+    return op == diffAsh || op == diffCsh || op == diffLsh || op == diffMask;
+}
+
+/**
+ * Sets the edge values: 0, 1, 2, -1, -2, minWord, minWord + 1,
+ * maxWord, maxWord - 1, and 2^k - 1, 2^k and -2^k for k of half
+ * the word size.
+ *
+ * @param edges the edge values
+ */
+static void edgeWords(word edges[DIFF_EDGE_WORDS]) {
+    uword half = (uword)1 << (WORDSIZE / 2);
+    const uword values[DIFF_EDGE_WORDS] = {
+        0, 1, 2, (uword)-1, (uword)-2,
+        loadWord(minWord), (uword)(loadWord(minWord) + 1),
+        loadWord(maxWord), (uword)(loadWord(maxWord) - 1),
+        (uword)(half - 1), half, (uword)(0u - half)
+    };
+    for (int i = 0; i < DIFF_EDGE_WORDS; i++) {
+        storeWord(edges[i], values[i]);
+    }
+}
+
+/**
+ * Runs a function on either engine.
+ *
+ * @param out the outputs
+ * @param ref true for the reference engine
+ * @param op the function
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param count the shift count
+ */
+static void runOp(diffresult *out, bool ref, diffop op, const word op1, const word op2, int count) {
+    memset(out, 0, sizeof(*out));
+    word *r = out->result;
+    bit carry = 0, overflow = 0;
+    switch (op) {
+    case diffTestLt:    out->value = ref ? testLtWordRef(op1) : testLtWord(op1); break;
+    case diffTestGe:    out->value = ref ? testGeWordRef(op1) : testGeWord(op1); break;
+    case diffTestEq:    out->value = ref ? testEqWordRef(op1) : testEqWord(op1); break;
+    case diffCmp:       out->value = ref ? cmpWordRef(op1, op2) : cmpWord(op1, op2); break;
+    case diffCmpu:      out->value = ref ? cmpuWordRef(op1, op2) : cmpuWord(op1, op2); break;
+    case diffCmpLtu:    out->value = ref ? cmpLtuWordRef(op1, op2) : cmpLtuWord(op1, op2); break;
+    case diffCmpGeu:    out->value = ref ? cmpGeuWordRef(op1, op2) : cmpGeuWord(op1, op2); break;
+    case diffSmin:      (ref ? sminWordRef : sminWord)(r[0], op1, op2); break;
+    case diffSmax:      (ref ? smaxWordRef : smaxWord)(r[0], op1, op2); break;
+    case diffUmin:      (ref ? uminWordRef : uminWord)(r[0], op1, op2); break;
+    case diffUmax:      (ref ? umaxWordRef : umaxWord)(r[0], op1, op2); break;
+    case diffAsh:       (ref ? ashWordRef : ashWord)(r[0], op1, count); break;
+    case diffCsh:       (ref ? cshWordRef : cshWord)(r[0], op1, count); break;
+    case diffLsh:       (ref ? lshWordRef : lshWord)(r[0], op1, count); break;
+    case diffMask:      (ref ? maskWordRef : maskWord)(r[0], op1, count); break;
+    case diffAnd:       (ref ? andWordRef : andWord)(r[0], op1, op2); break;
+    case diffOr:        (ref ? orWordRef : orWord)(r[0], op1, op2); break;
+    case diffXor:       (ref ? xorWordRef : xorWord)(r[0], op1, op2); break;
+    case diffNot:       (ref ? notWordRef : notWord)(r[0], op1); break;
+    case diffNegative:  (ref ? negativeWordRef : negativeWord)(r[0], op1); break;
+    case diffAdd:       (ref ? addWordRef : addWord)(r[0], op1, op2); break;
+    case diffSub:       (ref ? subWordRef : subWord)(r[0], op1, op2); break;
+    case diffAddCarry:
+        (ref ? addCarryWordRef : addCarryWord)(r[0], &carry, &overflow, op1, op2);
+        out->value = carry + 2 * overflow;
+        break;
+    case diffSubCarry:
+        (ref ? subCarryWordRef : subCarryWord)(r[0], &carry, &overflow, op1, op2);
+        out->value = carry + 2 * overflow;
+        break;
+    case diffMul:       (ref ? mulWordRef : mulWord)(r[0], op1, op2); break;
+    case diffMulWide:   (ref ? mulWideWordRef : mulWideWord)(r[0], r[1], op1, op2); break;
+    case diffDiv2:      (ref ? div2WordRef : div2Word)(r[0], r[1], op1, op2); break;
+    case diffDiv:
+        // the reference engines have only div2WordRef and div2uWordRef
+        if (ref) {
+            div2WordRef(r[0], r[1], op1, op2);
+            setWord(r[1], zeroWord);
+        } else {
+            divWord(r[0], op1, op2);
+        }
+        break;
+    case diffRemainder:
+        if (ref) {
+            div2WordRef(r[1], r[0], op1, op2);
+            setWord(r[1], zeroWord);
+        } else {
+            remainderWord(r[0], op1, op2);
+        }
+        break;
+    case diffMulHighu:  (ref ? mulHighuWordRef : mulHighuWord)(r[0], op1, op2); break;
+    case diffDiv2u:     (ref ? div2uWordRef : div2uWord)(r[0], r[1], op1, op2); break;
+    case diffDivu:
+        if (ref) {
+            div2uWordRef(r[0], r[1], op1, op2);
+            setWord(r[1], zeroWord);
+        } else {
+            divuWord(r[0], op1, op2);
+        }
+        break;
+    case diffRemainderu:
+        if (ref) {
+            div2uWordRef(r[1], r[0], op1, op2);
+            setWord(r[1], zeroWord);
+        } else {
+            remainderuWord(r[0], op1, op2);
+        }
+        break;
+    case diffPopcount:  out->value = ref ? popcountWordRef(op1) : popcountWord(op1); break;
+    case diffClz:       out->value = ref ? clzWordRef(op1) : clzWord(op1); break;
+    case diffCtz:       out->value = ref ? ctzWordRef(op1) : ctzWord(op1); break;
+    case diffBitReverse: (ref ? bitReverseWordRef : bitReverseWord)(r[0], op1); break;
+    case diffByteSwap:  (ref ? byteSwapWordRef : byteSwapWord)(r[0], op1); break;
+    case diffExtract:   (ref ? extractFieldRef : extractField)(r[0], op1, op2); break;
+    case diffDeposit:   (ref ? depositFieldRef : depositField)(r[0], op1, op2); break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Runs one case through both engines.
+ *
+ * @param mismatch set to the case if the engines differ
+ * @param op the function
+ * @param op1 the first operand
+ * @param op2 the second operand, unused by unary and shift functions
+ * @param count the shift count, used by shift functions
+ * @return true if the engines match
+ */
+bool diffCase(diffmismatch *mismatch, diffop op, const word op1, const word op2, int count) {
+    diffresult fast, ref;
+    runOp(&fast, false, op, op1, op2, count);
+    runOp(&ref, true, op, op1, op2, count);
+    if (memcmp(&fast, &ref, sizeof(fast)) == 0) {
+        return true;
+    }
+    mismatch->index = 0;
+    mismatch->edge = false;
+    mismatch->op = op;
+    setWord(mismatch->op1, op1);
+    setWord(mismatch->op2, op2);
+    mismatch->count = count;
+    mismatch->fast = fast;
+    mismatch->ref = ref;
+    return false;
+}
+
+/**
+ * Returns the splitmix64 hash of a value.
+ *
+ * @param x the value
+ * @return the hash
+ */
+static inline uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9u;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBu;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Sets a random operand: an edge value one time in four, a small
+ * magnitude one time in eight, and random bits otherwise.
+ *
+ * @param result the operand
+ * @param r random bits
+ * @param edges the edge values
+ */
+static inline void randomWord(word result, uint64_t r, const word edges[DIFF_EDGE_WORDS]) {
+    switch (r & 7) {
+    case 0:
+    case 1:
+        setWord(result, edges[(r >> 3) % DIFF_EDGE_WORDS]);
+        break;
+    case 2:
+        storeWord(result, (uword)((r & 8) ? 0u - (uword)((r >> 4) & 0xFF) : (uword)((r >> 4) & 0xFF)));
+        break;
+    default:
+        storeWord(result, (uword)mix(r));
+        break;
+    }
+}
+
+/**
+ * Returns a random shift count: an edge count one time in four,
+ * and a count within twice the word size either side of zero
+ * otherwise.
+ *
+ * @param r random bits
+ * @return the count
+ */
+static inline int randomCount(uint64_t r) {
+    if ((r & 3) == 0) {
+        return edgeCounts[(r >> 2) % DIFF_EDGE_COUNTS];
+    }
+    return (int)((r >> 2) % (4 * WORDSIZE + 1)) - 2 * WORDSIZE;
+}
+
+/**
+ * Runs the random cases first .. first + n - 1 of a seed in order,
+ * stopping at the first mismatch.
+ *
+ * @param mismatch set to the first mismatch
+ * @param seed the seed
+ * @param first the number of the first case
+ * @param n the number of cases
+ * @return true if the engines match for every case
+ */
+bool diffRun(diffmismatch *mismatch, uint64_t seed, uint64_t first, uint64_t n) {
+    word edges[DIFF_EDGE_WORDS];
+    edgeWords(edges);
+    uint64_t key = mix(seed);
+    for (uint64_t i = first; i < first + n; i++) {
+        uint64_t h = key + i * 0x9E3779B97F4A7C15u;
+        word op1, op2;
+        randomWord(op1, mix(h), edges);
+        randomWord(op2, mix(h ^ 0x5555555555555555u), edges);
+        diffop op = (diffop)(i % diffOps);
+        int count = diffHasCount(op) ? randomCount(mix(h ^ 0xAAAAAAAAAAAAAAAAu)) : 0;
+        if (!diffCase(mismatch, op, op1, op2, count)) {
+            mismatch->index = i;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Runs every function on every pair of edge values, and every
+ * shift function on every edge value and edge count, stopping at
+ * the first mismatch.
+ *
+ * @param mismatch set to the first mismatch
+ * @return the number of cases run, with no mismatch, or 0 after a mismatch
+ */
+uint64_t diffEdges(diffmismatch *mismatch) {
+    word edges[DIFF_EDGE_WORDS];
+    edgeWords(edges);
+    uint64_t cases = 0;
+    for (int op = 0; op < diffOps; op++) {
+        int inner = diffHasCount((diffop)op) ? DIFF_EDGE_COUNTS : DIFF_EDGE_WORDS;
+        for (int i = 0; i < DIFF_EDGE_WORDS; i++) {
+            for (int j = 0; j < inner; j++) {
+                int count = diffHasCount((diffop)op) ? edgeCounts[j] : 0;
+                if (!diffCase(mismatch, (diffop)op, edges[i], edges[j % DIFF_EDGE_WORDS], count)) {
+                    mismatch->index = cases;
+                    mismatch->edge = true;
+                    return 0;
+                }
+                cases++;
+            }
+        }
+    }
+    return cases;
+}
+
+/**
+ * Writes a word as a hexadecimal JSON string.
+ *
+ * @param out the output file
+ * @param w the word
+ */
+static void printWord(FILE *out, const word w) {
+    fprintf(out, "\"0x%0*llx\"", WORDBYTES * 2, (unsigned long long)loadWord(w));
+}
+
+/**
+ * Writes the outputs of a function as a JSON object.
+ *
+ * @param out the output file
+ * @param op the function
+ * @param r the outputs
+ */
+static void printResult(FILE *out, diffop op, const diffresult *r) {
+    fprintf(out, "{\"result\": ");
+    printWord(out, r->result[0]);
+    if (op == diffMulWide || op == diffDiv2 || op == diffDiv2u) {
+        fprintf(out, ", \"result2\": ");
+        printWord(out, r->result[1]);
+    }
+    fprintf(out, ", \"value\": %d}", r->value);
+}
+
+/**
+ * Writes a mismatch as a JSON object.
+ *
+ * @param out the output file
+ * @param mismatch the mismatch
+ */
+void diffPrint(FILE *out, const diffmismatch *mismatch) {
+    fprintf(out, "{\"name\": \"%s\", \"%s\": %llu, \"op1\": ",
+            diffName(mismatch->op), mismatch->edge ? "edge" : "case",
+            (unsigned long long)mismatch->index);
+    printWord(out, mismatch->op1);
+    if (diffHasCount(mismatch->op)) {
+        fprintf(out, ", \"count\": %d", mismatch->count);
+    } else {
+        fprintf(out, ", \"op2\": ");
+        printWord(out, mismatch->op2);
+    }
+    fprintf(out, ", \"fast\": ");
+    printResult(out, mismatch->op, &mismatch->fast);
+    fprintf(out, ", \"ref\": ");
+    printResult(out, mismatch->op, &mismatch->ref);
+    fprintf(out, "}");
+}
@@ -0,0 +1,152 @@
+/*
+ * alu_diff.h
+ *
+ * This file declares differential checking of the arithmetic
+ * logic unit: each case runs one alu.h function and its reference
+ * engine from alu_ref.h on the same operands and compares every
+ * output bit for bit, including carry, overflow and the second
+ * result of mulWideWord, div2Word and div2uWord.
+ *
+ * Random cases are numbered, and the function and operands of a
+ * case are derived from the seed and its number alone, so cases
+ * can be run in any order or split between threads, and a
+ * mismatch is reproduced from its seed and number. Operands mix
+ * random words, small magnitudes and the edge values 0, 1, -1,
+ * minWord, maxWord and their neighbours, and shift counts include
+ * 0, counts of at least wordsize and the limits of int; divisors
+ * include 0. diffEdges() runs every pair of edge values.
+ *
+ * In ALU_REFERENCE builds both sides are the reference engines.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_DIFF_H_
+#define ALU_DIFF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "word.h"
+
+/** checked functions of alu.h */
+typedef enum diffop {
+    diffTestLt,      // testLtWord
+    diffTestGe,      // testGeWord
+    diffTestEq,      // testEqWord
+    diffCmp,         // cmpWord
+    diffCmpu,        // cmpuWord
+    diffCmpLtu,      // cmpLtuWord
+    diffCmpGeu,      // cmpGeuWord
+    diffSmin,        // sminWord
+    diffSmax,        // smaxWord
+    diffUmin,        // uminWord
+    diffUmax,        // umaxWord
+    diffAsh,         // ashWord
+    diffCsh,         // cshWord
+    diffLsh,         // lshWord
+    diffMask,        // maskWord
+    diffAnd,         // andWord
+    diffOr,          // orWord
+    diffXor,         // xorWord
+    diffNot,         // notWord
+    diffNegative,    // negativeWord
+    diffAdd,         // addWord
+    diffSub,         // subWord
+    diffAddCarry,    // addCarryWord
+    diffSubCarry,    // subCarryWord
+    diffMul,         // mulWord
+    diffMulWide,     // mulWideWord
+    diffDiv2,        // div2Word
+    diffDiv,         // divWord
+    diffRemainder,   // remainderWord
+    diffMulHighu,    // mulHighuWord
+    diffDiv2u,       // div2uWord
+    diffDivu,        // divuWord
+    diffRemainderu,  // remainderuWord
+    diffPopcount,    // popcountWord
+    diffClz,         // clzWord
+    diffCtz,         // ctzWord
+    diffBitReverse,  // bitReverseWord
+    diffByteSwap,    // byteSwapWord
+    diffExtract,     // extractField
+    diffDeposit,     // depositField
+    diffOps          // number of functions
+} diffop;
+
+/** definition of the outputs of one function call */
+typedef struct diffresult {
+    word result[2];  // result, and remainder or low word
+    int value;       // test, compare or count result, or carry + 2 * overflow
+} diffresult;
+
+/** definition of a mismatch between the engines */
+typedef struct diffmismatch {
+    uint64_t index;   // case number, or edge case number
+    bool edge;        // found by diffEdges()
+    diffop op;        // function
+    word op1;         // first operand
+    word op2;         // second operand
+    int count;        // shift count
+    diffresult fast;  // outputs of alu.h
+    diffresult ref;   // outputs of alu_ref.h
+} diffmismatch;
+
+/**
+ * Returns the name of a checked function.
+ *
+ * @param op the function
+ * @return the name, or NULL for an invalid op
+ */
+const char *diffName(diffop op);
+
+/**
+ * Returns whether a function takes a shift count.
+ *
+ * @param op the function
+ * @return true for the shift and mask functions
+ */
+bool diffHasCount(diffop op);
+
+/**
+ * Runs one case through both engines.
+ *
+ * @param mismatch set to the case if the engines differ
+ * @param op the function
+ * @param op1 the first operand
+ * @param op2 the second operand, unused by unary and shift functions
+ * @param count the shift count, used by shift functions
+ * @return true if the engines match
+ */
+bool diffCase(diffmismatch *mismatch, diffop op, const word op1, const word op2, int count);
+
+/**
+ * Runs the random cases first .. first + n - 1 of a seed in order,
+ * stopping at the first mismatch.
+ *
+ * @param mismatch set to the first mismatch
+ * @param seed the seed
+ * @param first the number of the first case
+ * @param n the number of cases
+ * @return true if the engines match for every case
+ */
+bool diffRun(diffmismatch *mismatch, uint64_t seed, uint64_t first, uint64_t n);
+
+/**
+ * Runs every function on every pair of edge values, and every
+ * shift function on every edge value and edge count, stopping at
+ * the first mismatch.
+ *
+ * @param mismatch set to the first mismatch
+ * @return the number of cases run, with no mismatch, or 0 after a mismatch
+ */
+uint64_t diffEdges(diffmismatch *mismatch);
+
+/**
+ * Writes a mismatch as a JSON object.
+ *
+ * @param out the output file
+ * @param mismatch the mismatch
+ */
+void diffPrint(FILE *out, const diffmismatch *mismatch);
+
+#endif /* ALU_DIFF_H_ */
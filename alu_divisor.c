@@ -0,0 +1,198 @@
+/*
+ * alu_divisor.c
+ *
+ * This file implements division by a prepared divisor. The
+ * magnitude n of a dividend is divided by the magnitude d of the
+ * divisor as in figure 4.1 of Granlund and Montgomery: with
+ * l = ceil(log2 d) and m = floor(2^wordsize * (2^l - d) / d) + 1,
+ *
+ *   t = mulhigh(m, n)
+ *   q = (t + ((n - t) >> min(l, 1))) >> max(l - 1, 0)
+ *
+ * for every n of up to wordsize bits, which includes the magnitude
+ * of the most negative word. The signs are then applied as in
+ * nativeDiv2(). ALU_REFERENCE builds divide with div2Word().
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_divisor.h"
+#include "alu_native.h"
+
+/**
+ * Prepares a divisor for division by divWordBy() and the other
+ * functions of this file.
+ *
+ * @param d the prepared divisor
+ * @param op the divisor
+ */
+void prepareDivisor(divisor *d, const word op) {
+    uword b = loadWord(op);
+    setWord(d->value, op);
+    d->negative = (b & topBit) != 0;
+    d->zero = (b == 0);
+    d->magnitude = d->negative ? 0u - b : b;
+    d->magic = 0;
+    d->shift1 = 0;
+    d->shift2 = 0;
+    if (d->zero) {
+        return;
+    }
+
+    // l = ceil(log2 d), at most wordsize - 1 for the most negative word
+    uword m = d->magnitude;
+    int l = (m == 1) ? 0 : wordsize - (int)leadingZeros((uword)(m - 1));
+
+    // (2^l - d) * 2^wordsize / d by long division, as 2^l - d < d
+    uword rem = (uword)(((uword)1 << l) - m);
+    uword q = 0;
+    for (int i = 0; i < wordsize; i++) {
+        bool carry = (rem & topBit) != 0;
+        rem = (uword)(toUnsigned(rem) << 1);
+        q = (uword)(toUnsigned(q) << 1);
+        if (carry || rem >= m) {
+            rem = (uword)(rem - m);
+            q |= 1;
+        }
+    }
+    d->magic = (uword)(q + 1);
+    d->shift1 = (l < 1) ? l : 1;
+    d->shift2 = (l > 1) ? l - 1 : 0;
+}
+
+#ifndef ALU_REFERENCE
+/**
+ * Native signed quotient and remainder by a prepared divisor with
+ * the conventions of div2Word().
+ *
+ * @param d the prepared divisor
+ * @param r the remainder
+ * @param a the native dividend
+ * @return the quotient
+ */
+static inline uword divideBy(const divisor *d, uword *r, uword a) {
+    if (d->zero) {
+        // handle divide by 0 as div2Word() does
+        *r = 0;
+        return (a & topBit) ? loadWord(minWord) : loadWord(maxWord);
+    }
+
+    bool negative1 = (a & topBit) != 0;
+    uword n = negative1 ? 0u - a : a;
+    uword t = nativeMulHighu(d->magic, n);
+    uword q = (uword)(t + (uword)((uword)(n - t) >> d->shift1)) >> d->shift2;
+    uword rm = (uword)(n - nativeMul(q, d->magnitude));
+
+    // sign of quotient from operands, sign of remainder from dividend
+    *r = negative1 ? 0u - rm : rm;
+    return (negative1 != d->negative) ? 0u - q : q;
+}
+#endif
+
+/**
+ * Quotient of a word by a prepared divisor also returning
+ * remainder, as div2Word().
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void div2WordBy(word result, word remainder, const word op, const divisor *d) {
+#ifdef ALU_REFERENCE
+    // the reference divide clears its results before reading op
+    word dividend;
+    setWord(dividend, op);
+    div2Word(result, remainder, dividend, d->value);
+#else
+    uword r;
+    uword q = divideBy(d, &r, loadWord(op));
+    storeWord(result, q);
+    storeWord(remainder, r);
+#endif
+}
+
+/**
+ * Quotient of a word by a prepared divisor, as divWord().
+ *
+ * @param result the result
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void divWordBy(word result, const word op, const divisor *d) {
+    word remainder;
+    div2WordBy(result, remainder, op, d);
+}
+
+/**
+ * Remainder of a word by a prepared divisor, as remainderWord().
+ *
+ * @param result the result
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void remainderWordBy(word result, const word op, const divisor *d) {
+    word quotient;
+    div2WordBy(quotient, result, op, d);
+}
+
+/**
+ * Quotients and remainders of words by a prepared divisor. Either
+ * result array may be the same array as the operand array, but
+ * not the same array as the other result array.
+ *
+ * @param result the result array
+ * @param remainder the remainder array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void div2WordByN(word *result, word *remainder, const word *op,
+                 const divisor *d, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        div2WordBy(result[i], remainder[i], op[i], d);
+    }
+}
+
+/**
+ * Quotients of words by a prepared divisor. The result array
+ * may be the same array as the operand array.
+ *
+ * @param result the result array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void divWordByN(word *result, const word *op, const divisor *d, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        divWordBy(result[i], op[i], d);
+#else
+        uword r;
+        storeWord(result[i], divideBy(d, &r, loadWord(op[i])));
+#endif
+    }
+}
+
+/**
+ * Remainders of words by a prepared divisor. The result array
+ * may be the same array as the operand array.
+ *
+ * @param result the result array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void remainderWordByN(word *result, const word *op, const divisor *d, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        remainderWordBy(result[i], op[i], d);
+#else
+        uword r;
+        divideBy(d, &r, loadWord(op[i]));
+        storeWord(result[i], r);
+#endif
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * alu_divisor.h
+ *
+ * This file declares division by a prepared divisor. Preparing a
+ * divisor computes a magic multiplier and shifts once, following
+ * Granlund and Montgomery, "Division by Invariant Integers using
+ * Multiplication" (PLDI 1994), so that each later division is a
+ * multiply-high, an add and two shifts instead of a divide.
+ *
+ * The results are the same as those of div2Word(), divWord() and
+ * remainderWord(): the sign of the quotient is positive if the
+ * signs of the operands match and negative if they do not, the
+ * sign of the remainder matches the sign of the dividend, and a
+ * divisor of 0 gives the largest positive or negative number with
+ * a remainder of 0.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_DIVISOR_H_
+#define ALU_DIVISOR_H_
+
+#include <stddef.h>
+#include "word.h"
+
+/** definition of a prepared divisor */
+typedef struct divisor {
+    word value;       // the divisor
+    uword magnitude;  // magnitude of the divisor
+    uword magic;      // multiplier of the dividend magnitude
+    int shift1;       // shift of the first correction, 0 or 1
+    int shift2;       // final shift of the quotient
+    bit negative;     // divisor is negative
+    bit zero;         // divisor is 0
+} divisor;
+
+/**
+ * Prepares a divisor for division by divWordBy() and the other
+ * functions of this file.
+ *
+ * @param d the prepared divisor
+ * @param op the divisor
+ */
+void prepareDivisor(divisor *d, const word op);
+
+/**
+ * Quotient of a word by a prepared divisor also returning
+ * remainder, as div2Word().
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void div2WordBy(word result, word remainder, const word op, const divisor *d);
+
+/**
+ * Quotient of a word by a prepared divisor, as divWord().
+ *
+ * @param result the result
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void divWordBy(word result, const word op, const divisor *d);
+
+/**
+ * Remainder of a word by a prepared divisor, as remainderWord().
+ *
+ * @param result the result
+ * @param op the dividend
+ * @param d the prepared divisor
+ */
+void remainderWordBy(word result, const word op, const divisor *d);
+
+/**
+ * Quotients and remainders of words by a prepared divisor. Either
+ * result array may be the same array as the operand array, but
+ * not the same array as the other result array.
+ *
+ * @param result the result array
+ * @param remainder the remainder array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void div2WordByN(word *result, word *remainder, const word *op,
+                 const divisor *d, size_t n);
+
+/**
+ * Quotients of words by a prepared divisor. The result array
+ * may be the same array as the operand array.
+ *
+ * @param result the result array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void divWordByN(word *result, const word *op, const divisor *d, size_t n);
+
+/**
+ * Remainders of words by a prepared divisor. The result array
+ * may be the same array as the operand array.
+ *
+ * @param result the result array
+ * @param op the dividend array
+ * @param d the prepared divisor
+ * @param n the number of elements
+ */
+void remainderWordByN(word *result, const word *op, const divisor *d, size_t n);
+
+#endif /* ALU_DIVISOR_H_ */
@@ -0,0 +1,505 @@
+/*
+ * alu_exec.c
+ *
+ * This file implements the instruction executor. The registers
+ * are held as native integers while instructions run, and each
+ * operation uses the inline engines of alu_native.h, or the
+ * alu.h functions in ALU_REFERENCE builds.
+ *
+ * With GCC and compatible compilers, the run loop is threaded:
+ * each handler ends by fetching the next instruction and jumping
+ * through a table of label addresses, so every handler has its
+ * own indirect branch for the predictor. Other compilers use a
+ * switch in a loop.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "alu.h"
+#include "alu_exec.h"
+#include "alu_native.h"
+
+#if defined(__GNUC__)
+#define EXEC_THREADED 1
+#endif
+
+/**
+ * Initializes an executor with zero registers, flags, pc and
+ * instruction counts.
+ *
+ * @param s the executor
+ */
+void execInit(execstate *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+#ifdef ALU_REFERENCE
+/**
+ * Applies a unary alu.h function to a native operand.
+ *
+ * @param f the function
+ * @param a the native operand
+ * @return the native result
+ */
+static uword unaryRef(void (*f)(word, const word), uword a) {
+    word op, result;
+    storeWord(op, a);
+    f(result, op);
+    return loadWord(result);
+}
+
+/**
+ * Applies a binary alu.h function to native operands.
+ *
+ * @param f the function
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static uword binaryRef(void (*f)(word, const word, const word), uword a, uword b) {
+    word op1, op2, result;
+    storeWord(op1, a);
+    storeWord(op2, b);
+    f(result, op1, op2);
+    return loadWord(result);
+}
+
+/**
+ * Applies an alu.h shift or mask function to a native operand.
+ *
+ * @param f the function
+ * @param a the native operand
+ * @param count the shift or mask count
+ * @return the native result
+ */
+static uword shiftRef(void (*f)(word, const word, int), uword a, int count) {
+    word op, result;
+    storeWord(op, a);
+    f(result, op, count);
+    return loadWord(result);
+}
+
+/**
+ * Applies an alu.h function with two results to native operands.
+ *
+ * @param f the function
+ * @param second the native second result
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native first result
+ */
+static uword twoResultRef(void (*f)(word, word, const word, const word),
+                          uword *second, uword a, uword b) {
+    word op1, op2, result1, result2;
+    storeWord(op1, a);
+    storeWord(op2, b);
+    f(result1, result2, op1, op2);
+    *second = loadWord(result2);
+    return loadWord(result1);
+}
+
+/**
+ * Applies addCarryWord() or subCarryWord() to native operands.
+ *
+ * @param f the function
+ * @param carry the carry
+ * @param overflow the overflow
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static uword carryRef(void (*f)(word, bit *, bit *, const word, const word),
+                      bit *carry, bit *overflow, uword a, uword b) {
+    word op1, op2, result;
+    storeWord(op1, a);
+    storeWord(op2, b);
+    f(result, carry, overflow, op1, op2);
+    return loadWord(result);
+}
+
+/**
+ * Applies a two-operand compare to native operands.
+ *
+ * @param f the function
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the comparison
+ */
+static int cmpRef(int (*f)(const word, const word), uword a, uword b) {
+    word op1, op2;
+    storeWord(op1, a);
+    storeWord(op2, b);
+    return f(op1, op2);
+}
+
+/**
+ * Applies a two-operand relation to native operands.
+ *
+ * @param f the function
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the relation
+ */
+static bool relationRef(bool (*f)(const word, const word), uword a, uword b) {
+    word op1, op2;
+    storeWord(op1, a);
+    storeWord(op2, b);
+    return f(op1, op2);
+}
+
+/**
+ * Applies a bit count to a native operand.
+ *
+ * @param f the function
+ * @param a the native operand
+ * @return the count
+ */
+static int countRef(int (*f)(const word), uword a) {
+    word op;
+    storeWord(op, a);
+    return f(op);
+}
+
+/**
+ * Applies a test to a native operand.
+ *
+ * @param f the function
+ * @param a the native operand
+ * @return the test result
+ */
+static bool testRef(bool (*f)(const word), uword a) {
+    word op;
+    storeWord(op, a);
+    return f(op);
+}
+
+// operation of each instruction on the alu.h function
+#define UNARY(f, native)   r[RD] = unaryRef(f, r[RS1])
+#define BINARY(f, native)  r[RD] = binaryRef(f, r[RS1], r[RS2])
+#define SHIFT(f, native)   r[RD] = shiftRef(f, r[RS1], IMM)
+#define TEST(f, native)    r[RD] = testRef(f, r[RS1])
+#define COMPARE(f, native) r[RD] = (uword)cmpRef(f, r[RS1], r[RS2])
+#define COUNT(f, native)   r[RD] = (uword)countRef(f, r[RS1])
+#define RELATION(f, native) r[RD] = relationRef(f, r[RS1], r[RS2])
+#define TWO(f, hi, lo) { \
+        uword second; \
+        uword first = twoResultRef(f, &second, r[RS1], r[RS2]); \
+        r[RD] = first; \
+        r[IMM & 15] = second; \
+    }
+#define CARRY(f, native, c, v) r[RD] = carryRef(f, &carry, &overflow, r[RS1], r[RS2])
+#else
+// operation of each instruction on the native engine, with
+// operands a and b from rs1 and rs2 and a count c from imm
+#define OPERANDS uword a = r[RS1], b = r[RS2]; int c = IMM; (void)b; (void)c
+#define UNARY(f, native)   { OPERANDS; r[RD] = (native); }
+#define BINARY(f, native)  { OPERANDS; r[RD] = (native); }
+#define SHIFT(f, native)   { OPERANDS; r[RD] = (native); }
+#define TEST(f, native)    { OPERANDS; r[RD] = (native); }
+#define COMPARE(f, native) { OPERANDS; r[RD] = (uword)(native); }
+#define COUNT(f, native)   { OPERANDS; r[RD] = (uword)(native); }
+#define RELATION(f, native) { OPERANDS; r[RD] = (native); }
+#define TWO(f, hi, lo) { \
+        OPERANDS; \
+        uword second; \
+        uword first = (hi); \
+        second = (lo); \
+        r[RD] = first; \
+        r[IMM & 15] = second; \
+    }
+#define CARRY(f, native, cy, ov) { \
+        OPERANDS; \
+        uword sum = (native); \
+        carry = (cy); \
+        overflow = (ov); \
+        r[RD] = sum; \
+    }
+#endif /* ALU_REFERENCE */
+
+// fields of the current instruction
+#define RD  ((insn >> 20) & 15)
+#define RS1 ((insn >> 16) & 15)
+#define RS2 ((insn >> 12) & 15)
+#define IMM (((int)(insn & 0xFFF) ^ 0x800) - 0x800)
+
+/**
+ * Returns the operation of an instruction. Unknown opcodes
+ * are execHalt.
+ *
+ * @param insn the instruction
+ * @return the operation
+ */
+static inline unsigned opcodeOf(uint32_t insn) {
+    unsigned op = insn >> 24;
+    return (op < execOps) ? op : execHalt;
+}
+
+#ifdef EXEC_THREADED
+/** fetches the next instruction and jumps to its handler */
+#define NEXT \
+    if (pc >= n || executed == limit) { \
+        goto done; \
+    } \
+    insn = program[pc++]; \
+    executed++; \
+    goto *dispatch[opcodeOf(insn)]
+#define OP(name) op_##name: counts[name]++;
+#else
+#define NEXT continue
+#define OP(name) case name: counts[name]++;
+#endif
+
+/**
+ * Runs instructions from the pc of an executor until a halt,
+ * the end of the program, or the limit.
+ *
+ * @param s the executor
+ * @param program the instructions
+ * @param n the number of instructions
+ * @param limit the maximum number of instructions to execute
+ * @return the number of instructions executed, including a halt
+ */
+uint64_t execRun(execstate *s, const uint32_t *program, size_t n, uint64_t limit) {
+    uword r[EXEC_REGS];
+    for (int k = 0; k < EXEC_REGS; k++) {
+        r[k] = loadWord(s->regs[k]);
+    }
+    bit carry = s->carry;
+    bit overflow = s->overflow;
+    size_t pc = s->pc;
+    uint64_t counts[execOps] = {0};
+    uint64_t executed = 0;
+    uint32_t insn;
+
+#ifdef EXEC_THREADED
+    static const void *const dispatch[execOps] = {
+        [execHalt] = &&op_execHalt,
+        [execMove] = &&op_execMove,
+        [execLoadImmediate] = &&op_execLoadImmediate,
+        [execTestLt] = &&op_execTestLt,
+        [execTestGe] = &&op_execTestGe,
+        [execTestEq] = &&op_execTestEq,
+        [execCmp] = &&op_execCmp,
+        [execCmpu] = &&op_execCmpu,
+        [execAsh] = &&op_execAsh,
+        [execCsh] = &&op_execCsh,
+        [execLsh] = &&op_execLsh,
+        [execMask] = &&op_execMask,
+        [execAnd] = &&op_execAnd,
+        [execOr] = &&op_execOr,
+        [execXor] = &&op_execXor,
+        [execNot] = &&op_execNot,
+        [execNegative] = &&op_execNegative,
+        [execAdd] = &&op_execAdd,
+        [execSub] = &&op_execSub,
+        [execAddCarry] = &&op_execAddCarry,
+        [execSubCarry] = &&op_execSubCarry,
+        [execMul] = &&op_execMul,
+        [execMulWide] = &&op_execMulWide,
+        [execDiv2] = &&op_execDiv2,
+        [execDiv] = &&op_execDiv,
+        [execRemainder] = &&op_execRemainder,
+        [execSmin] = &&op_execSmin,
+        [execSmax] = &&op_execSmax,
+        [execUmin] = &&op_execUmin,
+        [execUmax] = &&op_execUmax,
+        [execBranchZero] = &&op_execBranchZero,
+        [execBranchNonzero] = &&op_execBranchNonzero,
+        [execPopcount] = &&op_execPopcount,
+        [execClz] = &&op_execClz,
+        [execCtz] = &&op_execCtz,
+        [execBitReverse] = &&op_execBitReverse,
+        [execByteSwap] = &&op_execByteSwap,
+        [execExtract] = &&op_execExtract,
+        [execDeposit] = &&op_execDeposit,
+        [execCmpLtu] = &&op_execCmpLtu,
+        [execCmpGeu] = &&op_execCmpGeu,
+        [execMulHighu] = &&op_execMulHighu,
+        [execDiv2u] = &&op_execDiv2u,
+        [execDivu] = &&op_execDivu,
+        [execRemainderu] = &&op_execRemainderu,
+    };
+    NEXT;
+#else
+    for (;;) {
+        if (pc >= n || executed == limit) {
+            goto done;
+        }
+        insn = program[pc++];
+        executed++;
+        switch (opcodeOf(insn)) {
+#endif
+
+    OP(execHalt)
+        pc--;  // stay on the halt
+        goto done;
+    OP(execMove)
+        r[RD] = r[RS1];
+        NEXT;
+    OP(execLoadImmediate)
+        r[RD] = (uword)IMM;
+        NEXT;
+    OP(execTestLt)
+        TEST(testLtWord, a >> wordtopbit);
+        NEXT;
+    OP(execTestGe)
+        TEST(testGeWord, (a >> wordtopbit) ^ 1);
+        NEXT;
+    OP(execTestEq)
+        TEST(testEqWord, a == 0);
+        NEXT;
+    OP(execCmp)
+        COMPARE(cmpWord, nativeCmp(a, b));
+        NEXT;
+    OP(execCmpu)
+        COMPARE(cmpuWord, nativeCmpu(a, b));
+        NEXT;
+    OP(execAsh)
+        SHIFT(ashWord, nativeAsh(a, c));
+        NEXT;
+    OP(execCsh)
+        SHIFT(cshWord, nativeCsh(a, c));
+        NEXT;
+    OP(execLsh)
+        SHIFT(lshWord, nativeLsh(a, c));
+        NEXT;
+    OP(execMask)
+        SHIFT(maskWord, nativeMask(a, c));
+        NEXT;
+    OP(execAnd)
+        BINARY(andWord, a & b);
+        NEXT;
+    OP(execOr)
+        BINARY(orWord, a | b);
+        NEXT;
+    OP(execXor)
+        BINARY(xorWord, a ^ b);
+        NEXT;
+    OP(execNot)
+        UNARY(notWord, (uword)~a);
+        NEXT;
+    OP(execNegative)
+        UNARY(negativeWord, (uword)(0u - a));
+        NEXT;
+    OP(execAdd)
+        BINARY(addWord, (uword)(a + b));
+        NEXT;
+    OP(execSub)
+        BINARY(subWord, (uword)(a - b));
+        NEXT;
+    OP(execAddCarry)
+        CARRY(addCarryWord, (uword)(a + b), sum < a,
+              ((~(a ^ b) & (a ^ sum)) >> wordtopbit) & 1);
+        NEXT;
+    OP(execSubCarry)
+        CARRY(subCarryWord, (uword)(a - b), a >= b,
+              (((a ^ b) & (a ^ sum)) >> wordtopbit) & 1);
+        NEXT;
+    OP(execMul)
+        BINARY(mulWord, nativeMul(a, b));
+        NEXT;
+    OP(execMulWide)
+        TWO(mulWideWord, nativeMulHigh(a, b), nativeMul(a, b));
+        NEXT;
+    OP(execDiv2)
+        TWO(div2Word, nativeDiv2(&second, a, b), second);
+        NEXT;
+    OP(execDiv) {
+        uword rem;
+        (void)rem;
+        BINARY(divWord, nativeDiv2(&rem, a, b));
+        NEXT;
+    }
+    OP(execRemainder) {
+        uword rem;
+        (void)rem;
+        BINARY(remainderWord, (nativeDiv2(&rem, a, b), rem));
+        NEXT;
+    }
+    OP(execSmin)
+        BINARY(sminWord, nativeSmin(a, b));
+        NEXT;
+    OP(execSmax)
+        BINARY(smaxWord, nativeSmax(a, b));
+        NEXT;
+    OP(execUmin)
+        BINARY(uminWord, nativeUmin(a, b));
+        NEXT;
+    OP(execUmax)
+        BINARY(umaxWord, nativeUmax(a, b));
+        NEXT;
+    OP(execBranchZero)
+        if (r[RS1] == 0) {
+            pc += (size_t)IMM;  // wraps for negative offsets
+        }
+        NEXT;
+    OP(execBranchNonzero)
+        if (r[RS1] != 0) {
+            pc += (size_t)IMM;
+        }
+        NEXT;
+    OP(execPopcount)
+        COUNT(popcountWord, populationCount(a));
+        NEXT;
+    OP(execClz)
+        COUNT(clzWord, leadingZeros(a));
+        NEXT;
+    OP(execCtz)
+        COUNT(ctzWord, trailingZeros(a));
+        NEXT;
+    OP(execBitReverse)
+        UNARY(bitReverseWord, nativeBitReverse(a));
+        NEXT;
+    OP(execByteSwap)
+        UNARY(byteSwapWord, nativeByteSwap(a));
+        NEXT;
+    OP(execExtract)
+        BINARY(extractField, nativeExtract(a, b));
+        NEXT;
+    OP(execDeposit)
+        BINARY(depositField, nativeDeposit(a, b));
+        NEXT;
+    OP(execCmpLtu)
+        RELATION(cmpLtuWord, a < b);
+        NEXT;
+    OP(execCmpGeu)
+        RELATION(cmpGeuWord, a >= b);
+        NEXT;
+    OP(execMulHighu)
+        BINARY(mulHighuWord, nativeMulHighu(a, b));
+        NEXT;
+    OP(execDiv2u)
+        TWO(div2uWord, nativeDiv2u(&second, a, b), second);
+        NEXT;
+    OP(execDivu) {
+        uword rem;
+        (void)rem;
+        BINARY(divuWord, nativeDiv2u(&rem, a, b));
+        NEXT;
+    }
+    OP(execRemainderu) {
+        uword rem;
+        (void)rem;
+        BINARY(remainderuWord, (nativeDiv2u(&rem, a, b), rem));
+        NEXT;
+    }
+
+#ifndef EXEC_THREADED
+        }
+    }
+#endif
+
+done:
+    for (int k = 0; k < EXEC_REGS; k++) {
+        storeWord(s->regs[k], r[k]);
+    }
+    s->carry = carry;
+    s->overflow = overflow;
+    s->pc = pc;
+    for (int k = 0; k < execOps; k++) {
+        s->counts[k] += counts[k];
+    }
+    return executed;
+}
@@ -0,0 +1,130 @@
+/*
+ * alu_exec.h
+ *
+ * This file declares an executor that runs streams of encoded
+ * instructions over a register file of words. There is one
+ * instruction for each alu.h function, together with moves,
+ * immediate loads and conditional branches, so an interpreter
+ * can hand whole instruction streams to the executor instead
+ * of dispatching to the alu.h functions one call at a time.
+ *
+ * An instruction is a 32-bit integer with these fields:
+ *
+ *   bits 31-24  opcode (execop)
+ *   bits 23-20  rd, the destination register
+ *   bits 19-16  rs1, the first source register
+ *   bits 15-12  rs2, the second source register
+ *   bits 11-0   imm, a signed immediate
+ *
+ * Shift and mask instructions take their count from imm. The
+ * two-result instructions execMulWide, execDiv2 and execDiv2u
+ * write their second result (the lower word, the remainder) to
+ * register imm & 15. Branches add imm to the index of the next
+ * instruction when their condition holds.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_EXEC_H_
+#define ALU_EXEC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "word.h"
+
+/** number of registers of the register file */
+#define EXEC_REGS 16
+
+/** operations of instructions, with the alu.h function of each */
+typedef enum execop {
+    execHalt,          // stop, leaving pc at the halt
+    execMove,          // rd = rs1
+    execLoadImmediate, // rd = imm, sign extended
+    execTestLt,        // rd = testLtWord(rs1) as 0 or 1
+    execTestGe,        // rd = testGeWord(rs1) as 0 or 1
+    execTestEq,        // rd = testEqWord(rs1) as 0 or 1
+    execCmp,           // rd = cmpWord(rs1, rs2) as -1, 0 or 1
+    execCmpu,          // rd = cmpuWord(rs1, rs2) as -1, 0 or 1
+    execAsh,           // rd = ashWord(rs1, imm)
+    execCsh,           // rd = cshWord(rs1, imm)
+    execLsh,           // rd = lshWord(rs1, imm)
+    execMask,          // rd = maskWord(rs1, imm)
+    execAnd,           // rd = andWord(rs1, rs2)
+    execOr,            // rd = orWord(rs1, rs2)
+    execXor,           // rd = xorWord(rs1, rs2)
+    execNot,           // rd = notWord(rs1)
+    execNegative,      // rd = negativeWord(rs1)
+    execAdd,           // rd = addWord(rs1, rs2)
+    execSub,           // rd = subWord(rs1, rs2)
+    execAddCarry,      // rd = addCarryWord(rs1, rs2), setting carry and overflow
+    execSubCarry,      // rd = subCarryWord(rs1, rs2), setting carry and overflow
+    execMul,           // rd = mulWord(rs1, rs2)
+    execMulWide,       // rd, imm & 15 = mulWideWord(rs1, rs2)
+    execDiv2,          // rd, imm & 15 = div2Word(rs1, rs2)
+    execDiv,           // rd = divWord(rs1, rs2)
+    execRemainder,     // rd = remainderWord(rs1, rs2)
+    execSmin,          // rd = sminWord(rs1, rs2)
+    execSmax,          // rd = smaxWord(rs1, rs2)
+    execUmin,          // rd = uminWord(rs1, rs2)
+    execUmax,          // rd = umaxWord(rs1, rs2)
+    execBranchZero,    // branch by imm if rs1 is zero
+    execBranchNonzero, // branch by imm if rs1 is not zero
+    execPopcount,      // rd = popcountWord(rs1)
+    execClz,           // rd = clzWord(rs1)
+    execCtz,           // rd = ctzWord(rs1)
+    execBitReverse,    // rd = bitReverseWord(rs1)
+    execByteSwap,      // rd = byteSwapWord(rs1)
+    execExtract,       // rd = extractField(rs1, rs2)
+    execDeposit,       // rd = depositField(rs1, rs2)
+    execCmpLtu,        // rd = cmpLtuWord(rs1, rs2) as 0 or 1
+    execCmpGeu,        // rd = cmpGeuWord(rs1, rs2) as 0 or 1
+    execMulHighu,      // rd = mulHighuWord(rs1, rs2)
+    execDiv2u,         // rd, imm & 15 = div2uWord(rs1, rs2)
+    execDivu,          // rd = divuWord(rs1, rs2)
+    execRemainderu,    // rd = remainderuWord(rs1, rs2)
+    execOps            // number of operations
+} execop;
+
+/** definition of the state of an executor */
+typedef struct execstate {
+    word regs[EXEC_REGS];        // register file
+    bit carry;                   // carry of the last execAddCarry or execSubCarry
+    bit overflow;                // overflow of the last execAddCarry or execSubCarry
+    size_t pc;                   // index of the next instruction
+    uint64_t counts[execOps];    // instructions executed, by operation
+} execstate;
+
+/**
+ * Encodes an instruction as a constant expression, so programs
+ * can be static initializers. Register numbers are taken modulo
+ * EXEC_REGS, and imm must be in -2048 .. 2047.
+ */
+#define execEncode(op, rd, rs1, rs2, imm) \
+    (((uint32_t)(op) << 24) | ((uint32_t)((rd) & 15) << 20) \
+     | ((uint32_t)((rs1) & 15) << 16) | ((uint32_t)((rs2) & 15) << 12) \
+     | ((uint32_t)(imm) & 0xFFF))
+
+/**
+ * Initializes an executor with zero registers, flags, pc and
+ * instruction counts.
+ *
+ * @param s the executor
+ */
+void execInit(execstate *s);
+
+/**
+ * Runs instructions from the pc of an executor until a halt,
+ * the end of the program, or the limit. Instructions with an
+ * unknown opcode halt. The registers, flags and pc are left
+ * where execution stopped, and the instruction counts of the
+ * executor accumulate, so a run stopped by the limit can be
+ * resumed by another call.
+ *
+ * @param s the executor
+ * @param program the instructions
+ * @param n the number of instructions
+ * @param limit the maximum number of instructions to execute
+ * @return the number of instructions executed, including a halt
+ */
+uint64_t execRun(execstate *s, const uint32_t *program, size_t n, uint64_t limit);
+
+#endif /* ALU_EXEC_H_ */
@@ -0,0 +1,421 @@
+/*
+ * alu_flags.c
+ *
+ * This file implements the versions of the arithmetic logic
+ * unit functions that also return NZCV condition flags. The
+ * native engines compute the flags from the native result;
+ * ALU_REFERENCE builds compose them from the alu.h functions.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_flags.h"
+#include "alu_native.h"
+
+#ifdef ALU_REFERENCE
+/**
+ * Set flags from a result word.
+ *
+ * @param flags the flags
+ * @param result the result
+ * @param carry the carry flag
+ * @param overflow the overflow flag
+ */
+static void setFlags(aluflags *flags, const word result, bit carry, bit overflow) {
+    flags->n = testLtWord(result);
+    flags->z = testEqWord(result);
+    flags->c = carry;
+    flags->v = overflow;
+}
+
+/**
+ * Returns true if two words are equal.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if the words are equal
+ */
+static bool equalWords(const word op1, const word op2) {
+    word diff;
+    xorWord(diff, op1, op2);
+    return testEqWord(diff);
+}
+#else
+/**
+ * Set flags from a native result.
+ *
+ * @param flags the flags
+ * @param r the native result
+ * @param carry the carry flag
+ * @param overflow the overflow flag
+ */
+static inline void setFlags(aluflags *flags, uword r, bit carry, bit overflow) {
+    flags->n = toBit(r >> wordtopbit);
+    flags->z = (r == 0);
+    flags->c = carry;
+    flags->v = overflow;
+}
+#endif
+
+/**
+ * Arithmetic shift of word by count, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashWordFlags(word result, aluflags *flags, const word op, int count) {
+    unsigned c = shiftCount(count);
+    if (c > (unsigned)wordtopbit) {
+        c = wordtopbit;
+    }
+#ifdef ALU_REFERENCE
+    word localop;
+    setWord(localop, op);
+    ashWord(result, localop, count);
+
+    bit carry = 0, overflow = 0;
+    if (c > 0 && count < 0) {
+        carry = getBitOfWord(localop, c - 1);
+    } else if (c > 0) {
+        carry = getBitOfWord(localop, wordtopbit - c);
+
+        // shifting back recovers the operand unless a lost bit differed from the sign
+        word back;
+        ashWord(back, result, -(int)c);
+        overflow = !equalWords(back, localop);
+    }
+    setFlags(flags, result, carry, overflow);
+#else
+    uword x = loadWord(op);
+    uword r = nativeAsh(x, count);
+
+    bit carry = 0, overflow = 0;
+    if (c > 0 && count < 0) {
+        carry = toBit(x >> (c - 1));  // last of the low c bits
+    } else if (c > 0) {
+        carry = toBit(x >> (wordtopbit - c));  // last of the c bits below the sign
+
+        // lost bits are those that differ from the sign after flipping negative words
+        uword fill = 0u - (x >> wordtopbit);
+        uword lost = (uword)((x ^ fill) >> (wordtopbit - c));
+        overflow = (lost & (uword)((toUnsigned((uword)1) << c) - 1)) != 0;
+    }
+    storeWord(result, r);
+    setFlags(flags, r, carry, overflow);
+#endif
+}
+
+/**
+ * Circular shift of word by count, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void cshWordFlags(word result, aluflags *flags, const word op, int count) {
+    bool rotated = ((unsigned)count & (wordsize - 1)) != 0;  // count mod wordsize
+#ifdef ALU_REFERENCE
+    cshWord(result, op, count);
+    bit carry = 0;
+    if (rotated) {
+        carry = getBitOfWord(result, (count < 0) ? wordtopbit : 0);
+    }
+    setFlags(flags, result, carry, 0);
+#else
+    uword r = nativeCsh(loadWord(op), count);
+    bit carry = 0;
+    if (rotated) {
+        carry = (count < 0) ? toBit(r >> wordtopbit) : toBit(r);
+    }
+    storeWord(result, r);
+    setFlags(flags, r, carry, 0);
+#endif
+}
+
+/**
+ * Logical shift of word by count, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void lshWordFlags(word result, aluflags *flags, const word op, int count) {
+    unsigned c = shiftCount(count);
+    bool shifted = (c > 0 && c <= (unsigned)wordsize);
+#ifdef ALU_REFERENCE
+    word localop;
+    setWord(localop, op);
+    lshWord(result, localop, count);
+    bit carry = 0;
+    if (shifted) {
+        carry = getBitOfWord(localop, (count < 0) ? c - 1 : wordsize - c);
+    }
+    setFlags(flags, result, carry, 0);
+#else
+    uword x = loadWord(op);
+    uword r = nativeLsh(x, count);
+    bit carry = 0;
+    if (shifted) {
+        carry = toBit(x >> ((count < 0) ? c - 1 : wordsize - c));
+    }
+    storeWord(result, r);
+    setFlags(flags, r, carry, 0);
+#endif
+}
+
+/**
+ * Logical and of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void andWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    andWord(result, op1, op2);
+    setFlags(flags, result, 0, 0);
+#else
+    uword r = loadWord(op1) & loadWord(op2);
+    storeWord(result, r);
+    setFlags(flags, r, 0, 0);
+#endif
+}
+
+/**
+ * Logical or of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void orWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    orWord(result, op1, op2);
+    setFlags(flags, result, 0, 0);
+#else
+    uword r = loadWord(op1) | loadWord(op2);
+    storeWord(result, r);
+    setFlags(flags, r, 0, 0);
+#endif
+}
+
+/**
+ * Logical xor of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void xorWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    xorWord(result, op1, op2);
+    setFlags(flags, result, 0, 0);
+#else
+    uword r = loadWord(op1) ^ loadWord(op2);
+    storeWord(result, r);
+    setFlags(flags, r, 0, 0);
+#endif
+}
+
+/**
+ * Logical not of a word operand, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ */
+void notWordFlags(word result, aluflags *flags, const word op) {
+#ifdef ALU_REFERENCE
+    notWord(result, op);
+    setFlags(flags, result, 0, 0);
+#else
+    uword r = ~loadWord(op);
+    storeWord(result, r);
+    setFlags(flags, r, 0, 0);
+#endif
+}
+
+/**
+ * Negative of a word operand, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ */
+void negativeWordFlags(word result, aluflags *flags, const word op) {
+#ifdef ALU_REFERENCE
+    bit carry = testEqWord(op);
+    bit overflow = equalWords(op, minWord);
+    negativeWord(result, op);
+    setFlags(flags, result, carry, overflow);
+#else
+    uword x = loadWord(op);
+    uword r = 0u - x;
+    storeWord(result, r);
+    setFlags(flags, r, x == 0, x == topBit);
+#endif
+}
+
+/**
+ * Sum of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    bit carry, overflow;
+    addCarryWord(result, &carry, &overflow, op1, op2);
+    setFlags(flags, result, carry, overflow);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword r = a + b;
+    storeWord(result, r);
+    setFlags(flags, r, r < a, toBit(((a ^ r) & (b ^ r)) >> wordtopbit));
+#endif
+}
+
+/**
+ * Difference of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    bit carry, overflow;
+    subCarryWord(result, &carry, &overflow, op1, op2);
+    setFlags(flags, result, carry, overflow);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword r = a - b;
+    storeWord(result, r);
+    setFlags(flags, r, a >= b, toBit(((a ^ b) & (a ^ r)) >> wordtopbit));
+#endif
+}
+
+/**
+ * Sum of two word operands and a carry in, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param carry the carry in
+ */
+void adcWordFlags(word result, aluflags *flags, const word op1, const word op2, bit carry) {
+#ifdef ALU_REFERENCE
+    // add the operands, then the carry in; at most one of the sums carries,
+    // and the second overflows only when it undoes an overflow of the first
+    word carryin;
+    setWord(carryin, zeroWord);
+    setBitOfWord(carryin, 0, carry);
+    bit carry1, overflow1, carry2, overflow2;
+    addCarryWord(result, &carry1, &overflow1, op1, op2);
+    addCarryWord(result, &carry2, &overflow2, result, carryin);
+    setFlags(flags, result, carry1 | carry2, overflow1 ^ overflow2);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword s = a + b;
+    uword r = s + toBit(carry);
+    storeWord(result, r);
+    setFlags(flags, r, (s < a) | (r < s), toBit(((a ^ r) & (b ^ r)) >> wordtopbit));
+#endif
+}
+
+/**
+ * Difference of two word operands less a borrow, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param carry the carry in (0 for a borrow)
+ */
+void sbcWordFlags(word result, aluflags *flags, const word op1, const word op2, bit carry) {
+#ifdef ALU_REFERENCE
+    word notop2;
+    notWord(notop2, op2);
+    adcWordFlags(result, flags, op1, notop2, carry);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword nb = ~b;
+    uword s = a + nb;
+    uword r = s + toBit(carry);
+    storeWord(result, r);
+    setFlags(flags, r, (s < a) | (r < s), toBit(((a ^ b) & (a ^ r)) >> wordtopbit));
+#endif
+}
+
+/**
+ * Product of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWordFlags(word result, aluflags *flags, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    word hi, sign;
+    mulWideWord(hi, result, op1, op2);
+    ashWord(sign, result, -wordtopbit);  // sign extension of the lower word
+    setFlags(flags, result, 0, !equalWords(hi, sign));
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    uword lo = nativeMul(a, b);
+    uword hi = nativeMulHigh(a, b);
+    uword sign = 0u - (lo >> wordtopbit);
+    storeWord(result, lo);
+    setFlags(flags, lo, 0, hi != sign);
+#endif
+}
+
+/**
+ * Quotient and remainder of two word operands, also returning
+ * flags for the quotient.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2WordFlags(word result, word remainder, aluflags *flags,
+                   const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    word minusone;
+    notWord(minusone, zeroWord);
+    bit overflow = testEqWord(op2)
+                || (equalWords(op1, minWord) && equalWords(op2, minusone));
+    div2Word(result, remainder, op1, op2);
+    setFlags(flags, result, 0, overflow);
+#else
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    bit overflow = (b == 0) || (a == topBit && b == (uword)~(uword)0);
+    uword r;
+    uword q = nativeDiv2(&r, a, b);
+    storeWord(result, q);
+    storeWord(remainder, r);
+    setFlags(flags, q, 0, overflow);
+#endif
+}
@@ -0,0 +1,198 @@
+/*
+ * alu_flags.h
+ *
+ * This file declares versions of the arithmetic logic unit
+ * functions that also return NZCV condition flags for the
+ * result. The flags are produced by the same pass as the
+ * result rather than by testing the result afterwards.
+ *
+ * Unless noted, N and Z describe the result, and C and V
+ * are cleared. Each result may be the same word as one of
+ * the operands.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_FLAGS_H_
+#define ALU_FLAGS_H_
+
+#include <stdbool.h>
+#include "word.h"
+
+/** definition of the condition flags of an operation */
+typedef struct aluflags {
+    bit n;  // negative: sign bit of the result
+    bit z;  // zero: result is zero
+    bit c;  // carry: carry out, no borrow, or last bit shifted out
+    bit v;  // overflow: signed result does not fit in a word
+} aluflags;
+
+/**
+ * Arithmetic shift of word by count, also returning flags.
+ * C is the last bit shifted out of the value bits, and 0
+ * for a count of 0. V is set if a left shift loses a bit
+ * that differs from the sign bit.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashWordFlags(word result, aluflags *flags, const word op, int count);
+
+/**
+ * Circular shift of word by count, also returning flags.
+ * C is the last bit rotated across the end of the word:
+ * bit 0 of the result for a left shift and the top bit
+ * for a right shift, and 0 if the count is a multiple of
+ * wordsize.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void cshWordFlags(word result, aluflags *flags, const word op, int count);
+
+/**
+ * Logical shift of word by count, also returning flags.
+ * C is the last bit shifted out, and 0 for a count of 0
+ * or of more than wordsize.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ * @param count the shift count
+ */
+void lshWordFlags(word result, aluflags *flags, const word op, int count);
+
+/**
+ * Logical and of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void andWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Logical or of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void orWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Logical xor of two word operands, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void xorWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Logical not of a word operand, also returning flags.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ */
+void notWordFlags(word result, aluflags *flags, const word op);
+
+/**
+ * Negative of a word operand, also returning flags. The
+ * negative is computed as 0 - op, so C is set if op is 0
+ * (no borrow), and V is set if op is minWord.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op the operand
+ */
+void negativeWordFlags(word result, aluflags *flags, const word op);
+
+/**
+ * Sum of two word operands, also returning flags. C is the
+ * carry out of the top bit and V the signed overflow, as
+ * for addCarryWord().
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Difference of two word operands, also returning flags. C
+ * is set if no borrow occurred and V is the signed overflow,
+ * as for subCarryWord().
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Sum of two word operands and a carry in, also returning
+ * flags, for chaining additions across words. C is the
+ * carry out of the top bit and V the signed overflow.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param carry the carry in
+ */
+void adcWordFlags(word result, aluflags *flags, const word op1, const word op2, bit carry);
+
+/**
+ * Difference of two word operands less a borrow, also
+ * returning flags, for chaining subtractions across words.
+ * The difference is op1 + ~op2 + carry, so a carry in of 0
+ * is a borrow in. C is set if no borrow occurred and V is
+ * the signed overflow.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param carry the carry in (0 for a borrow)
+ */
+void sbcWordFlags(word result, aluflags *flags, const word op1, const word op2, bit carry);
+
+/**
+ * Product of two word operands, also returning flags. V is
+ * set if the signed product does not fit in a word, that
+ * is, if mulWideWord() would return an upper word that is
+ * not the sign extension of the result.
+ *
+ * @param result the result
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWordFlags(word result, aluflags *flags, const word op1, const word op2);
+
+/**
+ * Quotient and remainder of two word operands with the
+ * conventions of div2Word(), also returning flags for the
+ * quotient. V is set if the quotient does not fit in a
+ * word: for a divisor of 0, and for minWord divided by -1.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param flags the flags
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2WordFlags(word result, word remainder, aluflags *flags,
+                   const word op1, const word op2);
+
+#endif /* ALU_FLAGS_H_ */
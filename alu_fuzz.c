@@ -0,0 +1,157 @@
+/*
+ * alu_fuzz.c
+ *
+ * This file contains a differential fuzzer of the arithmetic logic
+ * unit. It runs the edge cases of alu_diff.h and then numbered
+ * random cases through the alu.h functions and their reference
+ * engines on several threads, and reports the lowest-numbered
+ * mismatch it finds. Threads claim blocks of cases from a shared
+ * counter and stop claiming once a mismatch is found before their
+ * next block, so the reported case is the first mismatch of the
+ * cases run, and is reproduced with -f and -n 1.
+ *
+ * A summary is written to standard output as JSON, with the
+ * mismatch, if any. The exit status is 1 after a mismatch.
+ *
+ * Usage: alu_fuzz [-n cases] [-j threads] [-s seed] [-f first]
+ *   -n  number of random cases (default 100000000)
+ *   -j  number of threads (default the number of online CPUs)
+ *   -s  seed of the random cases (default 1)
+ *   -f  number of the first random case (default 0)
+ *
+ * @since 2026-10-14
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "alu_diff.h"
+
+/** number of cases claimed by a thread at a time */
+#define FUZZ_BLOCK 65536
+
+/** maximum number of threads */
+#define FUZZ_MAX_THREADS 256
+
+/** definition of a fuzzing run shared by its threads */
+typedef struct fuzzrun {
+	uint64_t seed;                 // seed of the cases
+	uint64_t end;                  // number after the last case
+	_Atomic uint64_t next;         // first case of the next block
+	_Atomic uint64_t found;        // number of the first mismatch found, or end
+	pthread_mutex_t lock;          // guards mismatch
+	diffmismatch mismatch;         // the first mismatch found
+} fuzzrun;
+
+/**
+ * Runs blocks of cases until they are used up or a mismatch is
+ * found before the next block.
+ *
+ * @param arg the run
+ * @return NULL
+ */
+static void *fuzzThread(void *arg) {
+	fuzzrun *run = arg;
+	diffmismatch m;
+	for (;;) {
+		uint64_t first = atomic_fetch_add(&run->next, FUZZ_BLOCK);
+		if (first >= run->end || first >= atomic_load(&run->found)) {
+			break;
+		}
+		uint64_t n = (run->end - first < FUZZ_BLOCK) ? run->end - first : FUZZ_BLOCK;
+		if (!diffRun(&m, run->seed, first, n)) {
+			pthread_mutex_lock(&run->lock);
+			if (m.index < atomic_load(&run->found)) {
+				run->mismatch = m;
+				atomic_store(&run->found, m.index);
+			}
+			pthread_mutex_unlock(&run->lock);
+			break;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Runs the fuzzer.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return the exit status
+ */
+int main(int argc, char *argv[]) {
+	uint64_t cases = 100000000, seed = 1, first = 0;
+	long threads = sysconf(_SC_NPROCESSORS_ONLN);
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			cases = strtoull(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+			threads = strtol(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		} else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			first = strtoull(argv[++i], NULL, 10);
+		} else {
+			fprintf(stderr, "usage: alu_fuzz [-n cases] [-j threads] [-s seed] [-f first]\n");
+			return 2;
+		}
+	}
+	if (threads < 1) {
+		threads = 1;
+	} else if (threads > FUZZ_MAX_THREADS) {
+		threads = FUZZ_MAX_THREADS;
+	}
+
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+
+	fuzzrun run;
+	run.seed = seed;
+	run.end = (cases > UINT64_MAX - first) ? UINT64_MAX : first + cases;
+	atomic_init(&run.next, first);
+	atomic_init(&run.found, run.end);
+	pthread_mutex_init(&run.lock, NULL);
+
+	// the edge cases first, then the random cases
+	uint64_t edges = diffEdges(&run.mismatch);
+	bool failed = (edges == 0);
+	if (!failed) {
+		pthread_t tid[FUZZ_MAX_THREADS];
+		for (long t = 1; t < threads; t++) {
+			if (pthread_create(&tid[t], NULL, fuzzThread, &run) != 0) {
+				threads = t;
+				break;
+			}
+		}
+		fuzzThread(&run);
+		for (long t = 1; t < threads; t++) {
+			pthread_join(tid[t], NULL);
+		}
+		failed = atomic_load(&run.found) < run.end;
+	}
+	pthread_mutex_destroy(&run.lock);
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	double seconds = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+	// the cases before the mismatch, which all matched
+	uint64_t ran = (edges == 0) ? 0 : atomic_load(&run.found) - first;
+	printf("{\"wordsize\": %d, \"threads\": %ld, \"seed\": %llu, \"edge_cases\": %llu, "
+			"\"cases\": %llu, \"seconds\": %.3f, \"cases_per_minute\": %.0f, \"mismatch\": ",
+			WORDSIZE, threads, (unsigned long long)seed, (unsigned long long)edges,
+			(unsigned long long)ran, seconds, seconds > 0 ? (double)(ran + edges) * 60 / seconds : 0.0);
+	if (failed) {
+		diffPrint(stdout, &run.mismatch);
+	} else {
+		printf("null");
+	}
+	printf("}\n");
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * alu_instrument.c
+ *
+ * This file implements the counters of the instrumentation of the
+ * alu.h functions and the functions that merge and write them.
+ * The process totals are guarded by a spin lock, as they are only
+ * updated when a thread collects its counters.
+ *
+ * @since 2026-10-14
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "alu_instrument.h"
+
+#ifdef ALU_INSTRUMENT
+/** counters of this thread */
+_Thread_local instcounts instrumentCounts;
+#endif
+
+/** counters collected from threads */
+static instcounts totals;
+
+/** lock of the totals */
+static atomic_flag totalsLock = ATOMIC_FLAG_INIT;
+
+/** names of the instrumented functions, by instop */
+static const char *const names[instOps] = {
+    [instTestLt] = "testLtWord",
+    [instTestGe] = "testGeWord",
+    [instTestEq] = "testEqWord",
+    [instCmp] = "cmpWord",
+    [instCmpu] = "cmpuWord",
+    [instCmpLtu] = "cmpLtuWord",
+    [instCmpGeu] = "cmpGeuWord",
+    [instSmin] = "sminWord",
+    [instSmax] = "smaxWord",
+    [instUmin] = "uminWord",
+    [instUmax] = "umaxWord",
+    [instAsh] = "ashWord",
+    [instCsh] = "cshWord",
+    [instLsh] = "lshWord",
+    [instMask] = "maskWord",
+    [instAnd] = "andWord",
+    [instOr] = "orWord",
+    [instXor] = "xorWord",
+    [instNot] = "notWord",
+    [instNegative] = "negativeWord",
+    [instAdd] = "addWord",
+    [instSub] = "subWord",
+    [instAddCarry] = "addCarryWord",
+    [instSubCarry] = "subCarryWord",
+    [instMul] = "mulWord",
+    [instMulWide] = "mulWideWord",
+    [instDiv2] = "div2Word",
+    [instDiv] = "divWord",
+    [instRemainder] = "remainderWord",
+    [instMulHighu] = "mulHighuWord",
+    [instDiv2u] = "div2uWord",
+    [instDivu] = "divuWord",
+    [instRemainderu] = "remainderuWord",
+    [instPopcount] = "popcountWord",
+    [instClz] = "clzWord",
+    [instCtz] = "ctzWord",
+    [instBitReverse] = "bitReverseWord",
+    [instByteSwap] = "byteSwapWord",
+    [instExtract] = "extractField",
+    [instDeposit] = "depositField",
+};
+
+/**
+ * Returns whether this build records instrumentation.
+ *
+ * @return true if built with ALU_INSTRUMENT
+ */
+bool instrumentEnabled(void) {
+#ifdef ALU_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the name of an instrumented function.
+ *
+ * @param op the function
+ * @return the name, or NULL for an invalid op
+ */
+const char *instrumentName(instop op) {
+    return ((unsigned)op < instOps) ? names[op] : NULL;
+}
+
+/**
+ * Copies the counters of the calling thread.
+ *
+ * @param counts the counters
+ */
+void instrumentGet(instcounts *counts) {
+#ifdef ALU_INSTRUMENT
+    *counts = instrumentCounts;
+#else
+    memset(counts, 0, sizeof(*counts));
+#endif
+}
+
+/**
+ * Clears the counters of the calling thread.
+ */
+void instrumentClear(void) {
+#ifdef ALU_INSTRUMENT
+    memset(&instrumentCounts, 0, sizeof(instrumentCounts));
+#endif
+}
+
+/**
+ * Adds counters to a total.
+ *
+ * @param total the total
+ * @param counts the counters to add
+ */
+void instrumentMerge(instcounts *total, const instcounts *counts) {
+    for (int op = 0; op < instOps; op++) {
+        total->calls[op] += counts->calls[op];
+        total->iterations[op] += counts->iterations[op];
+        total->cycles[op] += counts->cycles[op];
+        for (int b = 0; b < INSTRUMENT_BUCKETS; b++) {
+            total->histogram[op][b] += counts->histogram[op][b];
+        }
+    }
+}
+
+/**
+ * Adds the counters of the calling thread to the process totals
+ * and clears them. Threads may collect at the same time.
+ */
+void instrumentCollect(void) {
+#ifdef ALU_INSTRUMENT
+    while (atomic_flag_test_and_set_explicit(&totalsLock, memory_order_acquire)) {
+    }
+    instrumentMerge(&totals, &instrumentCounts);
+    atomic_flag_clear_explicit(&totalsLock, memory_order_release);
+    instrumentClear();
+#endif
+}
+
+/**
+ * Copies the process totals, which hold the counters collected
+ * by instrumentCollect().
+ *
+ * @param total the totals
+ */
+void instrumentTotals(instcounts *total) {
+    while (atomic_flag_test_and_set_explicit(&totalsLock, memory_order_acquire)) {
+    }
+    *total = totals;
+    atomic_flag_clear_explicit(&totalsLock, memory_order_release);
+}
+
+/**
+ * Clears the process totals.
+ */
+void instrumentClearTotals(void) {
+    while (atomic_flag_test_and_set_explicit(&totalsLock, memory_order_acquire)) {
+    }
+    memset(&totals, 0, sizeof(totals));
+    atomic_flag_clear_explicit(&totalsLock, memory_order_release);
+}
+
+/**
+ * Writes counters as a JSON array with one object for each
+ * function that was called.
+ *
+ * @param out the output file
+ * @param counts the counters
+ */
+void instrumentDump(FILE *out, const instcounts *counts) {
+    bool first = true;
+    fprintf(out, "[");
+    for (int op = 0; op < instOps; op++) {
+        if (counts->calls[op] == 0 && counts->iterations[op] == 0) {
+            continue;
+        }
+
+        // histogram up to the last nonzero bucket
+        int last = INSTRUMENT_BUCKETS - 1;
+        while (last > 0 && counts->histogram[op][last] == 0) {
+            last--;
+        }
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"calls\": %llu, \"iterations\": %llu, "
+                "\"cycles\": %llu, \"histogram\": [",
+                first ? "" : ",", names[op],
+                (unsigned long long)counts->calls[op],
+                (unsigned long long)counts->iterations[op],
+                (unsigned long long)counts->cycles[op]);
+        for (int b = 0; b <= last; b++) {
+            fprintf(out, "%s%llu", b == 0 ? "" : ", ",
+                    (unsigned long long)counts->histogram[op][b]);
+        }
+        fprintf(out, "]}");
+        first = false;
+    }
+    fprintf(out, "%s]", first ? "" : "\n  ");
+}
@@ -0,0 +1,213 @@
+/*
+ * alu_instrument.h
+ *
+ * This file declares the instrumentation of the alu.h functions.
+ * Builds with ALU_INSTRUMENT record for each function the number
+ * of calls, the number of inner-loop iterations of the bit-serial
+ * engines of alu_ref.c, the total cycles and a histogram of the
+ * cycles per call, where bucket k counts calls that took from
+ * 2^k to 2^(k+1) - 1 cycles. Cycles are read from the time stamp
+ * counter where the CPU has one, and are nanoseconds otherwise.
+ *
+ * The counters are thread-local, so recording needs no locking.
+ * Each thread adds its counters to the process totals with
+ * instrumentCollect(), and instrumentDump() writes counters as
+ * JSON. Without ALU_INSTRUMENT the recording macros expand to
+ * nothing, and the counters of every thread are zero.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_INSTRUMENT_H_
+#define ALU_INSTRUMENT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** number of buckets of a cycle histogram */
+#define INSTRUMENT_BUCKETS 32
+
+/** instrumented functions of alu.h */
+typedef enum instop {
+    instTestLt,      // testLtWord
+    instTestGe,      // testGeWord
+    instTestEq,      // testEqWord
+    instCmp,         // cmpWord
+    instCmpu,        // cmpuWord
+    instCmpLtu,      // cmpLtuWord
+    instCmpGeu,      // cmpGeuWord
+    instSmin,        // sminWord
+    instSmax,        // smaxWord
+    instUmin,        // uminWord
+    instUmax,        // umaxWord
+    instAsh,         // ashWord
+    instCsh,         // cshWord
+    instLsh,         // lshWord
+    instMask,        // maskWord
+    instAnd,         // andWord
+    instOr,          // orWord
+    instXor,         // xorWord
+    instNot,         // notWord
+    instNegative,    // negativeWord
+    instAdd,         // addWord
+    instSub,         // subWord
+    instAddCarry,    // addCarryWord
+    instSubCarry,    // subCarryWord
+    instMul,         // mulWord
+    instMulWide,     // mulWideWord
+    instDiv2,        // div2Word
+    instDiv,         // divWord
+    instRemainder,   // remainderWord
+    instMulHighu,    // mulHighuWord
+    instDiv2u,       // div2uWord
+    instDivu,        // divuWord
+    instRemainderu,  // remainderuWord
+    instPopcount,    // popcountWord
+    instClz,         // clzWord
+    instCtz,         // ctzWord
+    instBitReverse,  // bitReverseWord
+    instByteSwap,    // byteSwapWord
+    instExtract,     // extractField
+    instDeposit,     // depositField
+    instOps          // number of functions
+} instop;
+
+/** definition of the instrumentation counters */
+typedef struct instcounts {
+    uint64_t calls[instOps];                          // calls of each function
+    uint64_t iterations[instOps];                     // inner-loop iterations
+    uint64_t cycles[instOps];                         // total cycles
+    uint64_t histogram[instOps][INSTRUMENT_BUCKETS];  // calls by log2 of cycles
+} instcounts;
+
+#ifdef ALU_INSTRUMENT
+/** counters of this thread */
+extern _Thread_local instcounts instrumentCounts;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif !defined(__GNUC__) || !defined(__aarch64__)
+#include <time.h>
+#endif
+
+/**
+ * Returns the current cycle count.
+ *
+ * @return the cycles
+ */
+static inline uint64_t instrumentClock(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t t;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * Records a call that started at the specified cycle count.
+ *
+ * @param op the function
+ * @param start the cycle count at the start of the call
+ */
+static inline void instrumentRecord(instop op, uint64_t start) {
+    uint64_t cycles = instrumentClock() - start;
+#if defined(__GNUC__)
+    int bucket = 63 - __builtin_clzll(cycles | 1);
+#else
+    int bucket = 0;
+    while ((cycles >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+#endif
+    if (bucket > INSTRUMENT_BUCKETS - 1) {
+        bucket = INSTRUMENT_BUCKETS - 1;
+    }
+    instrumentCounts.calls[op]++;
+    instrumentCounts.cycles[op] += cycles;
+    instrumentCounts.histogram[op][bucket]++;
+}
+
+/** starts recording a call of op, once in a function */
+#define INSTRUMENT_BEGIN(op) uint64_t instrumentStart = instrumentClock()
+
+/** ends recording a call of op */
+#define INSTRUMENT_END(op) instrumentRecord((op), instrumentStart)
+
+/** counts one inner-loop iteration of op */
+#define INSTRUMENT_LOOP(op) (instrumentCounts.iterations[op]++)
+#else
+#define INSTRUMENT_BEGIN(op) ((void)0)
+#define INSTRUMENT_END(op) ((void)0)
+#define INSTRUMENT_LOOP(op) ((void)0)
+#endif
+
+/**
+ * Returns whether this build records instrumentation.
+ *
+ * @return true if built with ALU_INSTRUMENT
+ */
+bool instrumentEnabled(void);
+
+/**
+ * Returns the name of an instrumented function.
+ *
+ * @param op the function
+ * @return the name, or NULL for an invalid op
+ */
+const char *instrumentName(instop op);
+
+/**
+ * Copies the counters of the calling thread.
+ *
+ * @param counts the counters
+ */
+void instrumentGet(instcounts *counts);
+
+/**
+ * Clears the counters of the calling thread.
+ */
+void instrumentClear(void);
+
+/**
+ * Adds counters to a total.
+ *
+ * @param total the total
+ * @param counts the counters to add
+ */
+void instrumentMerge(instcounts *total, const instcounts *counts);
+
+/**
+ * Adds the counters of the calling thread to the process totals
+ * and clears them. Threads may collect at the same time.
+ */
+void instrumentCollect(void);
+
+/**
+ * Copies the process totals, which hold the counters collected
+ * by instrumentCollect().
+ *
+ * @param total the totals
+ */
+void instrumentTotals(instcounts *total);
+
+/**
+ * Clears the process totals.
+ */
+void instrumentClearTotals(void);
+
+/**
+ * Writes counters as a JSON array with one object for each
+ * function that was called.
+ *
+ * @param out the output file
+ * @param counts the counters
+ */
+void instrumentDump(FILE *out, const instcounts *counts);
+
+#endif /* ALU_INSTRUMENT_H_ */
@@ -0,0 +1,121 @@
+/*
+ * alu_memo.c
+ *
+ * This file implements the caching versions of mulWord() and
+ * div2Word(). The caches are thread-local arrays indexed by a
+ * multiplicative hash of the operand pair; an entry holds the
+ * operands and the results of the last pair that hashed to it.
+ *
+ * @since 2026-10-14
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "alu.h"
+#include "alu_memo.h"
+
+/** definition of a cache entry */
+typedef struct memoentry {
+    uword op1;
+    uword op2;
+    uword result1;    // product, or quotient
+    uword result2;    // remainder
+    bool valid;
+} memoentry;
+
+/** caches and counters of this thread */
+static _Thread_local struct {
+    memoentry mul[MEMO_ENTRIES];
+    memoentry div[MEMO_ENTRIES];
+    memostats stats;
+} memo;
+
+/**
+ * Returns the cache index of an operand pair.
+ *
+ * @param a the first operand
+ * @param b the second operand
+ * @return the index, less than MEMO_ENTRIES
+ */
+static inline unsigned memoIndex(uword a, uword b) {
+    uint64_t h = (uint64_t)a * 0x9E3779B97F4A7C15u ^ (uint64_t)b * 0xC2B2AE3D27D4EB4Fu;
+    return (unsigned)((h ^ h >> 29) >> (64 - MEMO_BITS));
+}
+
+/**
+ * Product of two word operands, as mulWord(), from the cache
+ * of the calling thread when the pair was seen recently.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void memoMulWord(word result, const word op1, const word op2) {
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    memoentry *e = &memo.mul[memoIndex(a, b)];
+    if (e->valid && e->op1 == a && e->op2 == b) {
+        memo.stats.mulHits++;
+        storeWord(result, e->result1);
+        return;
+    }
+
+    memo.stats.mulMisses++;
+    mulWord(result, op1, op2);
+    e->op1 = a;
+    e->op2 = b;
+    e->result1 = loadWord(result);
+    e->valid = true;
+}
+
+/**
+ * Quotient and remainder of two word operands, as div2Word(),
+ * from the cache of the calling thread when the pair was seen
+ * recently.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void memoDiv2Word(word result, word remainder, const word op1, const word op2) {
+    uword a = loadWord(op1);
+    uword b = loadWord(op2);
+    memoentry *e = &memo.div[memoIndex(a, b)];
+    if (e->valid && e->op1 == a && e->op2 == b) {
+        memo.stats.divHits++;
+        storeWord(result, e->result1);
+        storeWord(remainder, e->result2);
+        return;
+    }
+
+    memo.stats.divMisses++;
+    // results may be the same words as the operands
+    word q, r;
+    div2Word(q, r, op1, op2);
+    e->op1 = a;
+    e->op2 = b;
+    e->result1 = loadWord(q);
+    e->result2 = loadWord(r);
+    e->valid = true;
+    setWord(result, q);
+    setWord(remainder, r);
+}
+
+/**
+ * Returns the counters of the caches of the calling thread.
+ *
+ * @param stats the counters
+ */
+void memoStats(memostats *stats) {
+    *stats = memo.stats;
+}
+
+/**
+ * Empties the caches of the calling thread and clears its
+ * counters.
+ */
+void memoClear(void) {
+    memset(&memo, 0, sizeof(memo));
+}
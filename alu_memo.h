@@ -0,0 +1,77 @@
+/*
+ * alu_memo.h
+ *
+ * This file declares caching versions of mulWord() and div2Word()
+ * for operand streams with many repeated pairs, such as constant
+ * divisors and address scaling. Each thread has its own small
+ * direct-mapped cache of MEMO_ENTRIES results for each function,
+ * so no locking is needed, and its own hit and miss counters to
+ * show whether the cache pays off for a workload.
+ *
+ * The cache is opt-in: callers that expect repeated operands call
+ * memoMulWord() and memoDiv2Word() instead of the alu.h functions.
+ * The results are always the same as those of the alu.h functions.
+ * A lookup costs about as much as a native multiply or divide, so
+ * the cache pays off with the bit-serial engines of ALU_REFERENCE
+ * builds rather than with the native engines.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_MEMO_H_
+#define ALU_MEMO_H_
+
+#include <stdint.h>
+#include "word.h"
+
+/** log2 of the number of entries of each cache */
+#ifndef MEMO_BITS
+#define MEMO_BITS 8
+#endif
+
+/** number of entries of each cache */
+#define MEMO_ENTRIES (1 << MEMO_BITS)
+
+/** definition of the counters of the caches of a thread */
+typedef struct memostats {
+    uint64_t mulHits;     // memoMulWord calls found in the cache
+    uint64_t mulMisses;   // memoMulWord calls that called mulWord
+    uint64_t divHits;     // memoDiv2Word calls found in the cache
+    uint64_t divMisses;   // memoDiv2Word calls that called div2Word
+} memostats;
+
+/**
+ * Product of two word operands, as mulWord(), from the cache
+ * of the calling thread when the pair was seen recently.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void memoMulWord(word result, const word op1, const word op2);
+
+/**
+ * Quotient and remainder of two word operands, as div2Word(),
+ * from the cache of the calling thread when the pair was seen
+ * recently.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void memoDiv2Word(word result, word remainder, const word op1, const word op2);
+
+/**
+ * Returns the counters of the caches of the calling thread.
+ *
+ * @param stats the counters
+ */
+void memoStats(memostats *stats);
+
+/**
+ * Empties the caches of the calling thread and clears its
+ * counters.
+ */
+void memoClear(void);
+
+#endif /* ALU_MEMO_H_ */
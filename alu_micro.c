@@ -0,0 +1,427 @@
+/*
+ * alu_micro.c
+ *
+ * This file implements microprograms of arithmetic logic unit
+ * operations. The native engine runs each step over a block of
+ * native registers with the inline engines of alu_native.h;
+ * ALU_REFERENCE builds run each step through the alu.h function
+ * of the same operation.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_micro.h"
+#include "alu_native.h"
+
+/** number of elements that microRunN() runs each step over at once */
+#define MICRO_BLOCK 64
+
+/** kinds of operation, by operands */
+typedef enum microkind {
+    constantKind, unaryKind, binaryKind, shiftKind
+} microkind;
+
+/**
+ * Returns the kind of an operation.
+ *
+ * @param op the operation
+ * @return the kind of op
+ */
+static microkind kindOf(microop op) {
+    if (op == microConst) {
+        return constantKind;
+    } else if (op <= microNegative) {
+        return unaryKind;
+    } else if (op <= microUmax) {
+        return binaryKind;
+    }
+    return shiftKind;
+}
+
+/**
+ * Applies the operation of a step to word operands.
+ *
+ * @param s the step
+ * @param result the result
+ * @param op1 the first operand, or NULL
+ * @param op2 the second operand, or NULL
+ */
+static void applyWord(const microstep *s, word result, const byte *op1, const byte *op2) {
+    switch (s->op) {
+    case microConst:     setWord(result, s->value); break;
+    case microNot:       notWord(result, op1); break;
+    case microNegative:  negativeWord(result, op1); break;
+    case microAnd:       andWord(result, op1, op2); break;
+    case microOr:        orWord(result, op1, op2); break;
+    case microXor:       xorWord(result, op1, op2); break;
+    case microAdd:       addWord(result, op1, op2); break;
+    case microSub:       subWord(result, op1, op2); break;
+    case microMul:       mulWord(result, op1, op2); break;
+    case microDiv:       divWord(result, op1, op2); break;
+    case microRemainder: remainderWord(result, op1, op2); break;
+    case microSmin:      sminWord(result, op1, op2); break;
+    case microSmax:      smaxWord(result, op1, op2); break;
+    case microUmin:      uminWord(result, op1, op2); break;
+    case microUmax:      umaxWord(result, op1, op2); break;
+    case microAsh:       ashWord(result, op1, s->count); break;
+    case microCsh:       cshWord(result, op1, s->count); break;
+    case microLsh:       lshWord(result, op1, s->count); break;
+    case microMask:      maskWord(result, op1, s->count); break;
+    }
+}
+
+/**
+ * Initializes an empty microprogram with the specified number
+ * of inputs, clamped to 0 .. MICRO_INPUTS.
+ *
+ * @param p the microprogram
+ * @param ninputs the number of inputs
+ */
+void microInit(microprogram *p, int ninputs) {
+    if (ninputs < 0) {
+        ninputs = 0;
+    } else if (ninputs > MICRO_INPUTS) {
+        ninputs = MICRO_INPUTS;
+    }
+    p->ninputs = ninputs;
+    p->nsteps = 0;
+    p->result = -1;
+}
+
+/**
+ * Adds a step to a microprogram.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param kind the kind the operation must be
+ * @param src1 the first source register, or -1 for none
+ * @param src2 the second source register, or -1 for none
+ * @param count the shift or mask count
+ * @return the register of the step, or -1
+ */
+static int addStep(microprogram *p, microop op, microkind kind,
+                   int src1, int src2, int count) {
+    int nregs = p->ninputs + p->nsteps;
+    bool needs1 = (kind != constantKind);
+    bool needs2 = (kind == binaryKind);
+    if (p->nsteps == MICRO_STEPS || kindOf(op) != kind
+        || (needs1 && (src1 < 0 || src1 >= nregs))
+        || (needs2 && (src2 < 0 || src2 >= nregs))) {
+        return -1;
+    }
+
+    microstep *s = &p->steps[p->nsteps++];
+    s->op = op;
+    s->src1 = needs1 ? src1 : -1;
+    s->src2 = needs2 ? src2 : -1;
+    s->count = count;
+    setWord(s->value, zeroWord);
+    return nregs;
+}
+
+/**
+ * Adds a step that loads a constant.
+ *
+ * @param p the microprogram
+ * @param value the constant
+ * @return the register of the step, or -1
+ */
+int microConstant(microprogram *p, const word value) {
+    int r = addStep(p, microConst, constantKind, -1, -1, 0);
+    if (r >= 0) {
+        setWord(p->steps[r - p->ninputs].value, value);
+    }
+    return r;
+}
+
+/**
+ * Adds a step for a unary operation: microNot or microNegative.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src the source register
+ * @return the register of the step, or -1
+ */
+int microUnary(microprogram *p, microop op, int src) {
+    return addStep(p, op, unaryKind, src, -1, 0);
+}
+
+/**
+ * Adds a step for a binary operation, from microAnd to microUmax.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src1 the first source register
+ * @param src2 the second source register
+ * @return the register of the step, or -1
+ */
+int microBinary(microprogram *p, microop op, int src1, int src2) {
+    return addStep(p, op, binaryKind, src1, src2, 0);
+}
+
+/**
+ * Adds a step for a shift or mask by a fixed count: microAsh,
+ * microCsh, microLsh or microMask.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src the source register
+ * @param count the shift or mask count
+ * @return the register of the step, or -1
+ */
+int microShift(microprogram *p, microop op, int src, int count) {
+    return addStep(p, op, shiftKind, src, -1, count);
+}
+
+/**
+ * Completes a microprogram with its result in the specified
+ * register, folding constant steps and removing dead steps.
+ *
+ * @param p the microprogram
+ * @param result the result register
+ * @return true if result is a register of the program
+ */
+bool microFuse(microprogram *p, int result) {
+    int n = p->ninputs;
+    if (result < 0 || result >= n + p->nsteps) {
+        return false;
+    }
+
+    // replace steps whose sources are all constants by constants
+    for (int i = 0; i < p->nsteps; i++) {
+        microstep *s = &p->steps[i];
+        const microstep *s1 = (s->src1 >= n) ? &p->steps[s->src1 - n] : NULL;
+        const microstep *s2 = (s->src2 >= n) ? &p->steps[s->src2 - n] : NULL;
+        bool const1 = (s->src1 < 0) || (s1 != NULL && s1->op == microConst);
+        bool const2 = (s->src2 < 0) || (s2 != NULL && s2->op == microConst);
+        if (s->op != microConst && const1 && const2) {
+            applyWord(s, s->value, s1 ? s1->value : NULL, s2 ? s2->value : NULL);
+            s->op = microConst;
+            s->src1 = s->src2 = -1;
+        }
+    }
+
+    // mark the steps that the result depends on
+    bool live[MICRO_STEPS] = {false};
+    if (result >= n) {
+        live[result - n] = true;
+    }
+    for (int i = p->nsteps - 1; i >= 0; i--) {
+        const microstep *s = &p->steps[i];
+        if (live[i]) {
+            if (s->src1 >= n) {
+                live[s->src1 - n] = true;
+            }
+            if (s->src2 >= n) {
+                live[s->src2 - n] = true;
+            }
+        }
+    }
+
+    // compact the live steps, renumbering their registers
+    int renumber[MICRO_REGS];
+    for (int r = 0; r < n; r++) {
+        renumber[r] = r;
+    }
+    int nsteps = 0;
+    for (int i = 0; i < p->nsteps; i++) {
+        if (live[i]) {
+            microstep s = p->steps[i];
+            s.src1 = (s.src1 >= 0) ? renumber[s.src1] : -1;
+            s.src2 = (s.src2 >= 0) ? renumber[s.src2] : -1;
+            renumber[n + i] = n + nsteps;
+            p->steps[nsteps++] = s;
+        }
+    }
+    p->nsteps = nsteps;
+    p->result = renumber[result];
+    return true;
+}
+
+/**
+ * Returns the result register of a microprogram, which is its
+ * last register if it has not been fused.
+ *
+ * @param p the microprogram
+ * @return the result register, or -1 if the program has no registers
+ */
+static int resultOf(const microprogram *p) {
+    return (p->result >= 0) ? p->result : p->ninputs + p->nsteps - 1;
+}
+
+#ifndef ALU_REFERENCE
+/**
+ * Applies the operation of a step to native operands.
+ *
+ * @param s the step
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static inline uword applyNative(const microstep *s, uword a, uword b) {
+    uword r;
+    switch (s->op) {
+    case microConst:     return loadWord(s->value);
+    case microNot:       return ~a;
+    case microNegative:  return 0u - a;
+    case microAnd:       return a & b;
+    case microOr:        return a | b;
+    case microXor:       return a ^ b;
+    case microAdd:       return a + b;
+    case microSub:       return a - b;
+    case microMul:       return nativeMul(a, b);
+    case microDiv:       return nativeDiv2(&r, a, b);
+    case microRemainder: nativeDiv2(&r, a, b); return r;
+    case microSmin:      return nativeSmin(a, b);
+    case microSmax:      return nativeSmax(a, b);
+    case microUmin:      return nativeUmin(a, b);
+    case microUmax:      return nativeUmax(a, b);
+    case microAsh:       return nativeAsh(a, s->count);
+    case microCsh:       return nativeCsh(a, s->count);
+    case microLsh:       return nativeLsh(a, s->count);
+    case microMask:      return nativeMask(a, s->count);
+    }
+    return 0;
+}
+
+/** applies expr to each element i of a block */
+#define blockLoop(expr) \
+    for (size_t i = 0; i < MICRO_BLOCK; i++) { \
+        d[i] = (expr); \
+    }
+
+/**
+ * Runs the steps of a microprogram over a block of elements
+ * whose inputs are loaded into the input registers. Every
+ * block is full length so that the loops have a constant trip
+ * count the compiler can vectorize without runtime checks.
+ *
+ * @param p the microprogram
+ * @param regs the registers
+ */
+static void runBlock(const microprogram *p, uword regs[][MICRO_BLOCK]) {
+    for (int k = 0; k < p->nsteps; k++) {
+        const microstep *s = &p->steps[k];
+
+        // a step never writes the registers it reads
+        uword *restrict d = regs[p->ninputs + k];
+        const uword *restrict a = regs[(s->src1 >= 0) ? s->src1 : 0];
+        const uword *restrict b = regs[(s->src2 >= 0) ? s->src2 : 0];
+        int count = s->count;
+
+        // one dispatch per step; each loop runs over the whole block
+        switch (s->op) {
+        case microConst: {
+            uword v = loadWord(s->value);
+            blockLoop(v);
+            break;
+        }
+        case microNot:       blockLoop(~a[i]); break;
+        case microNegative:  blockLoop(0u - a[i]); break;
+        case microAnd:       blockLoop(a[i] & b[i]); break;
+        case microOr:        blockLoop(a[i] | b[i]); break;
+        case microXor:       blockLoop(a[i] ^ b[i]); break;
+        case microAdd:       blockLoop(a[i] + b[i]); break;
+        case microSub:       blockLoop(a[i] - b[i]); break;
+        case microMul:       blockLoop(nativeMul(a[i], b[i])); break;
+        case microDiv: {
+            uword r;
+            blockLoop(nativeDiv2(&r, a[i], b[i]));
+            break;
+        }
+        case microRemainder:
+            for (size_t i = 0; i < MICRO_BLOCK; i++) {
+                nativeDiv2(&d[i], a[i], b[i]);
+            }
+            break;
+        case microSmin:      blockLoop(nativeSmin(a[i], b[i])); break;
+        case microSmax:      blockLoop(nativeSmax(a[i], b[i])); break;
+        case microUmin:      blockLoop(nativeUmin(a[i], b[i])); break;
+        case microUmax:      blockLoop(nativeUmax(a[i], b[i])); break;
+        case microAsh:       blockLoop(nativeAsh(a[i], count)); break;
+        case microCsh:       blockLoop(nativeCsh(a[i], count)); break;
+        case microLsh:       blockLoop(nativeLsh(a[i], count)); break;
+        case microMask:      blockLoop(nativeMask(a[i], count)); break;
+        }
+    }
+}
+#endif /* ALU_REFERENCE */
+
+/**
+ * Runs a microprogram on one set of inputs.
+ *
+ * @param p the microprogram
+ * @param result the result
+ * @param inputs the array of ninputs input words
+ */
+void microRun(const microprogram *p, word result, const word *inputs) {
+    int r = resultOf(p);
+#ifdef ALU_REFERENCE
+    word regs[MICRO_REGS];
+    for (int k = 0; k < p->ninputs; k++) {
+        setWord(regs[k], inputs[k]);
+    }
+    for (int k = 0; k < p->nsteps; k++) {
+        const microstep *s = &p->steps[k];
+        applyWord(s, regs[p->ninputs + k],
+                  (s->src1 >= 0) ? regs[s->src1] : NULL,
+                  (s->src2 >= 0) ? regs[s->src2] : NULL);
+    }
+    setWord(result, (r >= 0) ? regs[r] : zeroWord);
+#else
+    uword regs[MICRO_REGS];
+    for (int k = 0; k < p->ninputs; k++) {
+        regs[k] = loadWord(inputs[k]);
+    }
+    for (int k = 0; k < p->nsteps; k++) {
+        const microstep *s = &p->steps[k];
+        regs[p->ninputs + k] = applyNative(s, regs[(s->src1 >= 0) ? s->src1 : 0],
+                                           regs[(s->src2 >= 0) ? s->src2 : 0]);
+    }
+    storeWord(result, (r >= 0) ? regs[r] : 0);
+#endif
+}
+
+/**
+ * Runs a microprogram on n sets of inputs.
+ *
+ * @param p the microprogram
+ * @param result the result array
+ * @param inputs the array of ninputs input arrays
+ * @param n the number of elements
+ */
+void microRunN(const microprogram *p, word *result,
+               const word *const *inputs, size_t n) {
+#ifdef ALU_REFERENCE
+    for (size_t i = 0; i < n; i++) {
+        word in[MICRO_INPUTS];
+        for (int k = 0; k < p->ninputs; k++) {
+            setWord(in[k], inputs[k][i]);
+        }
+        microRun(p, result[i], in);
+    }
+#else
+    int r = resultOf(p);
+    if (r < 0) {
+        for (size_t i = 0; i < n; i++) {
+            setWord(result[i], zeroWord);
+        }
+        return;
+    }
+
+    uword regs[MICRO_REGS][MICRO_BLOCK];
+    for (size_t base = 0; base < n; base += MICRO_BLOCK) {
+        size_t m = (n - base < MICRO_BLOCK) ? n - base : MICRO_BLOCK;
+        for (int k = 0; k < p->ninputs; k++) {
+            loadWords(regs[k], inputs[k] + base, m);
+            for (size_t i = m; i < MICRO_BLOCK; i++) {
+                regs[k][i] = 0;  // defined values past the end of the last block
+            }
+        }
+        runBlock(p, regs);
+        storeWords(result + base, regs[r], m);
+    }
+#endif
+}
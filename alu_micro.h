@@ -0,0 +1,171 @@
+/*
+ * alu_micro.h
+ *
+ * This file declares microprograms: short sequences of alu.h
+ * operations over registers that run as one unit, such as the
+ * expression (a + b) << 3 ^ mask. Intermediate results stay in
+ * native registers rather than being stored to words between
+ * operations, and the batch form applies one microprogram to
+ * whole operand arrays, dispatching each step once per block
+ * of elements rather than once per element.
+ *
+ * A microprogram is built one step at a time. Registers 0 to
+ * ninputs - 1 hold the inputs, and each step writes a new
+ * register that later steps may read, so a register is never
+ * overwritten. microFuse() then chooses the result register,
+ * folds steps whose operands are all constants, and drops steps
+ * that do not contribute to the result.
+ *
+ * Each builder function returns the register of its step, or -1
+ * if the program is full, the operation is of the wrong kind, or
+ * a source register is invalid. A source of -1 gives -1, so the
+ * result of a chain of calls need only be checked once.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_MICRO_H_
+#define ALU_MICRO_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "word.h"
+
+/** maximum number of inputs of a microprogram */
+#define MICRO_INPUTS 8
+
+/** maximum number of steps of a microprogram */
+#define MICRO_STEPS 32
+
+/** maximum number of registers of a microprogram */
+#define MICRO_REGS (MICRO_INPUTS + MICRO_STEPS)
+
+/** operations of microprogram steps, with the alu.h function of each */
+typedef enum microop {
+    microConst,       // constant value
+    microNot,         // notWord
+    microNegative,    // negativeWord
+    microAnd,         // andWord
+    microOr,          // orWord
+    microXor,         // xorWord
+    microAdd,         // addWord
+    microSub,         // subWord
+    microMul,         // mulWord
+    microDiv,         // divWord
+    microRemainder,   // remainderWord
+    microSmin,        // sminWord
+    microSmax,        // smaxWord
+    microUmin,        // uminWord
+    microUmax,        // umaxWord
+    microAsh,         // ashWord
+    microCsh,         // cshWord
+    microLsh,         // lshWord
+    microMask         // maskWord
+} microop;
+
+/** definition of a microprogram step */
+typedef struct microstep {
+    microop op;
+    int src1;     // first source register, or -1
+    int src2;     // second source register, or -1
+    int count;    // count of a shift or mask step
+    word value;   // value of a constant step
+} microstep;
+
+/** definition of a microprogram */
+typedef struct microprogram {
+    int ninputs;    // number of input registers
+    int nsteps;     // number of steps
+    int result;     // result register, or -1 until fused
+    microstep steps[MICRO_STEPS];  // step i writes register ninputs + i
+} microprogram;
+
+/**
+ * Initializes an empty microprogram with the specified number
+ * of inputs, clamped to 0 .. MICRO_INPUTS.
+ *
+ * @param p the microprogram
+ * @param ninputs the number of inputs
+ */
+void microInit(microprogram *p, int ninputs);
+
+/**
+ * Adds a step that loads a constant.
+ *
+ * @param p the microprogram
+ * @param value the constant
+ * @return the register of the step, or -1
+ */
+int microConstant(microprogram *p, const word value);
+
+/**
+ * Adds a step for a unary operation: microNot or microNegative.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src the source register
+ * @return the register of the step, or -1
+ */
+int microUnary(microprogram *p, microop op, int src);
+
+/**
+ * Adds a step for a binary operation, from microAnd to microUmax.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src1 the first source register
+ * @param src2 the second source register
+ * @return the register of the step, or -1
+ */
+int microBinary(microprogram *p, microop op, int src1, int src2);
+
+/**
+ * Adds a step for a shift or mask by a fixed count: microAsh,
+ * microCsh, microLsh or microMask.
+ *
+ * @param p the microprogram
+ * @param op the operation
+ * @param src the source register
+ * @param count the shift or mask count
+ * @return the register of the step, or -1
+ */
+int microShift(microprogram *p, microop op, int src, int count);
+
+/**
+ * Completes a microprogram with its result in the specified
+ * register. Steps with only constant operands are replaced by
+ * constants, and steps that do not contribute to the result
+ * are removed, so register numbers returned by the builder
+ * functions are no longer valid.
+ *
+ * @param p the microprogram
+ * @param result the result register
+ * @return true if result is a register of the program
+ */
+bool microFuse(microprogram *p, int result);
+
+/**
+ * Runs a fused microprogram on one set of inputs. A program
+ * that has not been fused gives the value of its last register,
+ * and a program with no registers gives 0.
+ *
+ * @param p the microprogram
+ * @param result the result
+ * @param inputs the array of ninputs input words
+ */
+void microRun(const microprogram *p, word result, const word *inputs);
+
+/**
+ * Runs a fused microprogram on n sets of inputs. Element i of
+ * the result is the result of microRun() for element i of each
+ * input array. The result array may be the same array as
+ * any input array.
+ *
+ * @param p the microprogram
+ * @param result the result array
+ * @param inputs the array of ninputs input arrays
+ * @param n the number of elements
+ */
+void microRunN(const microprogram *p, word *result,
+               const word *const *inputs, size_t n);
+
+#endif /* ALU_MICRO_H_ */
@@ -0,0 +1,678 @@
+/*
+ * alu_mp.c
+ *
+ * This file implements multi-precision arithmetic on arrays
+ * of word limbs. The limb operations use the native engines,
+ * or the alu.h functions in ALU_REFERENCE builds.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_mp.h"
+#include "alu_native.h"
+
+#if ALU_MP_KARATSUBA < 4
+#error "ALU_MP_KARATSUBA must be at least 4"
+#endif
+
+/** native limb with every bit set */
+#define allOnes ((uword)~(uword)0)
+
+/**
+ * Sum of two limbs and a carry in.
+ *
+ * @param a the first limb
+ * @param b the second limb
+ * @param carry the carry in, replaced by the carry out
+ * @return the sum
+ */
+static inline uword limbAdd(uword a, uword b, bit *carry) {
+#ifdef ALU_REFERENCE
+    word wa, wb, wc, r;
+    storeWord(wa, a);
+    storeWord(wb, b);
+    storeWord(wc, *carry);
+    bit carry1, carry2;  // at most one is set
+    addCarryWord(r, &carry1, NULL, wa, wb);
+    addCarryWord(r, &carry2, NULL, r, wc);
+    *carry = carry1 | carry2;
+    return loadWord(r);
+#else
+    uword s = a + b;
+    uword r = s + *carry;
+    *carry = (s < a) | (r < s);
+    return r;
+#endif
+}
+
+/**
+ * Difference of two limbs computed as a + ~b + carry, so a
+ * carry in of 0 is a borrow in.
+ *
+ * @param a the first limb
+ * @param b the second limb
+ * @param carry the carry in, replaced by the carry out (set if no borrow)
+ * @return the difference
+ */
+static inline uword limbSub(uword a, uword b, bit *carry) {
+    return limbAdd(a, (uword)~b, carry);
+}
+
+/**
+ * Unsigned double-limb product of two limbs.
+ *
+ * @param a the first limb
+ * @param b the second limb
+ * @param hi the upper limb of the product
+ * @return the lower limb of the product
+ */
+static inline uword limbMul(uword a, uword b, uword *hi) {
+#ifdef ALU_REFERENCE
+    word wa, wb, h, l;
+    storeWord(wa, a);
+    storeWord(wb, b);
+    mulWideWord(h, l, wa, wb);
+
+    // signed to unsigned upper word: add each operand if the other is negative
+    if (testLtWord(wa)) {
+        addWord(h, h, wb);
+    }
+    if (testLtWord(wb)) {
+        addWord(h, h, wa);
+    }
+    *hi = loadWord(h);
+    return loadWord(l);
+#else
+    uword h = nativeMulHigh(a, b);
+    h += b & (0u - (a >> wordtopbit));
+    h += a & (0u - (b >> wordtopbit));
+    *hi = h;
+    return nativeMul(a, b);
+#endif
+}
+
+/**
+ * Unsigned quotient of a double limb by a limb, which must be
+ * greater than the upper limb so that the quotient fits.
+ *
+ * @param hi the upper limb of the dividend
+ * @param lo the lower limb of the dividend
+ * @param d the divisor
+ * @param r the remainder
+ * @return the quotient
+ */
+static inline uword limbDiv(uword hi, uword lo, uword d, uword *r) {
+#if defined(ALU_HAVE_DWORD) && !defined(ALU_REFERENCE) && !defined(ALU_SOFT_DIVIDE)
+    udword n = ((udword)hi << wordsize) | lo;
+    *r = (uword)(n % d);
+    return (uword)(n / d);
+#else
+    // restoring division a bit at a time; the partial remainder
+    // can exceed a limb by one bit, which is the bit shifted out
+    uword q = 0;
+    for (int b = wordtopbit; b >= 0; b--) {
+        bit out = toBit(hi >> wordtopbit);
+        hi = (uword)(toUnsigned(hi) << 1) | toBit(lo >> b);
+        q = (uword)(toUnsigned(q) << 1);
+        if (out || hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    *r = hi;
+    return q;
+#endif
+}
+
+/**
+ * Set a number of n limbs to a limb value in every limb.
+ *
+ * @param result the result
+ * @param n the number of limbs
+ * @param val the limb value
+ */
+static void fillMp(word *result, size_t n, uword val) {
+    for (size_t i = 0; i < n; i++) {
+        storeWord(result[i], val);
+    }
+}
+
+/**
+ * Two's complement negative of a number of n limbs.
+ *
+ * @param result the result, which may be the operand
+ * @param op the operand
+ * @param n the number of limbs
+ */
+static void negativeMp(word *result, const word *op, size_t n) {
+    bit carry = 1;
+    for (size_t i = 0; i < n; i++) {
+        storeWord(result[i], limbAdd((uword)~loadWord(op[i]), 0, &carry));
+    }
+}
+
+/**
+ * Sum of two numbers of n limbs.
+ *
+ * @param result the result of n limbs
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return the carry out of the top limb
+ */
+bit addMp(word *result, const word *op1, const word *op2, size_t n) {
+    bit carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        storeWord(result[i], limbAdd(loadWord(op1[i]), loadWord(op2[i]), &carry));
+    }
+    return carry;
+}
+
+/**
+ * Difference of two numbers of n limbs.
+ *
+ * @param result the result of n limbs
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return the carry out of the top limb, set if no borrow occurred
+ */
+bit subMp(word *result, const word *op1, const word *op2, size_t n) {
+    bit carry = 1;
+    for (size_t i = 0; i < n; i++) {
+        storeWord(result[i], limbSub(loadWord(op1[i]), loadWord(op2[i]), &carry));
+    }
+    return carry;
+}
+
+/**
+ * Add a number of m limbs into a number of n limbs in place.
+ *
+ * @param acc the number of n limbs to add to
+ * @param n the number of limbs of acc
+ * @param op the operand
+ * @param m the number of limbs of op, at most n
+ * @return the carry out of the top limb of acc
+ */
+bit addInMp(word *acc, size_t n, const word *op, size_t m) {
+    bit carry = addMp(acc, (const word *)acc, op, m);
+
+    // propagate the carry only as far as it goes
+    for (size_t i = m; i < n && carry; i++) {
+        storeWord(acc[i], limbAdd(loadWord(acc[i]), 0, &carry));
+    }
+    return carry;
+}
+
+/**
+ * Subtract a number of m limbs from a number of n limbs in place.
+ *
+ * @param acc the number of n limbs to subtract from
+ * @param n the number of limbs of acc
+ * @param op the operand
+ * @param m the number of limbs of op, at most n
+ * @return the carry out of the top limb of acc, set if no borrow occurred
+ */
+bit subInMp(word *acc, size_t n, const word *op, size_t m) {
+    bit carry = subMp(acc, (const word *)acc, op, m);
+
+    // propagate the borrow only as far as it goes
+    for (size_t i = m; i < n && !carry; i++) {
+        storeWord(acc[i], limbSub(loadWord(acc[i]), 0, &carry));
+    }
+    return carry;
+}
+
+/**
+ * Compare two numbers of n limbs as unsigned numbers.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpMp(const word *op1, const word *op2, size_t n) {
+    for (size_t i = n; i-- > 0;) {
+        uword a = loadWord(op1[i]);
+        uword b = loadWord(op2[i]);
+        if (a != b) {
+            return (a < b) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Logical shift of a number of n limbs by count bits.
+ *
+ * @param result the result of n limbs
+ * @param op the operand
+ * @param n the number of limbs
+ * @param count the shift count
+ */
+void lshMp(word *result, const word *op, size_t n, int count) {
+    size_t c = shiftCount(count);
+    size_t limbs = c / wordsize;
+    unsigned s = c % wordsize;
+    if (limbs >= n) {
+        // all bits are shifted out
+        fillMp(result, n, 0);
+        return;
+    }
+
+    if (count >= 0) {
+        // from the top down, so each limb is read before it is replaced
+        for (size_t i = n; i-- > 0;) {
+            uword val = 0;
+            if (i >= limbs) {
+                val = (uword)(toUnsigned(loadWord(op[i - limbs])) << s);
+                if (s > 0 && i > limbs) {
+                    val |= loadWord(op[i - limbs - 1]) >> (wordsize - s);
+                }
+            }
+            storeWord(result[i], val);
+        }
+    } else {
+        // from the bottom up, so each limb is read before it is replaced
+        for (size_t i = 0; i < n; i++) {
+            uword val = 0;
+            if (i + limbs < n) {
+                val = loadWord(op[i + limbs]) >> s;
+                if (s > 0 && i + limbs + 1 < n) {
+                    val |= (uword)(toUnsigned(loadWord(op[i + limbs + 1])) << (wordsize - s));
+                }
+            }
+            storeWord(result[i], val);
+        }
+    }
+}
+
+/**
+ * Arithmetic shift of a signed number of n limbs by count bits.
+ *
+ * @param result the result of n limbs
+ * @param op the operand
+ * @param n the number of limbs
+ * @param count the shift count
+ */
+void ashMp(word *result, const word *op, size_t n, int count) {
+    if (n == 0) {
+        return;
+    }
+    size_t bits = n * wordsize;
+    size_t c = shiftCount(count);
+    if (c > bits - 1) {
+        c = bits - 1;
+    }
+    uword sign = loadWord(op[n - 1]) & topBit;
+
+    if (count < 0) {
+        lshMp(result, op, n, -(int)c);
+        if (sign) {
+            // fill the top c bits with the sign
+            size_t from = bits - c;
+            for (size_t i = from / wordsize; i < n; i++) {
+                size_t first = i * wordsize;
+                uword fill = (from <= first) ? allOnes
+                           : (uword)(toUnsigned(allOnes) << (from - first));
+                storeWord(result[i], loadWord(result[i]) | fill);
+            }
+        }
+    } else {
+        // shift left keeping the sign bit
+        lshMp(result, op, n, (int)c);
+        uword top = loadWord(result[n - 1]);
+        storeWord(result[n - 1], (top & ~topBit) | sign);
+    }
+}
+
+/**
+ * Schoolbook product of a number of n1 limbs and a number of
+ * n2 limbs.
+ *
+ * @param result the result of n1 + n2 limbs
+ * @param op1 the first operand
+ * @param n1 the number of limbs of op1
+ * @param op2 the second operand
+ * @param n2 the number of limbs of op2
+ */
+static void mulSchoolbook(word *result, const word *op1, size_t n1,
+                          const word *op2, size_t n2) {
+    fillMp(result, n1 + n2, 0);
+    for (size_t j = 0; j < n2; j++) {
+        uword b = loadWord(op2[j]);
+        uword carry = 0;
+        for (size_t i = 0; i < n1; i++) {
+            // (B-1)^2 + 2(B-1) fits in two limbs, so hi never overflows
+            uword hi;
+            uword lo = limbMul(loadWord(op1[i]), b, &hi);
+            bit c = 0;
+            lo = limbAdd(lo, carry, &c);
+            hi += c;
+            c = 0;
+            lo = limbAdd(lo, loadWord(result[i + j]), &c);
+            hi += c;
+            storeWord(result[i + j], lo);
+            carry = hi;
+        }
+        storeWord(result[j + n1], carry);
+    }
+}
+
+/**
+ * Returns the number of scratch limbs for Karatsuba products
+ * of n limbs.
+ *
+ * @param n the number of limbs of each operand
+ * @return the number of scratch limbs
+ */
+static size_t karatsubaScratch(size_t n) {
+    if (n < ALU_MP_KARATSUBA) {
+        return 0;
+    }
+    size_t k = n - n / 2;  // limbs of the upper halves
+    return 4 * (k + 1) + karatsubaScratch(k + 1);
+}
+
+/**
+ * Karatsuba product of two numbers of n limbs. Each operand
+ * is split into halves a1 B^m + a0, and the middle term is
+ * (a0 + a1)(b0 + b1) - a0 b0 - a1 b1, so each level needs
+ * three half-size products instead of four.
+ *
+ * @param result the result of 2n limbs
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs of each operand
+ * @param scratch karatsubaScratch(n) limbs
+ */
+static void mulKaratsuba(word *result, const word *op1, const word *op2,
+                         size_t n, word *scratch) {
+    if (n < ALU_MP_KARATSUBA) {
+        mulSchoolbook(result, op1, n, op2, n);
+        return;
+    }
+    size_t m = n / 2;  // limbs of the lower halves
+    size_t k = n - m;  // limbs of the upper halves
+    word *sum1 = scratch;
+    word *sum2 = sum1 + (k + 1);
+    word *mid = sum2 + (k + 1);
+    word *rest = mid + 2 * (k + 1);
+
+    // a0 b0 in the lower 2m limbs and a1 b1 in the upper 2k limbs
+    mulKaratsuba(result, op1, op2, m, rest);
+    mulKaratsuba(result + 2 * m, op1 + m, op2 + m, k, rest);
+
+    // (a0 + a1)(b0 + b1), with a limb for the carry of each sum
+    for (size_t i = 0; i < k; i++) {
+        setWord(sum1[i], op1[m + i]);
+        setWord(sum2[i], op2[m + i]);
+    }
+    storeWord(sum1[k], addInMp(sum1, k, op1, m));
+    storeWord(sum2[k], addInMp(sum2, k, op2, m));
+    mulKaratsuba(mid, (const word *)sum1, (const word *)sum2, k + 1, rest);
+
+    // middle term a0 b1 + a1 b0 is added at limb m
+    subInMp(mid, 2 * (k + 1), (const word *)result, 2 * m);
+    subInMp(mid, 2 * (k + 1), (const word *)(result + 2 * m), 2 * k);
+    addInMp(result + m, 2 * n - m, (const word *)mid, 2 * (k + 1));
+}
+
+/**
+ * Returns the number of scratch limbs mulMp() needs.
+ *
+ * @param n1 the number of limbs of the first operand
+ * @param n2 the number of limbs of the second operand
+ * @return the number of scratch limbs
+ */
+size_t mulMpScratch(size_t n1, size_t n2) {
+    size_t shorter = (n1 < n2) ? n1 : n2;
+    if (shorter < ALU_MP_KARATSUBA) {
+        return 0;
+    }
+    if (n1 == n2) {
+        return karatsubaScratch(n1);
+    }
+    // a product of each chunk of the longer operand
+    return 2 * shorter + karatsubaScratch(shorter);
+}
+
+/**
+ * Full product of a number of n1 limbs and a number of n2 limbs.
+ *
+ * @param result the result of n1 + n2 limbs
+ * @param op1 the first operand
+ * @param n1 the number of limbs of op1
+ * @param op2 the second operand
+ * @param n2 the number of limbs of op2
+ * @param scratch mulMpScratch(n1, n2) limbs, or NULL if that is 0
+ */
+void mulMp(word *result, const word *op1, size_t n1,
+           const word *op2, size_t n2, word *scratch) {
+    const word *longer = (n1 >= n2) ? op1 : op2;
+    const word *shorter = (n1 >= n2) ? op2 : op1;
+    size_t nlong = (n1 >= n2) ? n1 : n2;
+    size_t nshort = (n1 >= n2) ? n2 : n1;
+
+    if (nshort < ALU_MP_KARATSUBA) {
+        mulSchoolbook(result, longer, nlong, shorter, nshort);
+        return;
+    }
+    if (nlong == nshort) {
+        mulKaratsuba(result, longer, shorter, nshort, scratch);
+        return;
+    }
+
+    // multiply the shorter operand by each chunk of as many limbs of the longer one
+    word *chunk = scratch;
+    word *rest = scratch + 2 * nshort;
+    fillMp(result, nlong + nshort, 0);
+    for (size_t off = 0; off < nlong; off += nshort) {
+        size_t c = nlong - off;
+        if (c >= nshort) {
+            c = nshort;
+            mulKaratsuba(chunk, longer + off, shorter, nshort, rest);
+        } else {
+            mulSchoolbook(chunk, longer + off, c, shorter, nshort);
+        }
+        addInMp(result + off, nlong + nshort - off, (const word *)chunk, c + nshort);
+    }
+}
+
+/**
+ * Returns the number of scratch limbs divuMp() needs.
+ *
+ * @param n1 the number of limbs of the dividend
+ * @param n2 the number of limbs of the divisor
+ * @return the number of scratch limbs
+ */
+size_t divuMpScratch(size_t n1, size_t n2) {
+    return n1 + n2 + 1;
+}
+
+/**
+ * Unsigned quotient and remainder of a number of n1 limbs by
+ * a number of n2 limbs. This is Knuth's algorithm D: the
+ * divisor is normalized so its top bit is set, then each
+ * quotient limb is estimated from the top limbs, corrected,
+ * and the product subtracted from the running remainder.
+ *
+ * @param quotient the quotient of n1 limbs
+ * @param remainder the remainder of n2 limbs
+ * @param op1 the dividend
+ * @param n1 the number of limbs of op1
+ * @param op2 the divisor
+ * @param n2 the number of limbs of op2
+ * @param scratch divuMpScratch(n1, n2) limbs
+ */
+void divuMp(word *quotient, word *remainder, const word *op1, size_t n1,
+            const word *op2, size_t n2, word *scratch) {
+    // significant limbs of the divisor
+    size_t n = n2;
+    while (n > 0 && loadWord(op2[n - 1]) == 0) {
+        n--;
+    }
+    fillMp(remainder, n2, 0);
+    if (n == 0) {
+        // handle divide by 0 by returning the largest number
+        fillMp(quotient, n1, allOnes);
+        return;
+    }
+    if (n1 < n) {
+        // divisor is larger than the dividend
+        fillMp(quotient, n1, 0);
+        for (size_t i = 0; i < n1; i++) {
+            setWord(remainder[i], op1[i]);
+        }
+        return;
+    }
+    if (n == 1) {
+        // short division by a single limb
+        uword d = loadWord(op2[0]);
+        uword r = 0;
+        for (size_t i = n1; i-- > 0;) {
+            storeWord(quotient[i], limbDiv(r, loadWord(op1[i]), d, &r));
+        }
+        storeWord(remainder[0], r);
+        return;
+    }
+
+    // normalize so that the top bit of the divisor is set
+    unsigned s = leadingZeros(loadWord(op2[n - 1]));
+    word *vn = scratch;      // n limbs
+    word *un = scratch + n;  // n1 + 1 limbs
+    lshMp(vn, op2, n, (int)s);
+    for (size_t i = 0; i < n1; i++) {
+        setWord(un[i], op1[i]);
+    }
+    storeWord(un[n1], 0);
+    lshMp(un, (const word *)un, n1 + 1, (int)s);
+
+    uword v1 = loadWord(vn[n - 1]);
+    uword v0 = loadWord(vn[n - 2]);
+    fillMp(quotient, n1, 0);
+    for (size_t j = n1 - n + 1; j-- > 0;) {
+        // estimate the quotient limb from the top two limbs
+        uword u2 = loadWord(un[j + n]);
+        uword u1 = loadWord(un[j + n - 1]);
+        uword u0 = loadWord(un[j + n - 2]);
+        uword qhat, rhat;
+        bit rover = 0;  // rhat no longer fits in a limb
+        if (u2 >= v1) {
+            qhat = allOnes;
+            rhat = limbAdd(u1, v1, &rover);  // u2 B + u1 - qhat v1
+        } else {
+            qhat = limbDiv(u2, u1, v1, &rhat);
+        }
+
+        // correct the estimate, which is at most two too large
+        while (!rover) {
+            uword phi;
+            uword plo = limbMul(qhat, v0, &phi);
+            if (phi < rhat || (phi == rhat && plo <= u0)) {
+                break;
+            }
+            qhat--;
+            rhat = limbAdd(rhat, v1, &rover);
+        }
+
+        // subtract qhat times the divisor from the remainder
+        uword mulcarry = 0;
+        bit carry = 1;  // no borrow
+        for (size_t i = 0; i < n; i++) {
+            uword phi;
+            uword plo = limbMul(qhat, loadWord(vn[i]), &phi);
+            bit c = 0;
+            plo = limbAdd(plo, mulcarry, &c);
+            phi += c;
+            storeWord(un[i + j], limbSub(loadWord(un[i + j]), plo, &carry));
+            mulcarry = phi;
+        }
+        storeWord(un[j + n], limbSub(loadWord(un[j + n]), mulcarry, &carry));
+
+        if (!carry) {
+            // estimate was one too large: add the divisor back, dropping the carry
+            qhat--;
+            addInMp(un + j, n + 1, (const word *)vn, n);
+        }
+        storeWord(quotient[j], qhat);
+    }
+
+    // remainder is the low limbs, unnormalized
+    lshMp(un, (const word *)un, n, -(int)s);
+    for (size_t i = 0; i < n; i++) {
+        setWord(remainder[i], un[i]);
+    }
+}
+
+/**
+ * Returns the number of scratch limbs div2Mp() needs.
+ *
+ * @param n the number of limbs
+ * @return the number of scratch limbs
+ */
+size_t div2MpScratch(size_t n) {
+    return 2 * n + divuMpScratch(n, n);
+}
+
+/**
+ * Signed quotient and remainder of two numbers of n limbs.
+ *
+ * @param quotient the quotient of n limbs
+ * @param remainder the remainder of n limbs
+ * @param op1 the dividend
+ * @param op2 the divisor
+ * @param n the number of limbs
+ * @param scratch div2MpScratch(n) limbs
+ */
+void div2Mp(word *quotient, word *remainder, const word *op1,
+            const word *op2, size_t n, word *scratch) {
+    if (n == 0) {
+        return;
+    }
+    bool negative1 = (loadWord(op1[n - 1]) & topBit) != 0;
+    bool negative2 = (loadWord(op2[n - 1]) & topBit) != 0;
+
+    bool zero = true;
+    for (size_t i = 0; i < n && zero; i++) {
+        zero = (loadWord(op2[i]) == 0);
+    }
+    if (zero) {
+        // handle divide by 0 by returning largest
+        // positive or negative number
+        fillMp(quotient, n - 1, negative1 ? 0 : allOnes);
+        setWord(quotient[n - 1], negative1 ? minWord : maxWord);
+        fillMp(remainder, n, 0);
+        return;
+    }
+
+    // divide magnitudes; the most negative number is its own magnitude
+    word *magnitude1 = scratch;
+    word *magnitude2 = scratch + n;
+    if (negative1) {
+        negativeMp(magnitude1, op1, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            setWord(magnitude1[i], op1[i]);
+        }
+    }
+    if (negative2) {
+        negativeMp(magnitude2, op2, n);
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            setWord(magnitude2[i], op2[i]);
+        }
+    }
+    divuMp(quotient, remainder, (const word *)magnitude1, n,
+           (const word *)magnitude2, n, scratch + 2 * n);
+
+    // sign of quotient from operands, sign of remainder from dividend
+    if (negative1 != negative2) {
+        negativeMp(quotient, (const word *)quotient, n);
+    }
+    if (negative1) {
+        negativeMp(remainder, (const word *)remainder, n);
+    }
+}
@@ -0,0 +1,198 @@
+/*
+ * alu_mp.h
+ *
+ * This file declares multi-precision arithmetic on numbers
+ * made of arrays of word limbs, for use as the limb layer of
+ * arbitrary-precision arithmetic.
+ *
+ * A number of n limbs is an array of n words with the least
+ * significant limb first; each limb is a word in wordendian
+ * byte order. Functions are unsigned unless noted. The signed
+ * functions treat numbers as two's complement of n * wordsize
+ * bits, and give the same results as the alu.h functions of
+ * the same name when n is 1.
+ *
+ * No function allocates. Functions that need temporary limbs
+ * take a caller-provided scratch array whose size is returned
+ * by the matching ...Scratch() function.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_MP_H_
+#define ALU_MP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "word.h"
+
+/** number of limbs from which mulMp() uses Karatsuba multiplication */
+#ifndef ALU_MP_KARATSUBA
+#define ALU_MP_KARATSUBA 24
+#endif
+
+/**
+ * Sum of two numbers of n limbs. The result may be the same
+ * array as either operand for an in-place sum.
+ *
+ * @param result the result of n limbs
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return the carry out of the top limb
+ */
+bit addMp(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Difference of two numbers of n limbs. The result may be
+ * the same array as either operand for an in-place difference.
+ *
+ * @param result the result of n limbs
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return the carry out of the top limb, set if no borrow occurred
+ */
+bit subMp(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Add a number of m limbs into a number of n limbs in place,
+ * propagating the carry through the upper n - m limbs.
+ *
+ * @param acc the number of n limbs to add to
+ * @param n the number of limbs of acc
+ * @param op the operand
+ * @param m the number of limbs of op, at most n
+ * @return the carry out of the top limb of acc
+ */
+bit addInMp(word *acc, size_t n, const word *op, size_t m);
+
+/**
+ * Subtract a number of m limbs from a number of n limbs in
+ * place, propagating the borrow through the upper n - m limbs.
+ *
+ * @param acc the number of n limbs to subtract from
+ * @param n the number of limbs of acc
+ * @param op the operand
+ * @param m the number of limbs of op, at most n
+ * @return the carry out of the top limb of acc, set if no borrow occurred
+ */
+bit subInMp(word *acc, size_t n, const word *op, size_t m);
+
+/**
+ * Compare two numbers of n limbs as unsigned numbers.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param n the number of limbs
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpMp(const word *op1, const word *op2, size_t n);
+
+/**
+ * Logical shift of a number of n limbs by count bits, left
+ * for positive and right for negative counts. The result may
+ * be the same array as the operand.
+ *
+ * @param result the result of n limbs
+ * @param op the operand
+ * @param n the number of limbs
+ * @param count the shift count
+ */
+void lshMp(word *result, const word *op, size_t n, int count);
+
+/**
+ * Arithmetic shift of a signed number of n limbs by count
+ * bits, left for positive and right for negative counts,
+ * with the semantics of ashWord(): the sign bit is kept and
+ * counts are clamped to n * wordsize - 1. The result may be
+ * the same array as the operand.
+ *
+ * @param result the result of n limbs
+ * @param op the operand
+ * @param n the number of limbs
+ * @param count the shift count
+ */
+void ashMp(word *result, const word *op, size_t n, int count);
+
+/**
+ * Returns the number of scratch limbs mulMp() needs for
+ * operands of n1 and n2 limbs. It is 0 when the product is
+ * computed by schoolbook multiplication.
+ *
+ * @param n1 the number of limbs of the first operand
+ * @param n2 the number of limbs of the second operand
+ * @return the number of scratch limbs
+ */
+size_t mulMpScratch(size_t n1, size_t n2);
+
+/**
+ * Full product of a number of n1 limbs and a number of n2
+ * limbs. Operands of at least ALU_MP_KARATSUBA limbs are
+ * multiplied by Karatsuba's method, others by schoolbook
+ * multiplication. The result must not overlap the operands.
+ *
+ * @param result the result of n1 + n2 limbs
+ * @param op1 the first operand
+ * @param n1 the number of limbs of op1
+ * @param op2 the second operand
+ * @param n2 the number of limbs of op2
+ * @param scratch mulMpScratch(n1, n2) limbs, or NULL if that is 0
+ */
+void mulMp(word *result, const word *op1, size_t n1,
+           const word *op2, size_t n2, word *scratch);
+
+/**
+ * Returns the number of scratch limbs divuMp() needs for
+ * operands of n1 and n2 limbs.
+ *
+ * @param n1 the number of limbs of the dividend
+ * @param n2 the number of limbs of the divisor
+ * @return the number of scratch limbs
+ */
+size_t divuMpScratch(size_t n1, size_t n2);
+
+/**
+ * Unsigned quotient and remainder of a number of n1 limbs by
+ * a number of n2 limbs, by long division. Divide by 0 returns
+ * a quotient with every bit set and a remainder of 0. The
+ * results must not overlap the operands or each other.
+ *
+ * @param quotient the quotient of n1 limbs
+ * @param remainder the remainder of n2 limbs
+ * @param op1 the dividend
+ * @param n1 the number of limbs of op1
+ * @param op2 the divisor
+ * @param n2 the number of limbs of op2
+ * @param scratch divuMpScratch(n1, n2) limbs
+ */
+void divuMp(word *quotient, word *remainder, const word *op1, size_t n1,
+            const word *op2, size_t n2, word *scratch);
+
+/**
+ * Returns the number of scratch limbs div2Mp() needs for
+ * operands of n limbs.
+ *
+ * @param n the number of limbs
+ * @return the number of scratch limbs
+ */
+size_t div2MpScratch(size_t n);
+
+/**
+ * Signed quotient and remainder of two numbers of n limbs
+ * with the conventions of div2Word(): the quotient is
+ * truncated, the sign of the remainder matches the dividend,
+ * and divide by 0 returns the largest positive or negative
+ * number with the sign of the dividend and a remainder of 0.
+ * The results must not overlap the operands or each other.
+ *
+ * @param quotient the quotient of n limbs
+ * @param remainder the remainder of n limbs
+ * @param op1 the dividend
+ * @param op2 the divisor
+ * @param n the number of limbs
+ * @param scratch div2MpScratch(n) limbs
+ */
+void div2Mp(word *quotient, word *remainder, const word *op1,
+            const word *op2, size_t n, word *scratch);
+
+#endif /* ALU_MP_H_ */
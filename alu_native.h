@@ -0,0 +1,773 @@
+/*
+ * alu_native.h
+ *
+ * This file implements the native integer engines behind the
+ * arithmetic logic unit functions. Each function operates on
+ * a word loaded with loadWord() and has the semantics of the
+ * alu.h function of the same name.
+ *
+ * The functions are inline so that alu.c and the batch entry
+ * points in alu_batch.c share one definition that the compiler
+ * can fold into their loops.
+ *
+ * Builds with ALU_CONSTANT_TIME run every engine in a number of
+ * steps that does not depend on its operands or counts, for
+ * callers that compute on secrets or need a latency bound.
+ * Selects use masks instead of branches, the divider takes
+ * wordsize steps for every dividend and divisor, and bit counts
+ * and fields use fixed sequences of shifts and adds instead of
+ * table lookups, library calls and loops over the set bits. The
+ * bit-serial reference engines are not constant time, so such
+ * builds cannot also define ALU_REFERENCE.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_NATIVE_H_
+#define ALU_NATIVE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "word.h"
+
+#if defined(ALU_CONSTANT_TIME) && defined(ALU_REFERENCE)
+#error "ALU_CONSTANT_TIME needs the native engines and cannot be used with ALU_REFERENCE"
+#endif
+
+/**
+ * Whether the BMI2 parallel bit extract and deposit instructions
+ * are available to this build, as with -mbmi2 or -march=native on
+ * a CPU that has them. Some CPUs microcode them with a latency
+ * that depends on the mask, so constant-time builds do not.
+ */
+#if defined(__BMI2__) && !defined(ALU_CONSTANT_TIME) && (WORDSIZE <= 32 || defined(__x86_64__))
+#include <immintrin.h>
+#define ALU_HAVE_PEXT 1
+#endif
+
+/** whether the compiler has a bit-reverse builtin, as clang does */
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bitreverse64)
+#define ALU_HAVE_BITREVERSE 1
+#endif
+#endif
+
+/** native mask of the sign bit of a word */
+#define topBit ((uword)1 << wordtopbit)
+
+/**
+ * Native word promoted to an unsigned type of at least
+ * unsigned int, so that shifts and products of narrow
+ * words wrap instead of overflowing int.
+ */
+#define toUnsigned(x) ((x) + 0u)
+
+#if WORDSIZE <= 16
+/** native unsigned integer holding the bits of two words */
+typedef uint32_t udword;
+/** native signed integer holding the bits of two words */
+typedef int32_t sdword;
+#define ALU_HAVE_DWORD 1
+#elif WORDSIZE == 32
+typedef uint64_t udword;
+typedef int64_t sdword;
+#define ALU_HAVE_DWORD 1
+#elif defined(__SIZEOF_INT128__)
+typedef unsigned __int128 udword;
+typedef __int128 sdword;
+#define ALU_HAVE_DWORD 1
+#endif
+
+/**
+ * Native mask of the lower c bits of a word, for
+ * 0 <= c <= WORDSIZE, as a constant expression.
+ */
+#define lowerMaskOf(c) ((uword)(((uword)1 << ((c) % WORDSIZE)) - 1) \
+                        | (uword)((c) == WORDSIZE ? ~(uword)0 : 0))
+
+/** native mask of the upper c bits of a word, for 0 <= c <= WORDSIZE */
+#define upperMaskOf(c) ((uword)~lowerMaskOf(WORDSIZE - (c)))
+
+/** table entries m(b) .. m(b + 15) */
+#define maskEntries16(m, b) \
+    m((b) + 0), m((b) + 1), m((b) + 2), m((b) + 3), \
+    m((b) + 4), m((b) + 5), m((b) + 6), m((b) + 7), \
+    m((b) + 8), m((b) + 9), m((b) + 10), m((b) + 11), \
+    m((b) + 12), m((b) + 13), m((b) + 14), m((b) + 15)
+
+/** table entries m(0) .. m(WORDSIZE) */
+#if WORDSIZE == 8
+#define maskEntries(m) m(0), m(1), m(2), m(3), m(4), m(5), m(6), m(7), m(8)
+#elif WORDSIZE == 16
+#define maskEntries(m) maskEntries16(m, 0), m(16)
+#elif WORDSIZE == 32
+#define maskEntries(m) maskEntries16(m, 0), maskEntries16(m, 16), m(32)
+#else
+#define maskEntries(m) maskEntries16(m, 0), maskEntries16(m, 16), \
+                       maskEntries16(m, 32), maskEntries16(m, 48), m(64)
+#endif
+
+/** masks of the lower c bits of a word, for counts c from 0 to wordsize */
+static const uword lowerMasks[WORDSIZE + 1] = { maskEntries(lowerMaskOf) };
+
+/** masks of the upper c bits of a word, for counts c from 0 to wordsize */
+static const uword upperMasks[WORDSIZE + 1] = { maskEntries(upperMaskOf) };
+
+/**
+ * Native mask of every bit if b is true, or of no bits. In
+ * constant-time builds the mask is hidden from the optimizer so
+ * that selects made with it are not turned back into branches.
+ *
+ * @param b the condition
+ * @return all ones if b is true, otherwise 0
+ */
+static inline uword selectMask(bool b) {
+    uword m = (uword)(0u - (uword)b);
+#if defined(ALU_CONSTANT_TIME) && defined(__GNUC__)
+    __asm__("" : "+r"(m));
+#endif
+    return m;
+}
+
+/**
+ * Native select of a or b by a mask from selectMask().
+ *
+ * @param mask all ones to select a, or 0 to select b
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return a if mask is all ones, otherwise b
+ */
+static inline uword nativeSelect(uword mask, uword a, uword b) {
+    return (uword)((a & mask) | (b & ~mask));
+}
+
+/**
+ * Native mask of the lower c bits of a word.
+ *
+ * @param c the number of bits, from 0 to wordsize
+ * @return the mask
+ */
+static inline uword lowerMask(unsigned c) {
+#ifdef ALU_CONSTANT_TIME
+    // computed rather than looked up, so no cache line depends on c
+    uword low = (uword)((toUnsigned((uword)1) << (c & (wordsize - 1))) - 1);
+    return low | selectMask(c == (unsigned)wordsize);
+#else
+    return lowerMasks[c];
+#endif
+}
+
+/**
+ * Native mask of the upper c bits of a word.
+ *
+ * @param c the number of bits, from 0 to wordsize
+ * @return the mask
+ */
+static inline uword upperMask(unsigned c) {
+#ifdef ALU_CONSTANT_TIME
+    return (uword)~lowerMask(wordsize - c);
+#else
+    return upperMasks[c];
+#endif
+}
+
+/**
+ * Native unsigned comparison.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return -1, 0 or 1 if a is less than, equal to or greater than b
+ */
+static inline int nativeCmpu(uword a, uword b) {
+    return (a > b) - (a < b);
+}
+
+/**
+ * Native signed comparison. Flipping the sign bits maps the
+ * signed order onto the unsigned order.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return -1, 0 or 1 if a is less than, equal to or greater than b
+ */
+static inline int nativeCmp(uword a, uword b) {
+    return nativeCmpu(a ^ topBit, b ^ topBit);
+}
+
+/**
+ * Native signed minimum.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the lesser of a and b
+ */
+static inline uword nativeSmin(uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    return nativeSelect(selectMask((uword)(b ^ topBit) < (uword)(a ^ topBit)), b, a);
+#else
+    return (nativeCmp(a, b) <= 0) ? a : b;
+#endif
+}
+
+/**
+ * Native signed maximum.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the greater of a and b
+ */
+static inline uword nativeSmax(uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    return nativeSelect(selectMask((uword)(a ^ topBit) < (uword)(b ^ topBit)), b, a);
+#else
+    return (nativeCmp(a, b) >= 0) ? a : b;
+#endif
+}
+
+/**
+ * Native unsigned minimum.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the lesser of a and b
+ */
+static inline uword nativeUmin(uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    return nativeSelect(selectMask(b < a), b, a);
+#else
+    return (a <= b) ? a : b;
+#endif
+}
+
+/**
+ * Native unsigned maximum.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the greater of a and b
+ */
+static inline uword nativeUmax(uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    return nativeSelect(selectMask(a < b), b, a);
+#else
+    return (a >= b) ? a : b;
+#endif
+}
+
+/**
+ * Magnitude of a shift or mask count, computed without
+ * overflow for the most negative count.
+ *
+ * @param count the count
+ * @return the magnitude of count
+ */
+static inline unsigned shiftCount(int count) {
+#ifdef ALU_CONSTANT_TIME
+    // conditional negate by the all-ones mask of a negative count
+    unsigned s = 0u - (unsigned)(count < 0);
+    return ((unsigned)count ^ s) - s;
+#else
+    return (count < 0) ? 0u - (unsigned)count : (unsigned)count;
+#endif
+}
+
+/**
+ * Count magnitude limited to a largest count.
+ *
+ * @param c the count magnitude
+ * @param limit the largest count
+ * @return the lesser of c and limit
+ */
+static inline unsigned clampCount(unsigned c, unsigned limit) {
+#ifdef ALU_CONSTANT_TIME
+    unsigned over = 0u - (unsigned)(c > limit);
+    return (c & ~over) | (limit & over);
+#else
+    return (c > limit) ? limit : c;
+#endif
+}
+
+/**
+ * Native arithmetic shift by count. The sign bit is kept,
+ * and counts beyond wordtopbit are clamped.
+ *
+ * @param x the native operand
+ * @param count the shift count
+ * @return the native result
+ */
+static inline uword nativeAsh(uword x, int count) {
+    unsigned c = clampCount(shiftCount(count), wordtopbit);
+
+#ifdef ALU_CONSTANT_TIME
+    // both directions, then select by the sign of the count
+    uword fill = (uword)(0u - (x >> wordtopbit));
+    uword right = (uword)((x >> c) | (upperMask(c) & fill));
+    uword left = (uword)(((toUnsigned(x) << c) & ~topBit) | (x & topBit));
+    return nativeSelect(selectMask(count < 0), right, left);
+#else
+    if (count < 0) {
+        // shift right, filling the upper c bits from the sign
+        uword fill = 0u - (x >> wordtopbit);
+        return (x >> c) | (upperMasks[c] & fill);
+    }
+    // shift left keeping the sign bit
+    return ((toUnsigned(x) << c) & ~topBit) | (x & topBit);
+#endif
+}
+
+/**
+ * Native circular shift by count modulo wordsize.
+ *
+ * @param x the native operand
+ * @param count the shift count
+ * @return the native result
+ */
+static inline uword nativeCsh(uword x, int count) {
+    unsigned c = (unsigned)count & (wordsize - 1);  // count mod wordsize
+
+    // single rotate instruction; right rotates are left rotates by wordsize - c
+    return (toUnsigned(x) << c) | (x >> ((wordsize - c) & (wordsize - 1)));
+}
+
+/**
+ * Native logical shift by count. Counts of wordsize or more
+ * shift out every bit.
+ *
+ * @param x the native operand
+ * @param count the shift count
+ * @return the native result
+ */
+static inline uword nativeLsh(uword x, int count) {
+    unsigned c = shiftCount(count);
+
+    // all bits are shifted out for counts of wordsize or more
+    uword keep = 0u - (uword)(c < (unsigned)wordsize);
+    unsigned s = c & (wordsize - 1);
+#ifdef ALU_CONSTANT_TIME
+    uword r = nativeSelect(selectMask(count < 0), (uword)(x >> s), (uword)(toUnsigned(x) << s));
+#else
+    uword r = (count < 0) ? (uword)(x >> s) : (uword)(toUnsigned(x) << s);
+#endif
+    return r & keep;
+}
+
+/**
+ * Native mask keeping the lower (+) or upper (-) count bits
+ * of a word. Counts beyond wordsize keep every bit.
+ *
+ * @param x the native operand
+ * @param count the mask count
+ * @return the native result
+ */
+static inline uword nativeMask(uword x, int count) {
+    unsigned c = clampCount(shiftCount(count), wordsize);
+#ifdef ALU_CONSTANT_TIME
+    return x & nativeSelect(selectMask(count < 0), upperMask(c), lowerMask(c));
+#else
+    return x & ((count < 0) ? upperMasks[c] : lowerMasks[c]);
+#endif
+}
+
+/**
+ * Lower word of the product, which is the same for signed
+ * and unsigned operands.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the lower word of a * b
+ */
+static inline uword nativeMul(uword a, uword b) {
+    return toUnsigned(a) * b;
+}
+
+/**
+ * Upper word of the unsigned double-word product.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the upper word of a * b as unsigned words
+ */
+static inline uword nativeMulHighu(uword a, uword b) {
+#ifdef ALU_HAVE_DWORD
+    return (uword)(((udword)a * b) >> wordsize);
+#else
+    // unsigned product from half-word partial products
+    const int half = wordsize / 2;
+    const uword low = ((uword)1 << half) - 1;
+    uword ll = (a & low) * (b & low);
+    uword lh = (a & low) * (b >> half);
+    uword hl = (a >> half) * (b & low);
+    uword hh = (a >> half) * (b >> half);
+    uword mid = (ll >> half) + (lh & low) + (hl & low);
+    return hh + (lh >> half) + (hl >> half) + (mid >> half);
+#endif
+}
+
+/**
+ * Upper word of the signed double-word product.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the upper word of a * b
+ */
+static inline uword nativeMulHigh(uword a, uword b) {
+    uword h = nativeMulHighu(a, b);
+
+    // correct the upper word for negative operands
+    h -= b & (0u - (a >> wordtopbit));
+    h -= a & (0u - (b >> wordtopbit));
+    return h;
+}
+
+/**
+ * Number of set bits of a native word. Without a popcount
+ * instruction the builtin is a library call that may use a
+ * table, so constant-time builds then add the bits in place.
+ *
+ * @param x the native word
+ * @return the number of set bits
+ */
+static inline unsigned populationCount(uword x) {
+#if defined(__GNUC__) && (!defined(ALU_CONSTANT_TIME) || defined(__POPCNT__))
+    return (unsigned)__builtin_popcountll(x);
+#else
+    // sums of bit pairs, nibbles and bytes, then add the bytes
+    uint64_t v = x;
+    v = v - ((v >> 1) & 0x5555555555555555u);
+    v = (v & 0x3333333333333333u) + ((v >> 2) & 0x3333333333333333u);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+    return (unsigned)((v * 0x0101010101010101u) >> 56);
+#endif
+}
+
+/**
+ * Number of leading zero bits in a native word.
+ *
+ * @param x the native word
+ * @return the number of zero bits above the top set bit
+ */
+static inline unsigned leadingZeros(uword x) {
+#if defined(ALU_CONSTANT_TIME)
+    // copy the top set bit into every bit below it, then count
+    for (unsigned s = 1; s < (unsigned)wordsize; s <<= 1) {
+        x |= (uword)(x >> s);
+    }
+    return (unsigned)wordsize - populationCount(x);
+#elif defined(__GNUC__)
+    // count in a 64-bit integer, less the bits above the word
+    return (x == 0) ? (unsigned)wordsize
+                    : (unsigned)__builtin_clzll(x) - (64 - wordsize);
+#else
+    unsigned n = 0;
+    for (unsigned s = wordsize / 2; s > 0; s >>= 1) {
+        if ((x >> (wordsize - s)) == 0) {  // top s bits clear
+            n += s;
+            x <<= s;
+        }
+    }
+    return (x == 0) ? (unsigned)wordsize : n;
+#endif
+}
+
+/**
+ * Number of trailing zero bits of a native word.
+ *
+ * @param x the native word
+ * @return the number of zero bits below the bottom set bit
+ */
+static inline unsigned trailingZeros(uword x) {
+#if defined(ALU_CONSTANT_TIME)
+    // the bits below the bottom set bit, or every bit of 0
+    return populationCount((uword)(~x & (uword)(x - 1)));
+#elif defined(__GNUC__)
+    return (x == 0) ? (unsigned)wordsize : (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    for (unsigned s = wordsize / 2; s > 0; s >>= 1) {
+        if ((uword)(x << (wordsize - s)) == 0) {  // bottom s bits clear
+            n += s;
+            x >>= s;
+        }
+    }
+    return (x == 0) ? (unsigned)wordsize : n;
+#endif
+}
+
+/**
+ * Unsigned quotient and remainder of native magnitudes.
+ *
+ * Builds with ALU_SOFT_DIVIDE, intended for targets without
+ * a hardware divide, use a non-restoring divider that skips
+ * the leading zero bits of the dividend, so small dividends
+ * take few iterations. Constant-time builds use a restoring
+ * divider through every bit instead, as hardware divides take
+ * longer for some operands. Otherwise a native divide is used.
+ *
+ * @param n the dividend
+ * @param d the divisor, which must not be 0
+ * @param r the remainder
+ * @return the quotient
+ */
+static inline uword divideMagnitude(uword n, uword d, uword *r) {
+#if defined(ALU_CONSTANT_TIME)
+    // the partial remainder can exceed a word by the bit shifted out
+    uword rem = 0;
+    uword q = 0;
+    for (int b = wordtopbit; b >= 0; b--) {
+        uword out = (uword)(rem >> wordtopbit);
+        rem = (uword)((toUnsigned(rem) << 1) | ((n >> b) & 1));
+
+        // subtract the divisor where it fits, without a branch
+        uword fits = selectMask((out | (uword)(rem >= d)) != 0);
+        rem = (uword)(rem - (d & fits));
+        q = (uword)((toUnsigned(q) << 1) | (fits & 1));
+    }
+    *r = rem;
+    return q;
+#elif defined(ALU_SOFT_DIVIDE)
+#ifndef ALU_HAVE_DWORD
+#error "ALU_SOFT_DIVIDE needs a double-word integer type for this WORDSIZE"
+#endif
+    // only the significant bits of the dividend produce quotient bits
+    int top = wordtopbit - (int)leadingZeros(n);
+
+    // signed partial remainder needs two bits more than a word
+    sdword rem = 0;
+    uword q = 0;
+    for (int b = top; b >= 0; b--) {
+        // bring down next bit, then subtract or add back the divisor
+        // depending on the sign, instead of restoring the remainder
+        sdword t = 2 * rem + ((n >> b) & 1);
+        rem = (rem >= 0) ? t - d : t + d;
+        q = (toUnsigned(q) << 1) | (rem >= 0);
+    }
+    if (rem < 0) {  // final restore step
+        rem += d;
+    }
+    *r = (uword)rem;
+    return q;
+#else
+    *r = n % d;
+    return n / d;
+#endif
+}
+
+/**
+ * Native signed quotient and remainder with the conventions
+ * of div2Word(), including its results for divide by 0.
+ *
+ * @param r the remainder
+ * @param a the native dividend
+ * @param b the native divisor
+ * @return the quotient
+ */
+static inline uword nativeDiv2(uword *r, uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    // signs as masks, and a divisor of 1 in place of 0
+    uword zero = selectMask(b == 0);
+    uword s1 = (uword)(0u - (a >> wordtopbit));
+    uword s2 = (uword)(0u - (b >> wordtopbit));
+    uword n = (uword)((a ^ s1) - s1);
+    uword d = (uword)(((b ^ s2) - s2) | (zero & 1));
+
+    uword rm;
+    uword q = divideMagnitude(n, d, &rm);
+    q = (uword)((q ^ s1 ^ s2) - (s1 ^ s2));
+    rm = (uword)((rm ^ s1) - s1);
+
+    // largest positive or negative number and 0 for divide by 0
+    *r = rm & ~zero;
+    return nativeSelect(zero, (uword)(~topBit ^ s1), q);
+#else
+    if (b == 0) {
+        // handle divide by 0 by returning largest
+        // positive or negative number
+        *r = 0;
+        return (a & topBit) ? loadWord(minWord) : loadWord(maxWord);
+    }
+
+    // divide magnitudes; the most negative word is its own magnitude
+    bool negative1 = (a & topBit) != 0;
+    bool negative2 = (b & topBit) != 0;
+    uword n = negative1 ? 0u - a : a;
+    uword d = negative2 ? 0u - b : b;
+
+    uword rm;
+    uword q = divideMagnitude(n, d, &rm);
+
+    // sign of quotient from operands, sign of remainder from dividend
+    *r = negative1 ? 0u - rm : rm;
+    return (negative1 != negative2) ? 0u - q : q;
+#endif
+}
+
+/**
+ * Native unsigned quotient and remainder with the conventions
+ * of div2uWord(), including its results for divide by 0.
+ *
+ * @param r the remainder
+ * @param a the native dividend
+ * @param b the native divisor
+ * @return the quotient
+ */
+static inline uword nativeDiv2u(uword *r, uword a, uword b) {
+#ifdef ALU_CONSTANT_TIME
+    // divide by 1 in place of 0, then select the results for 0
+    uword zero = selectMask(b == 0);
+    uword q = divideMagnitude(a, b | (zero & 1), r);
+    *r &= ~zero;
+    return q | zero;
+#else
+    if (b == 0) {
+        // handle divide by 0 by returning the largest unsigned number
+        *r = 0;
+        return (uword)~(uword)0;
+    }
+    return divideMagnitude(a, b, r);
+#endif
+}
+
+/**
+ * Native word with its bytes in reverse order.
+ *
+ * @param x the native word
+ * @return the native result
+ */
+static inline uword nativeByteSwap(uword x) {
+#if WORDSIZE == 8
+    return x;
+#elif defined(__GNUC__) && WORDSIZE == 16
+    return __builtin_bswap16(x);
+#elif defined(__GNUC__) && WORDSIZE == 32
+    return __builtin_bswap32(x);
+#elif defined(__GNUC__) && WORDSIZE == 64
+    return __builtin_bswap64(x);
+#else
+    uword r = 0;
+    for (int b = 0; b < wordbytes; b++) {
+        r = (uword)((toUnsigned(r) << 8) | (x & 0xFF));
+        x = (uword)(x >> 8);
+    }
+    return r;
+#endif
+}
+
+/**
+ * Native word with its bits in reverse order.
+ *
+ * @param x the native word
+ * @return the native result
+ */
+static inline uword nativeBitReverse(uword x) {
+#ifdef ALU_HAVE_BITREVERSE
+    return (uword)(__builtin_bitreverse64(x) >> (64 - wordsize));
+#else
+    // swap adjacent bits, pairs and nibbles, then the bytes
+    x = (uword)(((x >> 1) & (uword)0x5555555555555555u) | (toUnsigned(x & (uword)0x5555555555555555u) << 1));
+    x = (uword)(((x >> 2) & (uword)0x3333333333333333u) | (toUnsigned(x & (uword)0x3333333333333333u) << 2));
+    x = (uword)(((x >> 4) & (uword)0x0F0F0F0F0F0F0F0Fu) | (toUnsigned(x & (uword)0x0F0F0F0F0F0F0F0Fu) << 4));
+    return nativeByteSwap(x);
+#endif
+}
+
+#ifdef ALU_CONSTANT_TIME
+/** number of stages of a field move, the log of wordsize */
+#define fieldStages (WORDSIZE == 8 ? 3 : WORDSIZE == 16 ? 4 : WORDSIZE == 32 ? 5 : 6)
+
+/**
+ * Masks of the bits that move at each stage of a parallel bit
+ * extract by mask, in a fixed number of steps (Hacker's Delight
+ * 7-4). Stage i moves bits right by 2^i, so a bit moves by the
+ * number of clear mask bits below it.
+ *
+ * @param moves the masks of the fieldStages stages
+ * @param mask the native mask
+ */
+static inline void fieldMoves(uword moves[], uword mask) {
+    // clear mask bits below each bit, to be counted a bit at a time
+    uword mk = (uword)(toUnsigned((uword)~mask) << 1);
+    for (int i = 0; i < fieldStages; i++) {
+        // parity of the clear bits below each bit, by a parallel suffix
+        uword mp = (uword)(mk ^ (toUnsigned(mk) << 1));
+        for (unsigned p = 2; p < (unsigned)wordsize; p <<= 1) {
+            mp = (uword)(mp ^ (toUnsigned(mp) << p));
+        }
+        uword mv = mp & mask;
+        moves[i] = mv;
+        mask = (uword)((mask ^ mv) | (mv >> (1u << i)));
+        mk = (uword)(mk & ~mp);
+    }
+}
+#endif
+
+/**
+ * Native parallel bit extract: the bits of x at the set bits of
+ * mask, packed into the low bits of the result in order.
+ *
+ * @param x the native word
+ * @param mask the native mask
+ * @return the native result
+ */
+static inline uword nativeExtract(uword x, uword mask) {
+#if defined(ALU_HAVE_PEXT) && WORDSIZE == 64
+    return _pext_u64(x, mask);
+#elif defined(ALU_HAVE_PEXT)
+    return (uword)_pext_u32(x, mask);
+#elif defined(ALU_CONSTANT_TIME)
+    uword moves[fieldStages];
+    fieldMoves(moves, mask);
+
+    // move the kept bits right by 1, 2, 4 .. in turn
+    x &= mask;
+    for (int i = 0; i < fieldStages; i++) {
+        uword t = x & moves[i];
+        x = (uword)((x ^ t) | (t >> (1u << i)));
+    }
+    return x;
+#else
+    uword r = 0;
+    for (uword b = 1; mask != 0; b = (uword)(toUnsigned(b) << 1)) {
+        if (x & mask & (0u - mask)) {  // bit at the lowest mask bit
+            r |= b;
+        }
+        mask &= (uword)(mask - 1);
+    }
+    return r;
+#endif
+}
+
+/**
+ * Native parallel bit deposit: the low bits of x, in order,
+ * placed at the set bits of mask, with the other bits zero.
+ *
+ * @param x the native word
+ * @param mask the native mask
+ * @return the native result
+ */
+static inline uword nativeDeposit(uword x, uword mask) {
+#if defined(ALU_HAVE_PEXT) && WORDSIZE == 64
+    return _pdep_u64(x, mask);
+#elif defined(ALU_HAVE_PEXT)
+    return (uword)_pdep_u32(x, mask);
+#elif defined(ALU_CONSTANT_TIME)
+    uword moves[fieldStages];
+    fieldMoves(moves, mask);
+
+    // undo the moves of an extract, largest first
+    for (int i = fieldStages - 1; i >= 0; i--) {
+        uword t = (uword)(toUnsigned(x) << (1u << i));
+        x = (uword)((x & ~moves[i]) | (t & moves[i]));
+    }
+    return x & mask;
+#else
+    uword r = 0;
+    for (uword b = 1; mask != 0; b = (uword)(toUnsigned(b) << 1)) {
+        if (x & b) {
+            r |= (uword)(mask & (0u - mask));  // lowest mask bit
+        }
+        mask &= (uword)(mask - 1);
+    }
+    return r;
+#endif
+}
+
+#endif /* ALU_NATIVE_H_ */
@@ -0,0 +1,530 @@
+/*
+ * alu_parallel.c
+ *
+ * This file implements parallel execution of batch functions on a
+ * pool of POSIX threads. A call becomes a job of chunks, and each
+ * thread of the pool owns a range of chunks packed into one atomic
+ * word as (head, tail). The owner takes chunks from the head, and
+ * a thread that has run out takes chunks from the tail of another
+ * range, so every chunk runs exactly once without a shared queue.
+ *
+ * @since 2026-10-14
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "alu_micro.h"
+#include "alu_parallel.h"
+
+/** size of a cache line in bytes */
+#define CACHE_LINE 64
+
+// mask jobs run unaligned, so their chunks start at multiples of
+// PARALLEL_CHUNK and must start on a uint64_t of the mask
+_Static_assert(PARALLEL_CHUNK % 64 == 0, "PARALLEL_CHUNK must be a multiple of 64");
+
+/** kinds of batch functions of a job */
+typedef enum jobkind {
+    jobUnary,
+    jobBinary,
+    jobShift,
+    jobTwo,
+    jobCarry,
+    jobTest,
+    jobCompare,
+    jobMicro
+} jobkind;
+
+/** definition of a job: one parallel call */
+typedef struct job {
+    jobkind kind;
+    union {
+        batchunary unary;
+        batchbinary binary;
+        batchshift shift;
+        batchtwo two;
+        batchcarry carry;
+        batchtest test;
+        batchcompare compare;
+    } f;
+    word *result;
+    word *result2;
+    bit *carry;
+    bit *overflow;
+    uint64_t *mask;
+    const word *op1;
+    const word *op2;
+    int count;
+    const microprogram *p;
+    const word *const *inputs;
+    size_t n;       // number of elements
+    size_t lead;    // number of elements of chunk 0, 1 .. PARALLEL_CHUNK
+} job;
+
+/** range of chunks of one thread, on its own cache line */
+typedef struct chunkrange {
+    _Alignas(CACHE_LINE) _Atomic uint64_t range;  // head << 32 | tail
+} chunkrange;
+
+/** the pool: threads and the job they work on */
+static struct {
+    pthread_mutex_t call;       // serializes calls and configuration
+    pthread_mutex_t lock;       // guards the fields below
+    pthread_cond_t work;        // signals a new generation or stop
+    pthread_cond_t done;        // signals that busy reached 0
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    int ids[PARALLEL_MAX_THREADS];
+    int nthreads;               // threads including the caller
+    unsigned long generation;   // incremented for each job
+    unsigned long started;      // generation when the threads were started
+    int busy;                   // pool threads still working on the job
+    bool stop;                  // tells the pool threads to exit
+    job current;
+} pool = {
+    .call = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .nthreads = 1
+};
+
+static chunkrange ranges[PARALLEL_MAX_THREADS];
+
+/**
+ * Returns the index of the first element of a chunk. Chunk 0 is
+ * short when needed so that the later chunks start on cache lines
+ * of the result.
+ *
+ * @param j the job
+ * @param c the chunk
+ * @return the index of the first element, at most n
+ */
+static size_t chunkStart(const job *j, size_t c) {
+    if (c == 0) {
+        return 0;
+    }
+    size_t start = j->lead + (c - 1) * PARALLEL_CHUNK;
+    return start < j->n ? start : j->n;
+}
+
+/**
+ * Runs the batch function of a job on the elements of one chunk.
+ *
+ * @param j the job
+ * @param c the chunk
+ */
+static void runChunk(const job *j, size_t c) {
+    size_t begin = chunkStart(j, c);
+    size_t n = chunkStart(j, c + 1) - begin;
+
+    switch (j->kind) {
+    case jobUnary:
+        j->f.unary(j->result + begin, j->op1 + begin, n);
+        break;
+    case jobBinary:
+        j->f.binary(j->result + begin, j->op1 + begin, j->op2 + begin, n);
+        break;
+    case jobShift:
+        j->f.shift(j->result + begin, j->op1 + begin, j->count, n);
+        break;
+    case jobTwo:
+        j->f.two(j->result + begin, j->result2 + begin,
+                 j->op1 + begin, j->op2 + begin, n);
+        break;
+    case jobCarry:
+        j->f.carry(j->result + begin,
+                   j->carry != NULL ? j->carry + begin : NULL,
+                   j->overflow != NULL ? j->overflow + begin : NULL,
+                   j->op1 + begin, j->op2 + begin, n);
+        break;
+    case jobTest:
+        j->f.test(j->mask + begin / 64, j->op1 + begin, n);
+        break;
+    case jobCompare:
+        j->f.compare(j->mask + begin / 64, j->op1 + begin, j->op2 + begin, n);
+        break;
+    case jobMicro: {
+        const word *inputs[MICRO_INPUTS];
+        for (int k = 0; k < j->p->ninputs; k++) {
+            inputs[k] = j->inputs[k] + begin;
+        }
+        microRunN(j->p, j->result + begin, inputs, n);
+        break;
+    }
+    }
+}
+
+/**
+ * Takes the chunk at the head of a range, for its owner.
+ *
+ * @param r the range
+ * @param c the chunk taken
+ * @return true if a chunk was taken
+ */
+static bool takeHead(chunkrange *r, size_t *c) {
+    uint64_t range = atomic_load_explicit(&r->range, memory_order_relaxed);
+    while ((range >> 32) < (range & 0xFFFFFFFFu)) {
+        if (atomic_compare_exchange_weak_explicit(&r->range, &range,
+                range + ((uint64_t)1 << 32),
+                memory_order_relaxed, memory_order_relaxed)) {
+            *c = range >> 32;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Takes the chunk at the tail of a range, for a thief.
+ *
+ * @param r the range
+ * @param c the chunk taken
+ * @return true if a chunk was taken
+ */
+static bool takeTail(chunkrange *r, size_t *c) {
+    uint64_t range = atomic_load_explicit(&r->range, memory_order_relaxed);
+    while ((range >> 32) < (range & 0xFFFFFFFFu)) {
+        if (atomic_compare_exchange_weak_explicit(&r->range, &range, range - 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+            *c = (range & 0xFFFFFFFFu) - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Runs the chunks of the range of a thread, and then steals
+ * chunks from the other threads until no chunks remain.
+ *
+ * @param j the job
+ * @param id the thread
+ * @param nthreads the number of threads
+ */
+static void workOn(const job *j, int id, int nthreads) {
+    size_t c;
+    while (takeHead(&ranges[id], &c)) {
+        runChunk(j, c);
+    }
+    for (int k = 1; k < nthreads; k++) {
+        chunkrange *victim = &ranges[(id + k) % nthreads];
+        while (takeTail(victim, &c)) {
+            runChunk(j, c);
+        }
+    }
+}
+
+/**
+ * Body of a pool thread: works on each new job until stopped.
+ *
+ * @param arg the thread id
+ * @return NULL
+ */
+static void *poolThread(void *arg) {
+    int id = *(int *)arg;
+
+    pthread_mutex_lock(&pool.lock);
+    unsigned long seen = pool.started;
+    for (;;) {
+        while (pool.generation == seen && !pool.stop) {
+            pthread_cond_wait(&pool.work, &pool.lock);
+        }
+        if (pool.stop) {
+            break;
+        }
+        seen = pool.generation;
+        int nthreads = pool.nthreads;
+        pthread_mutex_unlock(&pool.lock);
+
+        workOn(&pool.current, id, nthreads);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.busy == 0) {
+            pthread_cond_signal(&pool.done);
+        }
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+/**
+ * Sets the number of threads of the pool, including the calling
+ * thread. A count of 0 or less uses one thread for each online
+ * processor, and counts beyond PARALLEL_MAX_THREADS are clamped.
+ * A count of 1 stops the pool threads.
+ *
+ * @param nthreads the number of threads
+ * @return true if the pool has the requested number of threads
+ */
+bool parallelSetThreads(int nthreads) {
+    if (nthreads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = online > 0 ? (int)(online < PARALLEL_MAX_THREADS
+                                      ? online : PARALLEL_MAX_THREADS) : 1;
+    }
+    if (nthreads > PARALLEL_MAX_THREADS) {
+        nthreads = PARALLEL_MAX_THREADS;
+    }
+
+    pthread_mutex_lock(&pool.call);
+
+    // stop the current threads
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.work);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 1; i < pool.nthreads; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+
+    // start the new threads
+    pool.stop = false;
+    pool.started = pool.generation;
+    pool.nthreads = 1;
+    bool ok = true;
+    for (int i = 1; i < nthreads; i++) {
+        pool.ids[i] = i;
+        if (pthread_create(&pool.threads[i], NULL, poolThread, &pool.ids[i]) != 0) {
+            ok = false;
+            break;
+        }
+        pool.nthreads++;
+    }
+
+    pthread_mutex_unlock(&pool.call);
+    return ok;
+}
+
+/**
+ * Returns the number of threads of the pool, including the
+ * calling thread.
+ *
+ * @return the number of threads
+ */
+int parallelThreads(void) {
+    pthread_mutex_lock(&pool.call);
+    int nthreads = pool.nthreads;
+    pthread_mutex_unlock(&pool.call);
+    return nthreads;
+}
+
+/**
+ * Returns whether a job of n elements runs on the calling thread
+ * alone. Such jobs call the batch function directly.
+ *
+ * @param n the number of elements
+ * @return true if the job is too small for the pool
+ */
+static bool serial(size_t n) {
+    return n < 2 * PARALLEL_CHUNK || parallelThreads() == 1;
+}
+
+/**
+ * Runs a job on the pool. The chunks are shared out in equal
+ * ranges, and the calling thread works on the job as thread 0.
+ *
+ * @param j the job, with all fields but lead set
+ * @param align the array whose cache lines the chunks follow, or NULL
+ */
+static void runJob(const job *j, const void *align) {
+    pthread_mutex_lock(&pool.call);
+
+    pool.current = *j;
+    job *current = &pool.current;
+    current->lead = PARALLEL_CHUNK;
+    if (align != NULL) {
+        size_t bytes = (CACHE_LINE - (uintptr_t)align % CACHE_LINE) % CACHE_LINE;
+        if (bytes != 0 && bytes % sizeof(word) == 0) {
+            current->lead = bytes / sizeof(word);
+        }
+    }
+
+    size_t nchunks = 1;
+    if (current->n > current->lead) {
+        nchunks += (current->n - current->lead + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+    }
+    int nthreads = pool.nthreads;
+    for (int i = 0; i < nthreads; i++) {
+        uint64_t head = nchunks * (size_t)i / (size_t)nthreads;
+        uint64_t tail = nchunks * (size_t)(i + 1) / (size_t)nthreads;
+        atomic_store_explicit(&ranges[i].range, head << 32 | tail, memory_order_relaxed);
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.busy = nthreads - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.work);
+    pthread_mutex_unlock(&pool.lock);
+
+    workOn(current, 0, nthreads);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.busy != 0) {
+        pthread_cond_wait(&pool.done, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    pthread_mutex_unlock(&pool.call);
+}
+
+/**
+ * Runs a batch function of one operand array in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void parallelUnaryN(batchunary f, word *result, const word *op, size_t n) {
+    if (serial(n)) {
+        f(result, op, n);
+        return;
+    }
+    job j = { .kind = jobUnary, .f.unary = f, .result = result, .op1 = op, .n = n };
+    runJob(&j, result);
+}
+
+/**
+ * Runs a batch function of two operand arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelBinaryN(batchbinary f, word *result,
+                     const word *op1, const word *op2, size_t n) {
+    if (serial(n)) {
+        f(result, op1, op2, n);
+        return;
+    }
+    job j = { .kind = jobBinary, .f.binary = f, .result = result,
+              .op1 = op1, .op2 = op2, .n = n };
+    runJob(&j, result);
+}
+
+/**
+ * Runs a batch shift or mask function in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift or mask count
+ * @param n the number of elements
+ */
+void parallelShiftN(batchshift f, word *result, const word *op, int count, size_t n) {
+    if (serial(n)) {
+        f(result, op, count, n);
+        return;
+    }
+    job j = { .kind = jobShift, .f.shift = f, .result = result,
+              .op1 = op, .count = count, .n = n };
+    runJob(&j, result);
+}
+
+/**
+ * Runs a batch function with two result arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result1 the first result array
+ * @param result2 the second result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelTwoResultN(batchtwo f, word *result1, word *result2,
+                        const word *op1, const word *op2, size_t n) {
+    if (serial(n)) {
+        f(result1, result2, op1, op2, n);
+        return;
+    }
+    job j = { .kind = jobTwo, .f.two = f, .result = result1, .result2 = result2,
+              .op1 = op1, .op2 = op2, .n = n };
+    runJob(&j, result1);
+}
+
+/**
+ * Runs a batch function with carry and overflow arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param carry the carry array, or NULL
+ * @param overflow the overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelCarryN(batchcarry f, word *result, bit *carry, bit *overflow,
+                    const word *op1, const word *op2, size_t n) {
+    if (serial(n)) {
+        f(result, carry, overflow, op1, op2, n);
+        return;
+    }
+    job j = { .kind = jobCarry, .f.carry = f, .result = result, .carry = carry,
+              .overflow = overflow, .op1 = op1, .op2 = op2, .n = n };
+    runJob(&j, result);
+}
+
+/**
+ * Runs a batch test of one operand array in parallel. The mask
+ * layout is the same as for testLtWordMask().
+ *
+ * @param f the batch test
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void parallelTestN(batchtest f, uint64_t *mask, const word *op, size_t n) {
+    if (serial(n)) {
+        f(mask, op, n);
+        return;
+    }
+    // chunks of whole mask elements: no alignment of chunk 0
+    job j = { .kind = jobTest, .f.test = f, .mask = mask, .op1 = op, .n = n };
+    runJob(&j, NULL);
+}
+
+/**
+ * Runs a batch test of two operand arrays in parallel. The mask
+ * layout is the same as for testLtWordMask().
+ *
+ * @param f the batch test
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelCompareN(batchcompare f, uint64_t *mask,
+                      const word *op1, const word *op2, size_t n) {
+    if (serial(n)) {
+        f(mask, op1, op2, n);
+        return;
+    }
+    job j = { .kind = jobCompare, .f.compare = f, .mask = mask,
+              .op1 = op1, .op2 = op2, .n = n };
+    runJob(&j, NULL);
+}
+
+/**
+ * Runs a microprogram on n sets of inputs in parallel, as
+ * microRunN() does.
+ *
+ * @param p the microprogram
+ * @param result the result array
+ * @param inputs the array of ninputs input arrays
+ * @param n the number of elements
+ */
+void parallelMicroN(const microprogram *p, word *result,
+                    const word *const *inputs, size_t n) {
+    if (serial(n)) {
+        microRunN(p, result, inputs, n);
+        return;
+    }
+    job j = { .kind = jobMicro, .p = p, .result = result, .inputs = inputs, .n = n };
+    runJob(&j, result);
+}
@@ -0,0 +1,180 @@
+/*
+ * alu_parallel.h
+ *
+ * This file declares parallel execution of the batch functions of
+ * alu_batch.h and of microprograms on a pool of threads. Each call
+ * splits its arrays into chunks that start on cache-line boundaries
+ * of the result array, so no two threads write the same cache line.
+ * Each thread starts with an equal share of chunks, and a thread
+ * that finishes its share steals chunks from the others. This
+ * balances the load for operations whose cost depends on the
+ * operands, such as mulWordN and div2WordN.
+ *
+ * Results are deterministic: element i of a result depends only on
+ * element i of the operands, so the results are the same as those
+ * of a single call of the batch function for every thread count
+ * and schedule. The aliasing rules of alu_batch.h apply.
+ *
+ * The pool has one thread until parallelSetThreads() is called, and
+ * calls with few elements run on the calling thread. The calling
+ * thread works on its own call along with the pool, and calls from
+ * several threads at once take turns on the pool.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_PARALLEL_H_
+#define ALU_PARALLEL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "alu_micro.h"
+#include "word.h"
+
+/** maximum number of threads of the pool */
+#define PARALLEL_MAX_THREADS 256
+
+/** number of elements of a chunk, a multiple of 64 for mask arrays */
+#ifndef PARALLEL_CHUNK
+#define PARALLEL_CHUNK 2048
+#endif
+
+/** batch function of one operand array, such as notWordN */
+typedef void (*batchunary)(word *result, const word *op, size_t n);
+
+/** batch function of two operand arrays, such as addWordN */
+typedef void (*batchbinary)(word *result, const word *op1, const word *op2, size_t n);
+
+/** batch function of an operand array and a count, such as ashWordN */
+typedef void (*batchshift)(word *result, const word *op, int count, size_t n);
+
+/** batch function with two result arrays: mulWideWordN or div2WordN */
+typedef void (*batchtwo)(word *result1, word *result2,
+                         const word *op1, const word *op2, size_t n);
+
+/** batch function with carry and overflow arrays: addCarryWordN or subCarryWordN */
+typedef void (*batchcarry)(word *result, bit *carry, bit *overflow,
+                           const word *op1, const word *op2, size_t n);
+
+/** batch test of one operand array into a mask, such as testLtWordMask */
+typedef void (*batchtest)(uint64_t *mask, const word *op, size_t n);
+
+/** batch test of two operand arrays into a mask, such as cmpLtWordMask */
+typedef void (*batchcompare)(uint64_t *mask, const word *op1, const word *op2, size_t n);
+
+/**
+ * Sets the number of threads of the pool, including the calling
+ * thread. A count of 0 or less uses one thread for each online
+ * processor, and counts beyond PARALLEL_MAX_THREADS are clamped.
+ * A count of 1 stops the pool threads.
+ *
+ * @param nthreads the number of threads
+ * @return true if the pool has the requested number of threads
+ */
+bool parallelSetThreads(int nthreads);
+
+/**
+ * Returns the number of threads of the pool, including the
+ * calling thread.
+ *
+ * @return the number of threads
+ */
+int parallelThreads(void);
+
+/**
+ * Runs a batch function of one operand array in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void parallelUnaryN(batchunary f, word *result, const word *op, size_t n);
+
+/**
+ * Runs a batch function of two operand arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelBinaryN(batchbinary f, word *result,
+                     const word *op1, const word *op2, size_t n);
+
+/**
+ * Runs a batch shift or mask function in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift or mask count
+ * @param n the number of elements
+ */
+void parallelShiftN(batchshift f, word *result, const word *op, int count, size_t n);
+
+/**
+ * Runs a batch function with two result arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result1 the first result array
+ * @param result2 the second result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelTwoResultN(batchtwo f, word *result1, word *result2,
+                        const word *op1, const word *op2, size_t n);
+
+/**
+ * Runs a batch function with carry and overflow arrays in parallel.
+ *
+ * @param f the batch function
+ * @param result the result array
+ * @param carry the carry array, or NULL
+ * @param overflow the overflow array, or NULL
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelCarryN(batchcarry f, word *result, bit *carry, bit *overflow,
+                    const word *op1, const word *op2, size_t n);
+
+/**
+ * Runs a batch test of one operand array in parallel. The mask
+ * layout is the same as for testLtWordMask().
+ *
+ * @param f the batch test
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op the operand array
+ * @param n the number of elements
+ */
+void parallelTestN(batchtest f, uint64_t *mask, const word *op, size_t n);
+
+/**
+ * Runs a batch test of two operand arrays in parallel. The mask
+ * layout is the same as for testLtWordMask().
+ *
+ * @param f the batch test
+ * @param mask the mask array of (n + 63) / 64 elements
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void parallelCompareN(batchcompare f, uint64_t *mask,
+                      const word *op1, const word *op2, size_t n);
+
+/**
+ * Runs a microprogram on n sets of inputs in parallel, as
+ * microRunN() does.
+ *
+ * @param p the microprogram
+ * @param result the result array
+ * @param inputs the array of ninputs input arrays
+ * @param n the number of elements
+ */
+void parallelMicroN(const microprogram *p, word *result,
+                    const word *const *inputs, size_t n);
+
+#endif /* ALU_PARALLEL_H_ */
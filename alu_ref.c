@@ -0,0 +1,992 @@
+/*
+ * alu_ref.c
+ *
+ * This file implements the reference bit-serial versions of
+ * the arithmetic logic unit functions. They are kept as an
+ * oracle for the native engines in alu.c.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "alu_instrument.h"
+#include "alu_ref.h"
+
+/**
+ * Bit-serial test whether word is less than zero.
+ *
+ * @param op the operand
+ * @return true if op is less than zero
+ */
+bool testLtWordRef(const word op) {
+    bit bitofsign = getBitOfWord(op, wordtopbit);
+    if (bitofsign == 1) {
+        return true;
+    } else
+        return false;
+
+    // NOTES:
+    // A word is negative only if its sign bit
+    // (wordtopbit) is set.
+}
+
+/**
+ * Bit-serial test whether word is greater than or equal to zero.
+ *
+ * @param op the operand
+ * @return true if op is greater than or equal to zero
+ */
+bool testGeWordRef(const word op) {
+    bit bitofsign = getBitOfWord(op, wordtopbit);
+    if (bitofsign == 1) {
+        return false;
+    } else
+        return true;
+    // NOTES:
+    // This is the inverse of the LT condition.
+
+}
+
+/**
+ * Bit-serial test whether word is zero.
+ *
+ * @param op the operand
+ * @return true if op is zero
+ */
+bool testEqWordRef(const word op) {
+
+    for (int b = 0; b <= wordtopbit; b++) {
+        if (getBitOfWord(op, b) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+
+    // NOTES:
+    // Return true if all bits of word are 0
+
+}
+
+/**
+ * Bit-serial comparison of two word operands from the top
+ * bit down, signed if the sign bits compare inverted.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param sign 1 for a signed comparison, 0 for unsigned
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+static int cmpBitsRef(const word op1, const word op2, bit sign) {
+    for (int b = wordtopbit; b >= 0; b--) {
+        // the sign bit weighs -2^wordtopbit in a signed comparison
+        bit flip = (b == wordtopbit) ? sign : 0;
+        bit t1 = getBitOfWord(op1, b) ^ flip;
+        bit t2 = getBitOfWord(op2, b) ^ flip;
+        if (t1 != t2) {
+            return (t1 < t2) ? -1 : 1;
+        }
+    }
+
+    return 0;
+
+    // NOTES:
+    // The first bit from the top where the words
+    // differ decides the comparison.
+}
+
+/**
+ * Bit-serial signed comparison of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpWordRef(const word op1, const word op2) {
+    return cmpBitsRef(op1, op2, 1);
+}
+
+/**
+ * Bit-serial unsigned comparison of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpuWordRef(const word op1, const word op2) {
+    return cmpBitsRef(op1, op2, 0);
+}
+
+/**
+ * Bit-serial unsigned less-than test of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is less than op2
+ */
+bool cmpLtuWordRef(const word op1, const word op2) {
+    return cmpBitsRef(op1, op2, 0) < 0;
+}
+
+/**
+ * Bit-serial unsigned greater-or-equal test of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is greater than or equal to op2
+ */
+bool cmpGeuWordRef(const word op1, const word op2) {
+    return cmpBitsRef(op1, op2, 0) >= 0;
+}
+
+/**
+ * Bit-serial signed minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void sminWordRef(word result, const word op1, const word op2) {
+    setWord(result, (cmpWordRef(op1, op2) <= 0) ? op1 : op2);
+}
+
+/**
+ * Bit-serial signed maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void smaxWordRef(word result, const word op1, const word op2) {
+    setWord(result, (cmpWordRef(op1, op2) >= 0) ? op1 : op2);
+}
+
+/**
+ * Bit-serial unsigned minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void uminWordRef(word result, const word op1, const word op2) {
+    setWord(result, (cmpuWordRef(op1, op2) <= 0) ? op1 : op2);
+}
+
+/**
+ * Bit-serial unsigned maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void umaxWordRef(word result, const word op1, const word op2) {
+    setWord(result, (cmpuWordRef(op1, op2) >= 0) ? op1 : op2);
+}
+
+/**
+ * Bit-serial logical AND of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void andWordRef(word result, const word op1, const word op2) {
+
+    //Extract each corresponding bit of both words and  perform AND operation
+    // to store the result bit in result at the corresponding position
+    for (int b = 0; b <= wordtopbit; b++) {
+        bit t1 = getBitOfWord(op1, b);
+        bit t2 = getBitOfWord(op2, b);
+        setBitOfWord(result, b, t1 & t2);
+    }
+
+    // NOTES:
+    // Use bit-wise AND operator (&) on each bit of op1
+    // and op2 to set each bit of the result.
+
+}
+
+/**
+ * Bit-serial logical OR of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void orWordRef(word result, const word op1, const word op2) {
+
+    //Extract each corresponding bit of both words and  perform OR operation
+    // to store the result bit in result at the corresponding position
+    for (int b = 0; b <= wordtopbit; b++) {
+        bit t1 = getBitOfWord(op1, b);
+        bit t2 = getBitOfWord(op2, b);
+        setBitOfWord(result, b, t1 | t2);
+    }
+    // NOTES:
+    // Use bit-wise OR operator (|) on each bit of op1
+    // and op2 to set each bit of the result.
+
+}
+
+/**
+ * Bit-serial logical XOR of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void xorWordRef(word result, const word op1, const word op2) {
+
+    //Extract each corresponding bit of both words and  perform XOR operation
+    // to store the result bit in result at the corresponding position
+    for (int b = 0; b <= wordtopbit; b++) {
+        bit t1 = getBitOfWord(op1, b);
+        bit t2 = getBitOfWord(op2, b);
+        setBitOfWord(result, b, t1 ^ t2);
+    }
+    // NOTES:
+    // Use bit-wise XOR operator (^) on each bit of op1
+    // and op2 to set each bit of the result.
+
+}
+
+/**
+ * Bit-serial logical NOT of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void notWordRef(word result, const word op) {
+    //Use notBit function to negate for each bit extracted and store it in result bit
+    for (int b = 0; b <= wordtopbit; b++) {
+        setBitOfWord(result, b, notBit(getBitOfWord(op, b)));
+    }
+}
+
+/**
+ * Bit-serial sum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addWordRef(word result, const word op1, const word op2) {
+
+    bit carry = 0;
+    for (uint8_t b = 0; b <= wordtopbit; b++) {
+        // can be 0..3
+        uint8_t r = getBitOfWord(op1, b) + getBitOfWord(op2, b) + carry;
+        carry = r >> 1;
+        setBitOfWord(result, b, toBit(r));
+    }
+
+    // NOTES:
+    // The algorithm requires adding the bits of
+    // op1 and op2 starting from the least significant
+    // bit. If the sum is greater than 1, then use the
+    // lower bit of the sum as the bit for that position
+    // and carry 1 to the next bits if the sum is 2 or 3.
+    // The initial value of the carry bit is 0.
+    //
+    //     0 1 1 0  (6)
+    //   + 1 1 1 1  (-1)
+    //     -------
+    //           1  sum
+    //         0    carry
+    //     -------
+    //         0 1  sum
+    //       1      carry
+    //     -------
+    //       1 0 1  sum
+    //     1        carry
+    //     -------
+    //     0 1 0 1  sum
+    //   1          carry
+    //
+    // Final sum is 0101 (5)
+
+}
+
+/**
+ * Bit-serial difference of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subWordRef(word result, const word op1, const word op2) {
+    bit carry = 1;
+    for (uint8_t b = 0; b <= wordtopbit; b++) {
+        // can be 0..3
+        uint8_t r = getBitOfWord(op1, b) + notBit(getBitOfWord(op2, b)) + carry;
+        carry = r >> 1;
+        setBitOfWord(result, b, toBit(r));
+    }
+}
+
+/**
+ * Bit-serial negative of word operand.
+ *
+ * Examples: (big-endian):
+ * 	negative(0000 0000 0000 0011) -> 1111 1111 1111 1101
+ * 	negative(1111 1111 1111 1111) -> 0000 0000 0000 0001
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void negativeWordRef(word result, const word op) {
+
+    //Subtracting from zero to get negative word
+    subWordRef(result, zeroWord, op);
+    // NOTES:
+    // Equivalent to (0 - op).
+
+}
+
+/**
+ * Bit-serial sum of two word operands also returning the
+ * carry out of and the signed overflow into the top bit.
+ *
+ * @param result the result
+ * @param carry the carry out, or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addCarryWordRef(word result, bit *carry, bit *overflow,
+                     const word op1, const word op2) {
+    bit c = 0;
+    bit ctop = 0;
+    for (uint8_t b = 0; b <= wordtopbit; b++) {
+        // can be 0..3
+        uint8_t r = getBitOfWord(op1, b) + getBitOfWord(op2, b) + c;
+        ctop = c;
+        c = r >> 1;
+        setBitOfWord(result, b, toBit(r));
+    }
+    if (carry != NULL) {
+        *carry = c;
+    }
+    if (overflow != NULL) {
+        // overflow if carry into top bit differs from carry out
+        *overflow = ctop ^ c;
+    }
+}
+
+/**
+ * Bit-serial difference of two word operands also returning
+ * the carry out of and the signed overflow into the top bit.
+ * The carry is set if no borrow occurred.
+ *
+ * @param result the result
+ * @param carry the carry out, or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subCarryWordRef(word result, bit *carry, bit *overflow,
+                     const word op1, const word op2) {
+    bit c = 1;
+    bit ctop = 1;
+    for (uint8_t b = 0; b <= wordtopbit; b++) {
+        // can be 0..3
+        uint8_t r = getBitOfWord(op1, b) + notBit(getBitOfWord(op2, b)) + c;
+        ctop = c;
+        c = r >> 1;
+        setBitOfWord(result, b, toBit(r));
+    }
+    if (carry != NULL) {
+        *carry = c;
+    }
+    if (overflow != NULL) {
+        // overflow if carry into top bit differs from carry out
+        *overflow = ctop ^ c;
+    }
+}
+
+/**
+ * Bit-serial arithmetic shift word by count. Same as multiplying or
+ * dividing by power of 2.  Shifts bits in word left (+) or
+ * right (-) by the specified count. Fills in with 0 from
+ * the right, and the sign bit from the left.
+ *
+ * Examples (big-endian):
+ * 	ash(1010 1011 1111 1111, 5)  -> 1111 1111 1110 0000
+ * 	ash(1111 1111 0000 0000, -5) -> 1111 1111 1111 1000
+ *
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashWordRef(word result, const word op, int count) {
+    // clamp before abs() so the most negative count is safe
+    int c = (count < -wordtopbit || count > wordtopbit) ? wordtopbit : abs(count);
+
+    // local copy in case op and result overlap
+    word localop;
+    setWord(localop, op);
+
+    bit sign = getBitOfWord(localop, wordtopbit);
+    if (count < 0) {
+        // move upper bits of word right
+        for (int b = wordtopbit - 1; b >= c; b--) {
+            bit t = getBitOfWord(localop, b);
+            setBitOfWord(result, b - c, t);
+        }
+        // clear upper bits of word to sign bit
+        for (int b = c; b >= 1; b--) {
+            setBitOfWord(result, wordtopbit - b, sign);
+        }
+    } else {
+        // move lower bits of word left
+        for (int b = wordtopbit - 1; b >= c; b--) {
+            bit t = getBitOfWord(localop, b - c);
+            setBitOfWord(result, b, t);
+        }
+        // clear lower bits of word
+        for (int b = c - 1; b >= 0; b--) {
+            setBitOfWord(result, b, 0);
+        }
+    }
+    // set top bit of word
+    setBitOfWord(result, wordtopbit, sign);
+}
+
+/**
+ * Bit-serial circular shift word by count. Shifts bits in word
+ * left (+) or right (-) by the specified count. Bits
+ * shifted off either end of word are rotated in to
+ * the other end of word.
+ *
+ * Examples (big-endian):
+ * 	csh(1010 1011 1111 1111, 4)  -> 1011 1111 1111 1010
+ * 	csh(1010 1011 1111 1111, -4) -> 1111 1010 1011 1111
+ *
+ * @param op the operand
+ * @param count the shift count
+ */
+void cshWordRef(word result, const word op, int count) {
+    // count modulo wordsize, as a left rotation
+    int c = count % wordsize;
+    if (c < 0) {
+        c += wordsize;
+    }
+
+    // local copy in case op and result overlap
+    word localop;
+    setWord(localop, op);
+
+    for (int b = 0; b <= wordtopbit; b++) {
+        bit t = getBitOfWord(localop, b);
+        setBitOfWord(result, (b + c) % wordsize, t);
+    }
+
+    // NOTES:
+    // Set bits in result, from op, shifted left or right
+    // based on the sign of the count. Compute the position
+    // in result word using the C remainder operator (%) with
+    // wordsize to "wrap around" to the position on the other
+    // end of result word.
+
+}
+
+/**
+ * Bit-serial logical shift word by count. Shifts bits in word
+ * left (+) or right (-) by the specified count. Shifts
+ * bits off end and fills in with 0 in either direction.
+ *
+ * Examples (big-endian):
+ * 	lsh(1111 1111 1111 1111, 5)  -> 1111 1111 1110 0000
+ * 	lsh(1111 1111 1111 1111, -5) -> 0000 0111 1111 1111
+ *
+ * @param op the operand
+ * @param count the shift count
+ */
+void lshWordRef(word result, const word op, int count) {
+    // clamp before abs() so the most negative count is safe
+    int c = (count < -wordsize || count > wordsize) ? wordsize : abs(count);
+    word localop; //localcopy
+    setWord(localop, op);
+
+    if (count < 0) {
+        // move upper bits of word right
+        for (int b = wordtopbit; b >= c; b--) {
+            bit t = getBitOfWord(localop, b);
+            setBitOfWord(result, b - c, t);
+        }
+        // clear upper bits of word to zero
+        for (int b = c - 1; b >= 0; b--) {
+            setBitOfWord(result, wordtopbit - b, 0);
+        }
+    } else {
+        // move lower bits of word left
+        for (int b = wordtopbit; b >= c; b--) {
+            bit t = getBitOfWord(localop, b - c);
+            setBitOfWord(result, b, t);
+        }
+        // clear lower bits of word
+        for (int b = c - 1; b >= 0; b--) {
+            setBitOfWord(result, b, 0);
+        }
+    }
+
+    // NOTES:
+    // Set bits in result from op, shifted left or
+    // right based on the sign o the count. Then fill
+    // in result bits from left or right with 0 bits.
+
+}
+
+/**
+ * Bit-serial mask of all but lower (+) or upper (-) count
+ * bits of word operand.
+ *
+ * Examples (big-endian):
+ * 	mask(1010 1011 1111 1111, 5)  -> 0000 0000 0001 1111
+ * 	mask(1010 1011 1111 1111, -5) -> 1010 1000 0000 0000
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the mask count
+ */
+void maskWordRef(word result, const word op, int count) {
+    // clamp before abs() so the most negative count is safe
+    int c = (count < -wordsize || count > wordsize) ? wordsize : abs(count);
+
+    if (count < 0) {
+        int wtbc = wordtopbit - c;
+
+        // copy upper bits of word
+        for (int b = wordtopbit; b > wtbc; b--) {
+            bit t = getBitOfWord(op, b);
+            setBitOfWord(result, b, t);
+        }
+
+        // clear lower bits of word
+        for (int b = wtbc; b >= 0; b--) {
+            setBitOfWord(result, b, 0);
+        }
+    } else {
+        // copy lower bits of word
+        for (int b = 0; b < c; b++) {
+            bit t = getBitOfWord(op, b);
+            setBitOfWord(result, b, t);
+        }
+
+        // clear upper bits of word
+        for (int b = c; b <= wordtopbit; b++) {
+            setBitOfWord(result, b, 0);
+        }
+    }
+}
+
+/**
+ * Bit-serial shift-and-add product of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWordRef(word result, const word op1, const word op2) {
+
+    word localop1; //localcopy
+    setWord(localop1, op1);
+
+    word localop2; //localcopy
+    setWord(localop2, op2);
+
+    //Setting result to zero
+    setWord(result, zeroWord);
+
+    //Setting up a word of value 1 to compute 2's complement
+    word one;
+    setWord(one, zeroWord);
+    setBitOfWord(one, 0, 1);
+
+    bool negativeProduct = false;
+
+    bit msb1 = getBitOfWord(localop1, wordtopbit);
+    bit msb2 = getBitOfWord(localop2, wordtopbit);
+
+    //Checking if any one operand is negative
+    if ((msb1 ^ msb2) == 1)
+        negativeProduct = true;
+
+    //Convert the negative numbers to positive ones
+    if (msb1 == 1) {
+        notWordRef(localop1, localop1);
+        addWordRef(localop1, localop1, one);
+    }
+
+    if (msb2 == 1) {
+        notWordRef(localop2, localop2);
+        addWordRef(localop2, localop2, one);
+    }
+
+    while (testEqWordRef(localop2) == false) {
+        INSTRUMENT_LOOP(instMul);
+
+        if (getBitOfWord(localop2, 0) != 0) {
+            addWordRef(result, result, localop1);
+        }
+
+        lshWordRef(localop1, localop1, 1);
+        lshWordRef(localop2, localop2, -1);
+
+    }
+
+    //Negate the result if one of the operands is negative
+    if (negativeProduct == true) {
+        notWordRef(result, result);
+        addWordRef(result, result, one);
+    }
+
+    // NOTES:
+    // The algorithm require making op2 positive.
+    // Can be done by making taking the negative of
+    // both operands if op2 is negative, or by making
+    // both operands positive and applying the sign at
+    // the end.
+    //
+    // Here is how to multiply two binary numbers. For
+    // each bit in op2 from the least to most significant
+    // bit, left shift op1 left by 1, and if bit of op2
+    // is set, add shifted op1 into results. Here is an
+    // example for a 4-bit number.
+    //
+    //          0 0 1 1
+    //       x  1 1 0 1
+    //       ----------
+    //          0 0 1 1
+    //        0 0 0 0
+    //      0 0 1 1
+    //  + 0 0 1 1
+    //    -------------
+    //    0 1 0 0 1 1 1
+
+}
+
+/**
+ * Bit-serial full product of two unsigned word operands,
+ * shared by the signed and unsigned multiplies.
+ *
+ * @param hi the upper word of the product
+ * @param lo the lower word of the product
+ * @param w1 the first operand
+ * @param w2 the second operand
+ * @param op the instrumented function
+ */
+static void mulMagnitudeRef(word hi, word lo, const word w1, const word w2, instop op) {
+    word phi, plo;
+    setWord(phi, zeroWord);
+    setWord(plo, zeroWord);
+    for (int b = 0; b <= wordtopbit; b++) {
+        INSTRUMENT_LOOP(op);
+        if (getBitOfWord(w2, b)) {
+            // add w1 shifted left by b across both words
+            word shi, slo;
+            lshWordRef(slo, w1, b);
+            lshWordRef(shi, w1, b - wordsize);
+            bit carry;
+            addCarryWordRef(plo, &carry, NULL, plo, slo);
+            addWordRef(phi, phi, shi);
+            if (carry) {
+                word one = {0};
+                setBitOfWord(one, 0, 1);
+                addWordRef(phi, phi, one);
+            }
+        }
+    }
+    (void)op;
+
+    setWord(hi, phi);
+    setWord(lo, plo);
+}
+
+/**
+ * Bit-serial full product of two word operands.
+ *
+ * @param hi the upper word of the product
+ * @param lo the lower word of the product
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWideWordRef(word hi, word lo, const word op1, const word op2) {
+    // operands must be positive
+    word w1, w2;
+    bool negativeProduct = false;
+    if (getBitOfWord(op1, wordtopbit)) {
+        negativeWordRef(w1, op1);
+        negativeProduct = !negativeProduct;
+    } else {
+        setWord(w1, op1);
+    }
+    if (getBitOfWord(op2, wordtopbit)) {
+        negativeWordRef(w2, op2);
+        negativeProduct = !negativeProduct;
+    } else {
+        setWord(w2, op2);
+    }
+
+    word phi, plo;
+    mulMagnitudeRef(phi, plo, w1, w2, instMulWide);
+
+    if (negativeProduct) {
+        // negate across both words: invert and add one
+        notWordRef(phi, phi);
+        bit carry;
+        word one = {0};
+        setBitOfWord(one, 0, 1);
+        notWordRef(plo, plo);
+        addCarryWordRef(plo, &carry, NULL, plo, one);
+        if (carry) {
+            addWordRef(phi, phi, one);
+        }
+    }
+
+    setWord(hi, phi);
+    setWord(lo, plo);
+}
+
+/**
+ * Bit-serial restoring quotient of two unsigned word operands
+ * also returning remainder, shared by the signed and unsigned
+ * divides. The divisor must not be 0, and the results must not
+ * be the same words as the operands.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param n the dividend
+ * @param d the divisor
+ * @param op the instrumented function
+ */
+static void divideMagnitudeRef(word result, word remainder, const word n, const word d, instop op) {
+    setWord(result, zeroWord);
+    setWord(remainder, zeroWord);
+
+    // normalize: the leading zero bits of the dividend
+    // bring down no quotient bits, so start below them
+    for (int b = wordtopbit - clzWordRef(n); b >= 0; b--) {
+        INSTRUMENT_LOOP(op);
+        bit out = getBitOfWord(remainder, wordtopbit);  // bit shifted out
+        lshWordRef(remainder, remainder, 1);    // position remainder
+        bit t = getBitOfWord(n, b);    // bring down next bit
+        setBitOfWord(remainder, 0, t);
+
+        // division successful if the shifted remainder, with the
+        // bit shifted out, is at least the divisor
+        word test;
+        bit noBorrow;
+        subCarryWordRef(test, &noBorrow, NULL, remainder, d);  // do trial subtract
+        if (out || noBorrow) {
+            setBitOfWord(result, b, 1);    // shift bit into result
+            setWord(remainder, test);   // update remainder
+        }
+    }
+    (void)op;
+}
+
+/**
+ * Bit-serial restoring quotient of two word operands also
+ * returning remainder. The sign of the quotient is positive if the signs of
+ * the operands match, and negative if they do not.
+ * The sign of the remainder matches the sign of the dividend.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2WordRef(word result, word remainder, const word op1, const word op2) {
+    // copy the operands, which the results may be
+    word a, b;
+    setWord(a, op1);
+    setWord(b, op2);
+
+    setWord(result, zeroWord);
+    setWord(remainder, zeroWord);
+
+    if (testEqWordRef(b)) {
+        // handle divide by 0 by returning largest
+        // positive or negative number
+        setWord(result, (testGeWordRef(a) ? maxWord : minWord));
+    } else {
+        word w1, w2;
+        bool resultNegative = false;
+        // operands must be positive
+        if (testLtWordRef(a)) {
+            negativeWordRef(w1, a);
+            resultNegative = !resultNegative;
+        } else {
+            setWord(w1, a);
+        }
+        if (testLtWordRef(b)) {
+            negativeWordRef(w2, b);
+            resultNegative = !resultNegative;
+        } else {
+            setWord(w2, b);
+        }
+
+        // divide the magnitudes; the most negative word is its
+        // own magnitude as an unsigned word
+        divideMagnitudeRef(result, remainder, w1, w2, instDiv2);
+
+        if (resultNegative) {    // set correct sign of result
+            negativeWordRef(result, result);
+        }
+
+        if (testLtWordRef(a)) { // remainder negative if op1 is negative
+            negativeWordRef(remainder, remainder);
+        }
+    }
+}
+
+/**
+ * Bit-serial upper word of the product of two unsigned word
+ * operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulHighuWordRef(word result, const word op1, const word op2) {
+    word lo;
+    mulMagnitudeRef(result, lo, op1, op2, instMulHighu);
+}
+
+/**
+ * Bit-serial restoring quotient of two unsigned word operands
+ * also returning remainder.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2uWordRef(word result, word remainder, const word op1, const word op2) {
+    if (testEqWordRef(op2)) {
+        // handle divide by 0 by returning the largest unsigned number
+        setWord(remainder, zeroWord);
+        notWordRef(result, zeroWord);
+    } else {
+        // copy the operands, which the results may be
+        word n, d;
+        setWord(n, op1);
+        setWord(d, op2);
+        divideMagnitudeRef(result, remainder, n, d, instDiv2u);
+    }
+}
+
+/**
+ * Bit-serial number of set bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of set bits
+ */
+int popcountWordRef(const word op) {
+    int n = 0;
+    for (int b = 0; b <= wordtopbit; b++) {
+        n += getBitOfWord(op, b);
+    }
+    return n;
+}
+
+/**
+ * Bit-serial number of leading zero bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of leading zero bits, or wordsize for zero
+ */
+int clzWordRef(const word op) {
+    int n = 0;
+    for (int b = wordtopbit; b >= 0 && getBitOfWord(op, b) == 0; b--) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Bit-serial number of trailing zero bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of trailing zero bits, or wordsize for zero
+ */
+int ctzWordRef(const word op) {
+    int n = 0;
+    for (int b = 0; b <= wordtopbit && getBitOfWord(op, b) == 0; b++) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Bit-serial reverse of the bits of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void bitReverseWordRef(word result, const word op) {
+    // copy op first, as result may be the same word
+    word w;
+    setWord(w, op);
+    for (int b = 0; b <= wordtopbit; b++) {
+        setBitOfWord(result, wordtopbit - b, getBitOfWord(w, b));
+    }
+}
+
+/**
+ * Bit-serial reverse of the bytes of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void byteSwapWordRef(word result, const word op) {
+    word w;
+    setWord(w, op);
+    for (int b = 0; b <= wordtopbit; b++) {
+        // bit b of byte k moves to bit b of byte wordbytes - 1 - k
+        setBitOfWord(result, (wordbytes - 1 - b / 8) * 8 + b % 8, getBitOfWord(w, b));
+    }
+}
+
+/**
+ * Bit-serial extract of the bits of word operand at the set
+ * bits of mask.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to extract
+ */
+void extractFieldRef(word result, const word op, const word mask) {
+    word w, m;
+    setWord(w, op);
+    setWord(m, mask);
+    setWord(result, zeroWord);
+    int k = 0;
+    for (int b = 0; b <= wordtopbit; b++) {
+        if (getBitOfWord(m, b)) {
+            setBitOfWord(result, k++, getBitOfWord(w, b));
+        }
+    }
+}
+
+/**
+ * Bit-serial deposit of the lower bits of word operand at the
+ * set bits of mask.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to deposit to
+ */
+void depositFieldRef(word result, const word op, const word mask) {
+    word w, m;
+    setWord(w, op);
+    setWord(m, mask);
+    setWord(result, zeroWord);
+    int k = 0;
+    for (int b = 0; b <= wordtopbit; b++) {
+        if (getBitOfWord(m, b)) {
+            setBitOfWord(result, b, getBitOfWord(w, k++));
+        }
+    }
+}
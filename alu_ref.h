@@ -0,0 +1,353 @@
+/*
+ * alu_ref.h
+ *
+ * This file declares the reference implementations of the
+ * arithmetic logic unit functions. These operate one bit at
+ * a time through getBitOfWord() and setBitOfWord(), and serve
+ * as the oracle against which the native engines in alu.c are
+ * checked. Each function has the same semantics as the alu.h
+ * function of the same name without the "Ref" suffix.
+ *
+ * Building with ALU_REFERENCE defined makes the alu.h functions
+ * use these implementations.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_REF_H_
+#define ALU_REF_H_
+
+#include <stdbool.h>
+#include "word.h"
+
+/**
+ * Bit-serial test whether word is less than zero.
+ *
+ * @param op the operand
+ * @return true if op is less than zero
+ */
+bool testLtWordRef(const word op);
+
+/**
+ * Bit-serial test whether word is greater than or equal to zero.
+ *
+ * @param op the operand
+ * @return true if op is greater than or equal to zero
+ */
+bool testGeWordRef(const word op);
+
+/**
+ * Bit-serial test whether word is zero.
+ *
+ * @param op the operand
+ * @return true if op is zero
+ */
+bool testEqWordRef(const word op);
+
+/**
+ * Bit-serial signed comparison of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpWordRef(const word op1, const word op2);
+
+/**
+ * Bit-serial unsigned comparison of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return -1, 0 or 1 if op1 is less than, equal to or greater than op2
+ */
+int cmpuWordRef(const word op1, const word op2);
+
+/**
+ * Bit-serial unsigned less-than test of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is less than op2
+ */
+bool cmpLtuWordRef(const word op1, const word op2);
+
+/**
+ * Bit-serial unsigned greater-or-equal test of two word operands.
+ *
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @return true if op1 is greater than or equal to op2
+ */
+bool cmpGeuWordRef(const word op1, const word op2);
+
+/**
+ * Bit-serial signed minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void sminWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial signed maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void smaxWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial unsigned minimum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void uminWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial unsigned maximum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void umaxWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial logical AND of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void andWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial logical OR of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void orWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial logical XOR of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void xorWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial logical NOT of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void notWordRef(word result, const word op);
+
+/**
+ * Bit-serial arithmetic shift word by count.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashWordRef(word result, const word op, int count);
+
+/**
+ * Bit-serial circular shift word by count.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the shift count
+ */
+void cshWordRef(word result, const word op, int count);
+
+/**
+ * Bit-serial logical shift word by count.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the shift count
+ */
+void lshWordRef(word result, const word op, int count);
+
+/**
+ * Bit-serial mask of all but lower (+) or upper (-) count
+ * bits of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the mask count
+ */
+void maskWordRef(word result, const word op, int count);
+
+/**
+ * Bit-serial negative of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void negativeWordRef(word result, const word op);
+
+/**
+ * Bit-serial ripple-carry sum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial ripple-borrow difference of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial sum of two word operands also returning carry
+ * and overflow.
+ *
+ * @param result the result
+ * @param carry the carry out, or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addCarryWordRef(word result, bit *carry, bit *overflow,
+                     const word op1, const word op2);
+
+/**
+ * Bit-serial difference of two word operands also returning
+ * carry and overflow.
+ *
+ * @param result the result
+ * @param carry the carry out (set if no borrow), or NULL
+ * @param overflow the signed overflow, or NULL
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subCarryWordRef(word result, bit *carry, bit *overflow,
+                     const word op1, const word op2);
+
+/**
+ * Bit-serial shift-and-add product of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial full product of two word operands.
+ *
+ * @param hi the upper word of the product
+ * @param lo the lower word of the product
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulWideWordRef(word hi, word lo, const word op1, const word op2);
+
+/**
+ * Bit-serial restoring quotient of two word operands also
+ * returning remainder.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2WordRef(word result, word remainder, const word op1, const word op2);
+
+/**
+ * Bit-serial upper word of the product of two unsigned word
+ * operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulHighuWordRef(word result, const word op1, const word op2);
+
+/**
+ * Bit-serial restoring quotient of two unsigned word operands
+ * also returning remainder.
+ *
+ * @param result the result
+ * @param remainder the remainder
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void div2uWordRef(word result, word remainder, const word op1, const word op2);
+
+/**
+ * Bit-serial number of set bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of set bits
+ */
+int popcountWordRef(const word op);
+
+/**
+ * Bit-serial number of leading zero bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of leading zero bits, or wordsize for zero
+ */
+int clzWordRef(const word op);
+
+/**
+ * Bit-serial number of trailing zero bits of word operand.
+ *
+ * @param op the operand
+ * @return the number of trailing zero bits, or wordsize for zero
+ */
+int ctzWordRef(const word op);
+
+/**
+ * Bit-serial reverse of the bits of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void bitReverseWordRef(word result, const word op);
+
+/**
+ * Bit-serial reverse of the bytes of word operand.
+ *
+ * @param result the result
+ * @param op the operand
+ */
+void byteSwapWordRef(word result, const word op);
+
+/**
+ * Bit-serial extract of the bits of word operand at the set
+ * bits of mask.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to extract
+ */
+void extractFieldRef(word result, const word op, const word mask);
+
+/**
+ * Bit-serial deposit of the lower bits of word operand at the
+ * set bits of mask.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param mask the bits to deposit to
+ */
+void depositFieldRef(word result, const word op, const word mask);
+
+#endif /* ALU_REF_H_ */
@@ -0,0 +1,266 @@
+/*
+ * alu_replay.c
+ *
+ * This file contains a driver that replays a trace file of
+ * alu_trace.h. The trace is memory-mapped a window at a time, so
+ * traces larger than the address space or memory can be replayed,
+ * and the records of each window are replayed in place in chunks
+ * of TRACE_CHUNK records without copying or per-record allocation.
+ * Each window is unmapped once replayed, so the pages it held do
+ * not accumulate.
+ *
+ * The result file holds the result word of each record in the
+ * byte order of the trace, and the flags file one byte of
+ * TRACE_FLAG bits for each record. A summary is written to
+ * standard output.
+ *
+ * The driver can also write a trace of random records, for testing
+ * and timing a replay.
+ *
+ * Usage: alu_replay trace results flags
+ *        alu_replay -g count [-s seed] trace
+ *   -g  write a trace of count random records
+ *   -s  seed of the random records (default 1)
+ *
+ * @since 2026-10-14
+ */
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "alu_trace.h"
+
+/** number of chunks of records in each mapped window */
+#ifndef REPLAY_WINDOW_CHUNKS
+#define REPLAY_WINDOW_CHUNKS 4096
+#endif
+
+/** size of the output buffers */
+#define REPLAY_OUTPUT_BUFFER (1 << 20)
+
+/** results of one chunk */
+static word results[TRACE_CHUNK];
+
+/** flags of one chunk */
+static byte flags[TRACE_CHUNK];
+
+/** scratch buffers of the replay */
+static tracebuffer buffer;
+
+/**
+ * Returns the next value of a splitmix64 generator.
+ *
+ * @param state the generator state
+ * @return the value
+ */
+static uint64_t nextRandom(uint64_t *state) {
+	uint64_t z = (*state += 0x9E3779B97F4A7C15u);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+	return z ^ (z >> 31);
+}
+
+/**
+ * Writes a trace of random records. Shift counts are kept within
+ * one word size either side of zero so shifts are not all
+ * saturated.
+ *
+ * @param path the trace file
+ * @param count the number of records
+ * @param seed the generator seed
+ * @return 0 on success, 1 on error
+ */
+static int generate(const char *path, uint64_t count, uint64_t seed) {
+	FILE *out = fopen(path, "wb");
+	if (out == NULL) {
+		fprintf(stderr, "alu_replay: %s: %s\n", path, strerror(errno));
+		return 1;
+	}
+	setvbuf(out, NULL, _IOFBF, REPLAY_OUTPUT_BUFFER);
+
+	traceheader header;
+	traceHeader(&header);
+	fwrite(&header, sizeof(header), 1, out);
+
+	uint64_t state = seed;
+	for (uint64_t i = 0; i < count; i++) {
+		uint64_t r = nextRandom(&state);
+		traceop op = (traceop)(r % traceOps);
+		word op1, op2;
+		storeWord(op1, (uword)nextRandom(&state));
+		if (op == traceAsh || op == traceCsh || op == traceLsh || op == traceMask) {
+			storeWord(op2, (uword)((int)((r >> 32) % (2 * WORDSIZE + 1)) - WORDSIZE));
+		} else {
+			storeWord(op2, (uword)nextRandom(&state));
+		}
+		tracerecord record;
+		traceRecord(&record, op, op1, op2);
+		fwrite(&record, sizeof(record), 1, out);
+	}
+
+	if (fclose(out) != 0) {
+		fprintf(stderr, "alu_replay: %s: %s\n", path, strerror(errno));
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * Opens an output file with a large buffer.
+ *
+ * @param path the file
+ * @return the file, or NULL on error
+ */
+static FILE *openOutput(const char *path) {
+	FILE *out = fopen(path, "wb");
+	if (out == NULL) {
+		fprintf(stderr, "alu_replay: %s: %s\n", path, strerror(errno));
+		return NULL;
+	}
+	setvbuf(out, NULL, _IOFBF, REPLAY_OUTPUT_BUFFER);
+	return out;
+}
+
+/**
+ * Replays a trace, writing the result and flags files.
+ *
+ * @param path the trace file
+ * @param resultPath the result file
+ * @param flagsPath the flags file
+ * @return 0 on success, 1 on error
+ */
+static int replay(const char *path, const char *resultPath, const char *flagsPath) {
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "alu_replay: %s: %s\n", path, strerror(errno));
+		return 1;
+	}
+	struct stat st;
+	traceheader header;
+	if (fstat(fd, &st) != 0 || read(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)
+			|| !traceCheckHeader(&header)) {
+		fprintf(stderr, "alu_replay: %s: not a %d-bit %s-endian trace\n", path, WORDSIZE,
+				(wordendian == bigendian) ? "big" : "little");
+		close(fd);
+		return 1;
+	}
+	off_t size = st.st_size;
+	off_t end = (off_t)sizeof(header)
+			+ (size - (off_t)sizeof(header)) / (off_t)sizeof(tracerecord) * (off_t)sizeof(tracerecord);
+	if (end != size) {
+		fprintf(stderr, "alu_replay: %s: ignoring partial record at end\n", path);
+	}
+
+	FILE *resultOut = openOutput(resultPath);
+	FILE *flagsOut = resultOut ? openOutput(flagsPath) : NULL;
+	if (flagsOut == NULL) {
+		if (resultOut) {
+			fclose(resultOut);
+		}
+		close(fd);
+		return 1;
+	}
+
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+
+	long page = sysconf(_SC_PAGESIZE);
+	off_t window = (off_t)REPLAY_WINDOW_CHUNKS * TRACE_CHUNK;
+	uint64_t records = 0, invalid = 0;
+	int status = 0;
+	for (off_t pos = (off_t)sizeof(header); pos < end && status == 0;) {
+		// map whole records from the page boundary at or before pos
+		off_t base = pos - pos % page;
+		off_t n = (end - pos) / (off_t)sizeof(tracerecord);
+		if (n > window) {
+			n = window;
+		}
+		size_t length = (size_t)(pos - base) + (size_t)n * sizeof(tracerecord);
+		void *map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, base);
+		if (map == MAP_FAILED) {
+			fprintf(stderr, "alu_replay: %s: %s\n", path, strerror(errno));
+			status = 1;
+			break;
+		}
+		posix_madvise(map, length, POSIX_MADV_SEQUENTIAL);
+
+		const tracerecord *record = (const tracerecord *)((const byte *)map + (pos - base));
+		for (size_t i = 0; i < (size_t)n; i += TRACE_CHUNK) {
+			size_t m = ((size_t)n - i < TRACE_CHUNK) ? (size_t)n - i : TRACE_CHUNK;
+			invalid += traceReplay(results, flags, record + i, m, &buffer);
+			if (fwrite(results, sizeof(word), m, resultOut) != m
+					|| fwrite(flags, 1, m, flagsOut) != m) {
+				fprintf(stderr, "alu_replay: write error: %s\n", strerror(errno));
+				status = 1;
+				break;
+			}
+		}
+		munmap(map, length);
+		records += (uint64_t)n;
+		pos += n * (off_t)sizeof(tracerecord);
+	}
+	close(fd);
+
+	if (fclose(resultOut) != 0 || fclose(flagsOut) != 0) {
+		fprintf(stderr, "alu_replay: write error: %s\n", strerror(errno));
+		status = 1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	double seconds = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+	printf("{\"records\": %llu, \"invalid\": %llu, \"seconds\": %.3f, \"ns_per_record\": %.2f}\n",
+			(unsigned long long)records, (unsigned long long)invalid, seconds,
+			records ? seconds * 1e9 / (double)records : 0.0);
+	return status;
+}
+
+/**
+ * Prints the usage of the driver.
+ */
+static void usage(void) {
+	fprintf(stderr, "usage: alu_replay trace results flags\n"
+			"       alu_replay -g count [-s seed] trace\n");
+}
+
+/**
+ * Runs the replay or trace generation.
+ *
+ * @param argc the number of arguments
+ * @param argv the arguments
+ * @return the exit status
+ */
+int main(int argc, char *argv[]) {
+	uint64_t count = 0, seed = 1;
+	int generating = 0;
+	int i = 1;
+	for (; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+			count = strtoull(argv[++i], NULL, 10);
+			generating = 1;
+		} else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		} else {
+			usage();
+			return 2;
+		}
+	}
+
+	if (generating && argc - i == 1) {
+		return generate(argv[i], count, seed);
+	}
+	if (!generating && argc - i == 3) {
+		return replay(argv[i], argv[i + 1], argv[i + 2]);
+	}
+	usage();
+	return 2;
+}
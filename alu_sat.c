@@ -0,0 +1,378 @@
+/*
+ * alu_sat.c
+ *
+ * This file implements the saturating and fixed-point functions.
+ * The native engines detect overflow from the native result in
+ * the same pass and select the clamp without branching where
+ * they can; ALU_REFERENCE builds compose the results from the
+ * alu.h functions.
+ *
+ * @since 2026-10-14
+ */
+#include <stddef.h>
+
+#include "alu.h"
+#include "alu_native.h"
+#include "alu_sat.h"
+
+/**
+ * Clamps the fraction bits of a fixed-point multiply to
+ * 0 .. wordsize - 1.
+ *
+ * @param frac the number of fraction bits
+ * @return the clamped number
+ */
+static inline int fractionBits(int frac) {
+    return (frac < 0) ? 0 : (frac > wordtopbit) ? wordtopbit : frac;
+}
+
+#ifdef ALU_REFERENCE
+/**
+ * Sets result to the clamp for the sign of a value.
+ *
+ * @param result the result
+ * @param negative true if the value is negative
+ */
+static void clampWord(word result, bool negative) {
+    setWord(result, negative ? minWord : maxWord);
+}
+
+/**
+ * Saturates a double word to a word: the result is lo if hi is
+ * the sign extension of lo, and otherwise the clamp for the sign
+ * of hi.
+ *
+ * @param result the result
+ * @param hi the upper word
+ * @param lo the lower word
+ */
+static void saturateWord(word result, const word hi, const word lo) {
+    word sign, diff;
+    ashWord(sign, lo, -wordtopbit);
+    xorWord(diff, hi, sign);
+    if (testEqWord(diff)) {
+        setWord(result, lo);
+    } else {
+        clampWord(result, testLtWord(hi));
+    }
+}
+#else
+/**
+ * Native clamp for the sign of a value: maxWord for a sign bit
+ * of 0 and minWord, which is maxWord + 1, for a sign bit of 1.
+ *
+ * @param x the native value
+ * @return the native clamp
+ */
+static inline uword nativeClamp(uword x) {
+    return (uword)(loadWord(maxWord) + (x >> wordtopbit));
+}
+
+/**
+ * Native saturating sum.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static inline uword nativeAddSat(uword a, uword b) {
+    uword r = (uword)(a + b);
+    // overflow if the operands have the same sign and r does not
+    uword overflow = 0u - (uword)(((a ^ r) & (b ^ r)) >> wordtopbit);
+    return (r & ~overflow) | (nativeClamp(a) & overflow);
+}
+
+/**
+ * Native saturating difference.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static inline uword nativeSubSat(uword a, uword b) {
+    uword r = (uword)(a - b);
+    // overflow if the operands have different signs and r differs from a
+    uword overflow = 0u - (uword)(((a ^ b) & (a ^ r)) >> wordtopbit);
+    return (r & ~overflow) | (nativeClamp(a) & overflow);
+}
+
+/**
+ * Native saturation of a double word to a word.
+ *
+ * @param hi the upper native word
+ * @param lo the lower native word
+ * @return lo if hi is its sign extension, and otherwise the clamp
+ */
+static inline uword nativeSaturate(uword hi, uword lo) {
+    uword sign = 0u - (uword)(lo >> wordtopbit);
+    return nativeSelect(selectMask(hi == sign), lo, nativeClamp(hi));
+}
+
+/**
+ * Native saturating product.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @return the native result
+ */
+static inline uword nativeMulSat(uword a, uword b) {
+    return nativeSaturate(nativeMulHigh(a, b), nativeMul(a, b));
+}
+
+/**
+ * Native saturating arithmetic shift.
+ *
+ * @param x the native operand
+ * @param count the shift count
+ * @return the native result
+ */
+static inline uword nativeAshSat(uword x, int count) {
+    if (count <= 0) {
+        return nativeAsh(x, count);
+    }
+    // the upper c + 1 bits must all match the sign for no overflow
+    unsigned c = shiftCount(count);
+    if (c > (unsigned)wordtopbit) {
+        c = wordtopbit;
+    }
+    uword upper = upperMask(c + 1);
+    uword top = x & upper;
+    return nativeSelect(selectMask((top == 0) | (top == upper)),
+                        nativeAsh(x, count), nativeClamp(x));
+}
+
+/**
+ * Native rounded and saturated fixed-point product.
+ *
+ * @param a the first native operand
+ * @param b the second native operand
+ * @param frac the number of fraction bits, 0 .. wordtopbit
+ * @return the native result
+ */
+static inline uword nativeMulQ(uword a, uword b, int frac) {
+    uword lo = nativeMul(a, b);
+    uword hi = nativeMulHigh(a, b);
+    if (frac > 0) {
+        // add one half, which cannot overflow the double word
+        uword sum = (uword)(lo + ((uword)1 << (frac - 1)));
+        hi = (uword)(hi + (sum < lo));
+
+        // shift the double word right by frac
+        lo = (uword)((sum >> frac) | (toUnsigned(hi) << (wordsize - frac)));
+        hi = nativeAsh(hi, -frac);
+    }
+    return nativeSaturate(hi, lo);
+}
+#endif
+
+/**
+ * Saturating sum of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addSatWord(word result, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    bool negative = testLtWord(op1);
+    bit overflow;
+    addCarryWord(result, NULL, &overflow, op1, op2);
+    if (overflow) {
+        clampWord(result, negative);
+    }
+#else
+    storeWord(result, nativeAddSat(loadWord(op1), loadWord(op2)));
+#endif
+}
+
+/**
+ * Saturating difference of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subSatWord(word result, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    bool negative = testLtWord(op1);
+    bit overflow;
+    subCarryWord(result, NULL, &overflow, op1, op2);
+    if (overflow) {
+        clampWord(result, negative);
+    }
+#else
+    storeWord(result, nativeSubSat(loadWord(op1), loadWord(op2)));
+#endif
+}
+
+/**
+ * Saturating product of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulSatWord(word result, const word op1, const word op2) {
+#ifdef ALU_REFERENCE
+    word hi, lo;
+    mulWideWord(hi, lo, op1, op2);
+    saturateWord(result, hi, lo);
+#else
+    storeWord(result, nativeMulSat(loadWord(op1), loadWord(op2)));
+#endif
+}
+
+/**
+ * Saturating arithmetic shift word by count.
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashSatWord(word result, const word op, int count) {
+#ifdef ALU_REFERENCE
+    // the left shift lost bits if shifting back does not restore op
+    word shifted, back, diff;
+    ashWord(shifted, op, count);
+    if (count > 0) {
+        ashWord(back, shifted, -count);
+        xorWord(diff, back, op);
+        if (!testEqWord(diff)) {
+            clampWord(shifted, testLtWord(op));
+        }
+    }
+    setWord(result, shifted);
+#else
+    storeWord(result, nativeAshSat(loadWord(op), count));
+#endif
+}
+
+/**
+ * Fixed-point product of two words with frac fraction bits,
+ * rounded to nearest with halves rounded up, and saturated.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param frac the number of fraction bits
+ */
+void mulQWord(word result, const word op1, const word op2, int frac) {
+    frac = fractionBits(frac);
+#ifdef ALU_REFERENCE
+    word hi, lo;
+    mulWideWord(hi, lo, op1, op2);
+    if (frac > 0) {
+        // add one half, carrying into the upper word
+        word half, carry, low, high;
+        bit c;
+        setWord(half, zeroWord);
+        setBitOfWord(half, frac - 1, 1);
+        addCarryWord(lo, &c, NULL, lo, half);
+        setWord(carry, zeroWord);
+        setBitOfWord(carry, 0, c);
+        addWord(hi, hi, carry);
+
+        // shift the double word right by frac
+        lshWord(low, lo, -frac);
+        lshWord(high, hi, wordsize - frac);
+        orWord(lo, low, high);
+        ashWord(hi, hi, -frac);
+    }
+    saturateWord(result, hi, lo);
+#else
+    storeWord(result, nativeMulQ(loadWord(op1), loadWord(op2), frac));
+#endif
+}
+
+/**
+ * Saturating sums of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addSatWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        addSatWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], nativeAddSat(loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Saturating differences of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subSatWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        subSatWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], nativeSubSat(loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Saturating products of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulSatWordN(word *result, const word *op1, const word *op2, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        mulSatWord(result[i], op1[i], op2[i]);
+#else
+        storeWord(result[i], nativeMulSat(loadWord(op1[i]), loadWord(op2[i])));
+#endif
+    }
+}
+
+/**
+ * Saturating arithmetic shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void ashSatWordN(word *result, const word *op, int count, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        ashSatWord(result[i], op[i], count);
+#else
+        storeWord(result[i], nativeAshSat(loadWord(op[i]), count));
+#endif
+    }
+}
+
+/**
+ * Fixed-point products of word operands element by element,
+ * as mulQWord().
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param frac the number of fraction bits
+ * @param n the number of elements
+ */
+void mulQWordN(word *result, const word *op1, const word *op2, int frac, size_t n) {
+    frac = fractionBits(frac);
+    for (size_t i = 0; i < n; i++) {
+#ifdef ALU_REFERENCE
+        mulQWord(result[i], op1[i], op2[i], frac);
+#else
+        storeWord(result[i], nativeMulQ(loadWord(op1[i]), loadWord(op2[i]), frac));
+#endif
+    }
+}
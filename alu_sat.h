@@ -0,0 +1,140 @@
+/*
+ * alu_sat.h
+ *
+ * This file declares saturating versions of the arithmetic logic
+ * unit functions and fixed-point multiply for DSP-style Q-format
+ * arithmetic, where a word holds a signed fraction with frac
+ * fraction bits: Q15 is a 16-bit word with 15 fraction bits, and
+ * Q31 a 32-bit word with 31.
+ *
+ * A result that does not fit in a word is clamped to maxWord or
+ * minWord, so an overflow needs no separate test and clamp. Each
+ * result may be the same word as one of the operands, and the
+ * batch forms follow the aliasing rules of alu_batch.h.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_SAT_H_
+#define ALU_SAT_H_
+
+#include <stddef.h>
+#include "word.h"
+
+/**
+ * Saturating sum of two word operands.
+ *
+ * Examples:
+ *   addSat(0111 1111 1111 1111, 0000 0000 0000 0001) -> 0111 1111 1111 1111
+ *   addSat(1000 0000 0000 0000, 1111 1111 1111 1111) -> 1000 0000 0000 0000
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void addSatWord(word result, const word op1, const word op2);
+
+/**
+ * Saturating difference of two word operands.
+ *
+ * Examples:
+ *   subSat(1000 0000 0000 0000, 0000 0000 0000 0001) -> 1000 0000 0000 0000
+ *   subSat(0000 0000 0000 0000, 1000 0000 0000 0000) -> 0111 1111 1111 1111
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void subSatWord(word result, const word op1, const word op2);
+
+/**
+ * Saturating product of two word operands.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+void mulSatWord(word result, const word op1, const word op2);
+
+/**
+ * Saturating arithmetic shift word by count. A left (+) shift
+ * multiplies by 2 to the count, clamping a product that does not
+ * fit; a right (-) shift is the same as ashWord().
+ *
+ * Examples:
+ *   ashSat(0000 0000 0000 0011, 14)  -> 0111 1111 1111 1111
+ *   ashSat(1111 1111 1111 1101, 2)   -> 1111 1111 1111 0100
+ *
+ * @param result the result
+ * @param op the operand
+ * @param count the shift count
+ */
+void ashSatWord(word result, const word op, int count);
+
+/**
+ * Fixed-point product of two words with frac fraction bits,
+ * rounded to nearest with halves rounded up, and saturated.
+ * The product is (op1 * op2 + 2^(frac - 1)) >> frac for the
+ * double-word product, so with frac of wordsize - 1 a full
+ * Q-format multiply of -1.0 by -1.0 gives maxWord. Counts
+ * outside 0 .. wordsize - 1 are clamped.
+ *
+ * @param result the result
+ * @param op1 the first operand
+ * @param op2 the second operand
+ * @param frac the number of fraction bits
+ */
+void mulQWord(word result, const word op1, const word op2, int frac);
+
+/**
+ * Saturating sums of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void addSatWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Saturating differences of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void subSatWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Saturating products of word operands element by element.
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param n the number of elements
+ */
+void mulSatWordN(word *result, const word *op1, const word *op2, size_t n);
+
+/**
+ * Saturating arithmetic shift of each word by count.
+ *
+ * @param result the result array
+ * @param op the operand array
+ * @param count the shift count
+ * @param n the number of elements
+ */
+void ashSatWordN(word *result, const word *op, int count, size_t n);
+
+/**
+ * Fixed-point products of word operands element by element,
+ * as mulQWord().
+ *
+ * @param result the result array
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param frac the number of fraction bits
+ * @param n the number of elements
+ */
+void mulQWordN(word *result, const word *op1, const word *op2, int frac, size_t n);
+
+#endif /* ALU_SAT_H_ */
@@ -0,0 +1,764 @@
+/*
+ * alu_simd.c
+ *
+ * This file implements the SIMD kernel sets behind the batch
+ * functions and their run time selection. Words are loaded
+ * several at a time and, where the operation depends on bit
+ * order, byte swapped within each lane from the wordendian
+ * layout to host order and back.
+ *
+ * @since 2026-10-14
+ */
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "alu_native.h"
+#include "alu_simd.h"
+
+// the kernels operate on 32-bit lanes, so other word sizes use the scalar set
+#if !defined(ALU_NO_SIMD) && WORDSIZE == 32 && defined(__GNUC__) \
+	&& (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define ALU_SIMD_X86 1
+#include <immintrin.h>
+#elif !defined(ALU_NO_SIMD) && WORDSIZE == 32 && defined(__ARM_NEON) && defined(__aarch64__)
+#define ALU_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+/** lanes must be byte swapped if word and host byte orders differ */
+#ifdef WORD_SWAPPED_ORDER
+#define laneSwap true
+#else
+#define laneSwap false
+#endif
+
+/** kernel set with no kernels, leaving all work to the scalar engine */
+static const simdkernels scalarKernels = { .name = "scalar" };
+
+#ifdef ALU_SIMD_X86
+
+/*
+ * SSE2 kernels: 4 words per vector. SSE2 has no per-lane
+ * shifts, so those are left to the scalar engine.
+ */
+
+/**
+ * Load 4 words.
+ *
+ * @param op the first word
+ * @return the vector
+ */
+static inline __m128i sse2Load(const word *op) {
+	return _mm_loadu_si128((const __m128i *)op);
+}
+
+/**
+ * Store 4 words.
+ *
+ * @param result the first word
+ * @param v the vector
+ */
+static inline void sse2Store(word *result, __m128i v) {
+	_mm_storeu_si128((__m128i *)result, v);
+}
+
+/**
+ * Convert each lane between word and host byte order.
+ *
+ * @param v the vector
+ * @return the swapped vector
+ */
+static inline __m128i sse2Swap(__m128i v) {
+	if (!laneSwap) {
+		return v;
+	}
+	// swap bytes within 16-bit halves, then swap the halves
+	v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+	return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static size_t sse2AndWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		sse2Store(result + i, _mm_and_si128(sse2Load(op1 + i), sse2Load(op2 + i)));
+	}
+	return i;
+}
+
+static size_t sse2OrWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		sse2Store(result + i, _mm_or_si128(sse2Load(op1 + i), sse2Load(op2 + i)));
+	}
+	return i;
+}
+
+static size_t sse2XorWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		sse2Store(result + i, _mm_xor_si128(sse2Load(op1 + i), sse2Load(op2 + i)));
+	}
+	return i;
+}
+
+static size_t sse2NotWords(word *result, const word *op, size_t n) {
+	const __m128i ones = _mm_set1_epi32(-1);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		sse2Store(result + i, _mm_xor_si128(sse2Load(op + i), ones));
+	}
+	return i;
+}
+
+static size_t sse2AddWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i a = sse2Swap(sse2Load(op1 + i));
+		__m128i b = sse2Swap(sse2Load(op2 + i));
+		sse2Store(result + i, sse2Swap(_mm_add_epi32(a, b)));
+	}
+	return i;
+}
+
+static size_t sse2SubWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i a = sse2Swap(sse2Load(op1 + i));
+		__m128i b = sse2Swap(sse2Load(op2 + i));
+		sse2Store(result + i, sse2Swap(_mm_sub_epi32(a, b)));
+	}
+	return i;
+}
+
+static size_t sse2AshWords(word *result, const word *op, int count, size_t n) {
+	// vector shifts by wordsize or more saturate like the scalar clamp
+	__m128i c = _mm_cvtsi32_si128((int)shiftCount(count));
+	const __m128i top = _mm_set1_epi32((int)topBit);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i x = sse2Swap(sse2Load(op + i));
+		__m128i r;
+		if (count < 0) {
+			r = _mm_sra_epi32(x, c);
+		} else {
+			r = _mm_or_si128(_mm_andnot_si128(top, _mm_sll_epi32(x, c)),
+							 _mm_and_si128(top, x));
+		}
+		sse2Store(result + i, sse2Swap(r));
+	}
+	return i;
+}
+
+static size_t sse2CshWords(word *result, const word *op, int count, size_t n) {
+	unsigned s = (unsigned)count & (wordsize - 1);
+	__m128i cl = _mm_cvtsi32_si128((int)s);
+	__m128i cr = _mm_cvtsi32_si128((int)(wordsize - s));
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i x = sse2Swap(sse2Load(op + i));
+		__m128i r = _mm_or_si128(_mm_sll_epi32(x, cl), _mm_srl_epi32(x, cr));
+		sse2Store(result + i, sse2Swap(r));
+	}
+	return i;
+}
+
+static size_t sse2LshWords(word *result, const word *op, int count, size_t n) {
+	// vector shifts by wordsize or more clear the lane
+	__m128i c = _mm_cvtsi32_si128((int)shiftCount(count));
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i x = sse2Swap(sse2Load(op + i));
+		__m128i r = (count < 0) ? _mm_srl_epi32(x, c) : _mm_sll_epi32(x, c);
+		sse2Store(result + i, sse2Swap(r));
+	}
+	return i;
+}
+
+static size_t sse2TestLtWords(uint64_t *mask, const word *op, size_t n) {
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 4) {
+			__m128 x = _mm_castsi128_ps(sse2Swap(sse2Load(op + i + j)));
+			m |= (uint64_t)_mm_movemask_ps(x) << j;  // sign bit of each lane
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+static size_t sse2TestGeWords(uint64_t *mask, const word *op, size_t n) {
+	size_t i = sse2TestLtWords(mask, op, n);
+	for (size_t m = 0; m < i / 64; m++) {
+		mask[m] = ~mask[m];
+	}
+	return i;
+}
+
+static size_t sse2TestEqWords(uint64_t *mask, const word *op, size_t n) {
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 4) {
+			__m128i eq = _mm_cmpeq_epi32(sse2Load(op + i + j), zero);
+			m |= (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(eq)) << j;
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+/** SSE2 kernel set */
+static const simdkernels sse2Kernels = {
+	.name = "sse2",
+	.andWords = sse2AndWords,
+	.orWords = sse2OrWords,
+	.xorWords = sse2XorWords,
+	.notWords = sse2NotWords,
+	.addWords = sse2AddWords,
+	.subWords = sse2SubWords,
+	.ashWords = sse2AshWords,
+	.cshWords = sse2CshWords,
+	.lshWords = sse2LshWords,
+	.testLtWords = sse2TestLtWords,
+	.testGeWords = sse2TestGeWords,
+	.testEqWords = sse2TestEqWords,
+};
+
+/*
+ * AVX2 kernels: 8 words per vector, including per-lane shifts.
+ * Compiled for AVX2 with a target attribute and only selected
+ * when the CPU supports it.
+ */
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static inline __m256i avx2Load(const word *op) {
+	return _mm256_loadu_si256((const __m256i *)op);
+}
+
+AVX2 static inline void avx2Store(word *result, __m256i v) {
+	_mm256_storeu_si256((__m256i *)result, v);
+}
+
+AVX2 static inline __m256i avx2Swap(__m256i v) {
+	if (!laneSwap) {
+		return v;
+	}
+	const __m256i order = _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+	return _mm256_shuffle_epi8(v, order);
+}
+
+AVX2 static size_t avx2AndWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		avx2Store(result + i, _mm256_and_si256(avx2Load(op1 + i), avx2Load(op2 + i)));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2OrWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		avx2Store(result + i, _mm256_or_si256(avx2Load(op1 + i), avx2Load(op2 + i)));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2XorWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		avx2Store(result + i, _mm256_xor_si256(avx2Load(op1 + i), avx2Load(op2 + i)));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2NotWords(word *result, const word *op, size_t n) {
+	const __m256i ones = _mm256_set1_epi32(-1);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		avx2Store(result + i, _mm256_xor_si256(avx2Load(op + i), ones));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2AddWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i a = avx2Swap(avx2Load(op1 + i));
+		__m256i b = avx2Swap(avx2Load(op2 + i));
+		avx2Store(result + i, avx2Swap(_mm256_add_epi32(a, b)));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2SubWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i a = avx2Swap(avx2Load(op1 + i));
+		__m256i b = avx2Swap(avx2Load(op2 + i));
+		avx2Store(result + i, avx2Swap(_mm256_sub_epi32(a, b)));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2AshWords(word *result, const word *op, int count, size_t n) {
+	__m128i c = _mm_cvtsi32_si128((int)shiftCount(count));
+	const __m256i top = _mm256_set1_epi32((int)topBit);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i r;
+		if (count < 0) {
+			r = _mm256_sra_epi32(x, c);
+		} else {
+			r = _mm256_or_si256(_mm256_andnot_si256(top, _mm256_sll_epi32(x, c)),
+								_mm256_and_si256(top, x));
+		}
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2CshWords(word *result, const word *op, int count, size_t n) {
+	unsigned s = (unsigned)count & (wordsize - 1);
+	__m128i cl = _mm_cvtsi32_si128((int)s);
+	__m128i cr = _mm_cvtsi32_si128((int)(wordsize - s));
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i r = _mm256_or_si256(_mm256_sll_epi32(x, cl), _mm256_srl_epi32(x, cr));
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2LshWords(word *result, const word *op, int count, size_t n) {
+	__m128i c = _mm_cvtsi32_si128((int)shiftCount(count));
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i r = (count < 0) ? _mm256_srl_epi32(x, c) : _mm256_sll_epi32(x, c);
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+/*
+ * Per-lane shifts take the count magnitude with abs, which maps
+ * the most negative count to itself; as an unsigned shift count
+ * it is beyond wordsize, giving the same result as the clamp.
+ */
+
+AVX2 static size_t avx2AshWordsv(word *result, const word *op, const int *count, size_t n) {
+	const __m256i top = _mm256_set1_epi32((int)topBit);
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i c = _mm256_loadu_si256((const __m256i *)(count + i));
+		__m256i m = _mm256_abs_epi32(c);
+		__m256i right = _mm256_srav_epi32(x, m);
+		__m256i left = _mm256_or_si256(_mm256_andnot_si256(top, _mm256_sllv_epi32(x, m)),
+									   _mm256_and_si256(top, x));
+		__m256i r = _mm256_blendv_epi8(left, right, _mm256_cmpgt_epi32(zero, c));
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2CshWordsv(word *result, const word *op, const int *count, size_t n) {
+	const __m256i bits = _mm256_set1_epi32(wordsize);
+	const __m256i modulo = _mm256_set1_epi32(wordsize - 1);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i c = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(count + i)), modulo);
+		__m256i r = _mm256_or_si256(_mm256_sllv_epi32(x, c),
+									_mm256_srlv_epi32(x, _mm256_sub_epi32(bits, c)));
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2LshWordsv(word *result, const word *op, const int *count, size_t n) {
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i x = avx2Swap(avx2Load(op + i));
+		__m256i c = _mm256_loadu_si256((const __m256i *)(count + i));
+		__m256i m = _mm256_abs_epi32(c);
+		__m256i r = _mm256_blendv_epi8(_mm256_sllv_epi32(x, m), _mm256_srlv_epi32(x, m),
+									   _mm256_cmpgt_epi32(zero, c));
+		avx2Store(result + i, avx2Swap(r));
+	}
+	return i;
+}
+
+AVX2 static size_t avx2TestLtWords(uint64_t *mask, const word *op, size_t n) {
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 8) {
+			__m256 x = _mm256_castsi256_ps(avx2Swap(avx2Load(op + i + j)));
+			m |= (uint64_t)_mm256_movemask_ps(x) << j;  // sign bit of each lane
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+AVX2 static size_t avx2TestGeWords(uint64_t *mask, const word *op, size_t n) {
+	size_t i = avx2TestLtWords(mask, op, n);
+	for (size_t m = 0; m < i / 64; m++) {
+		mask[m] = ~mask[m];
+	}
+	return i;
+}
+
+AVX2 static size_t avx2TestEqWords(uint64_t *mask, const word *op, size_t n) {
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 8) {
+			__m256i eq = _mm256_cmpeq_epi32(avx2Load(op + i + j), zero);
+			m |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq)) << j;
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+/** AVX2 kernel set */
+static const simdkernels avx2Kernels = {
+	.name = "avx2",
+	.andWords = avx2AndWords,
+	.orWords = avx2OrWords,
+	.xorWords = avx2XorWords,
+	.notWords = avx2NotWords,
+	.addWords = avx2AddWords,
+	.subWords = avx2SubWords,
+	.ashWords = avx2AshWords,
+	.cshWords = avx2CshWords,
+	.lshWords = avx2LshWords,
+	.ashWordsv = avx2AshWordsv,
+	.cshWordsv = avx2CshWordsv,
+	.lshWordsv = avx2LshWordsv,
+	.testLtWords = avx2TestLtWords,
+	.testGeWords = avx2TestGeWords,
+	.testEqWords = avx2TestEqWords,
+};
+
+#endif /* ALU_SIMD_X86 */
+
+#ifdef ALU_SIMD_NEON
+
+/*
+ * NEON kernels: 4 words per vector, including per-lane shifts.
+ * NEON shifts left by a signed count in each lane and right for
+ * a negative count, using only the low byte of the count, so
+ * counts are clamped to +/-wordsize first.
+ */
+
+static inline uint32x4_t neonLoad(const word *op) {
+	return vreinterpretq_u32_u8(vld1q_u8((const uint8_t *)op));
+}
+
+static inline void neonStore(word *result, uint32x4_t v) {
+	vst1q_u8((uint8_t *)result, vreinterpretq_u8_u32(v));
+}
+
+static inline uint32x4_t neonSwap(uint32x4_t v) {
+	if (!laneSwap) {
+		return v;
+	}
+	return vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(v)));
+}
+
+/**
+ * Clamp shift counts to +/-limit.
+ *
+ * @param c the counts
+ * @param limit the largest count magnitude
+ * @return the clamped counts
+ */
+static inline int32x4_t neonClamp(int32x4_t c, int limit) {
+	return vmaxq_s32(vminq_s32(c, vdupq_n_s32(limit)), vdupq_n_s32(-limit));
+}
+
+/**
+ * Combine the low bit of each lane into a 4-bit mask.
+ *
+ * @param bits the lanes, each 0 or 1
+ * @return the mask
+ */
+static inline uint64_t neonMoveMask(uint32x4_t bits) {
+	const uint32_t weights[4] = {1, 2, 4, 8};
+	return vaddvq_u32(vmulq_u32(bits, vld1q_u32(weights)));
+}
+
+static size_t neonAndWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, vandq_u32(neonLoad(op1 + i), neonLoad(op2 + i)));
+	}
+	return i;
+}
+
+static size_t neonOrWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, vorrq_u32(neonLoad(op1 + i), neonLoad(op2 + i)));
+	}
+	return i;
+}
+
+static size_t neonXorWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, veorq_u32(neonLoad(op1 + i), neonLoad(op2 + i)));
+	}
+	return i;
+}
+
+static size_t neonNotWords(word *result, const word *op, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, vmvnq_u32(neonLoad(op + i)));
+	}
+	return i;
+}
+
+static size_t neonAddWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		uint32x4_t a = neonSwap(neonLoad(op1 + i));
+		uint32x4_t b = neonSwap(neonLoad(op2 + i));
+		neonStore(result + i, neonSwap(vaddq_u32(a, b)));
+	}
+	return i;
+}
+
+static size_t neonSubWords(word *result, const word *op1, const word *op2, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		uint32x4_t a = neonSwap(neonLoad(op1 + i));
+		uint32x4_t b = neonSwap(neonLoad(op2 + i));
+		neonStore(result + i, neonSwap(vsubq_u32(a, b)));
+	}
+	return i;
+}
+
+/**
+ * Arithmetic shift of 4 lanes by clamped per-lane counts.
+ *
+ * @param x the lanes in host order
+ * @param c the counts, clamped to +/-wordtopbit
+ * @return the shifted lanes
+ */
+static inline uint32x4_t neonAsh(uint32x4_t x, int32x4_t c) {
+	const uint32x4_t top = vdupq_n_u32(topBit);
+	uint32x4_t right = vreinterpretq_u32_s32(vshlq_s32(vreinterpretq_s32_u32(x), c));
+	uint32x4_t left = vorrq_u32(vbicq_u32(vshlq_u32(x, c), top), vandq_u32(x, top));
+	return vbslq_u32(vcgeq_s32(c, vdupq_n_s32(0)), left, right);
+}
+
+/**
+ * Circular shift of 4 lanes by per-lane counts.
+ *
+ * @param x the lanes in host order
+ * @param c the counts
+ * @return the rotated lanes
+ */
+static inline uint32x4_t neonCsh(uint32x4_t x, int32x4_t c) {
+	int32x4_t s = vandq_s32(c, vdupq_n_s32(wordsize - 1));
+	return vorrq_u32(vshlq_u32(x, s), vshlq_u32(x, vsubq_s32(s, vdupq_n_s32(wordsize))));
+}
+
+static size_t neonAshWords(word *result, const word *op, int count, size_t n) {
+	int32x4_t c = neonClamp(vdupq_n_s32(count), wordtopbit);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, neonSwap(neonAsh(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonCshWords(word *result, const word *op, int count, size_t n) {
+	int32x4_t c = vdupq_n_s32(count);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, neonSwap(neonCsh(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonLshWords(word *result, const word *op, int count, size_t n) {
+	int32x4_t c = neonClamp(vdupq_n_s32(count), wordsize);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		neonStore(result + i, neonSwap(vshlq_u32(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonAshWordsv(word *result, const word *op, const int *count, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		int32x4_t c = neonClamp(vld1q_s32(count + i), wordtopbit);
+		neonStore(result + i, neonSwap(neonAsh(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonCshWordsv(word *result, const word *op, const int *count, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		int32x4_t c = vld1q_s32(count + i);
+		neonStore(result + i, neonSwap(neonCsh(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonLshWordsv(word *result, const word *op, const int *count, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		int32x4_t c = neonClamp(vld1q_s32(count + i), wordsize);
+		neonStore(result + i, neonSwap(vshlq_u32(neonSwap(neonLoad(op + i)), c)));
+	}
+	return i;
+}
+
+static size_t neonTestLtWords(uint64_t *mask, const word *op, size_t n) {
+	const uint32x4_t one = vdupq_n_u32(1);
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 4) {
+			int32x4_t x = vreinterpretq_s32_u32(neonSwap(neonLoad(op + i + j)));
+			m |= neonMoveMask(vandq_u32(vcltzq_s32(x), one)) << j;
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+static size_t neonTestGeWords(uint64_t *mask, const word *op, size_t n) {
+	size_t i = neonTestLtWords(mask, op, n);
+	for (size_t m = 0; m < i / 64; m++) {
+		mask[m] = ~mask[m];
+	}
+	return i;
+}
+
+static size_t neonTestEqWords(uint64_t *mask, const word *op, size_t n) {
+	const uint32x4_t one = vdupq_n_u32(1);
+	size_t i = 0;
+	for (; i + 64 <= n; i += 64) {
+		uint64_t m = 0;
+		for (int j = 0; j < 64; j += 4) {
+			uint32x4_t eq = vceqzq_u32(neonLoad(op + i + j));
+			m |= neonMoveMask(vandq_u32(eq, one)) << j;
+		}
+		mask[i / 64] = m;
+	}
+	return i;
+}
+
+/** NEON kernel set */
+static const simdkernels neonKernels = {
+	.name = "neon",
+	.andWords = neonAndWords,
+	.orWords = neonOrWords,
+	.xorWords = neonXorWords,
+	.notWords = neonNotWords,
+	.addWords = neonAddWords,
+	.subWords = neonSubWords,
+	.ashWords = neonAshWords,
+	.cshWords = neonCshWords,
+	.lshWords = neonLshWords,
+	.ashWordsv = neonAshWordsv,
+	.cshWordsv = neonCshWordsv,
+	.lshWordsv = neonLshWordsv,
+	.testLtWords = neonTestLtWords,
+	.testGeWords = neonTestGeWords,
+	.testEqWords = neonTestEqWords,
+};
+
+#endif /* ALU_SIMD_NEON */
+
+/** kernel set in use, or NULL until first use */
+static _Atomic(const simdkernels *) selectedKernels = NULL;
+
+/**
+ * Returns the best kernel set supported by the CPU.
+ *
+ * @return the kernel set
+ */
+static const simdkernels *detectKernels(void) {
+#if defined(ALU_SIMD_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return &avx2Kernels;
+	}
+	return &sse2Kernels;
+#elif defined(ALU_SIMD_NEON)
+	return &neonKernels;
+#else
+	return &scalarKernels;
+#endif
+}
+
+/**
+ * Returns the kernel set used by the batch functions.
+ *
+ * @return the kernel set
+ */
+const simdkernels *simdKernels(void) {
+	const simdkernels *k = atomic_load_explicit(&selectedKernels, memory_order_acquire);
+	if (k == NULL) {
+		// detection is idempotent, so racing first calls agree
+		k = detectKernels();
+		atomic_store_explicit(&selectedKernels, k, memory_order_release);
+	}
+	return k;
+}
+
+/**
+ * Selects the kernel set with the specified name if this build
+ * has it and the CPU supports it.
+ *
+ * @param name the name of the set, or NULL for the detected set
+ * @return true if the set was selected
+ */
+bool simdSelectKernels(const char *name) {
+	const simdkernels *k = NULL;
+	if (name == NULL) {
+		k = detectKernels();
+	} else if (strcmp(name, scalarKernels.name) == 0) {
+		k = &scalarKernels;
+#if defined(ALU_SIMD_X86)
+	} else if (strcmp(name, sse2Kernels.name) == 0) {
+		k = &sse2Kernels;
+	} else if (strcmp(name, avx2Kernels.name) == 0) {
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			k = &avx2Kernels;
+		}
+#elif defined(ALU_SIMD_NEON)
+	} else if (strcmp(name, neonKernels.name) == 0) {
+		k = &neonKernels;
+#endif
+	}
+
+	if (k == NULL) {
+		return false;
+	}
+	atomic_store_explicit(&selectedKernels, k, memory_order_release);
+	return true;
+}
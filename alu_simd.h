@@ -0,0 +1,83 @@
+/*
+ * alu_simd.h
+ *
+ * This file declares the sets of SIMD kernels behind the batch
+ * functions in alu_batch.h. One set is chosen at run time from
+ * the features of the CPU: AVX2 or SSE2 on x86, NEON on AArch64,
+ * or a scalar set with no kernels on other targets and in builds
+ * with ALU_NO_SIMD defined.
+ *
+ * Each kernel processes a leading part of its arrays that is a
+ * multiple of its vector width (of 64 elements for the mask
+ * kernels) and returns the number of elements it processed. The
+ * batch function completes the rest with the scalar engine. A
+ * NULL kernel means the set has no kernel for that operation.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_SIMD_H_
+#define ALU_SIMD_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "word.h"
+
+/** kernel for a binary operation on word arrays */
+typedef size_t (*simdbinary)(word *result, const word *op1, const word *op2, size_t n);
+
+/** kernel for a unary operation on word arrays */
+typedef size_t (*simdunary)(word *result, const word *op, size_t n);
+
+/** kernel for a shift of word arrays by a uniform count */
+typedef size_t (*simdshift)(word *result, const word *op, int count, size_t n);
+
+/** kernel for a shift of word arrays by per-element counts */
+typedef size_t (*simdshiftv)(word *result, const word *op, const int *count, size_t n);
+
+/** kernel for a test of word arrays into a bitmask */
+typedef size_t (*simdmask)(uint64_t *mask, const word *op, size_t n);
+
+/** definition of a set of SIMD kernels */
+typedef struct simdkernels {
+	const char *name;	// name of the set, e.g. "avx2"
+
+	simdbinary andWords;
+	simdbinary orWords;
+	simdbinary xorWords;
+	simdunary notWords;
+	simdbinary addWords;
+	simdbinary subWords;
+
+	simdshift ashWords;
+	simdshift cshWords;
+	simdshift lshWords;
+	simdshiftv ashWordsv;
+	simdshiftv cshWordsv;
+	simdshiftv lshWordsv;
+
+	simdmask testLtWords;
+	simdmask testGeWords;
+	simdmask testEqWords;
+} simdkernels;
+
+/**
+ * Returns the kernel set used by the batch functions. The set
+ * is detected from the CPU on first use unless one was selected
+ * with simdSelectKernels().
+ *
+ * @return the kernel set
+ */
+const simdkernels *simdKernels(void);
+
+/**
+ * Selects the kernel set with the specified name if this build
+ * has it and the CPU supports it. The name "scalar" is always
+ * available, and NULL restores the detected set.
+ *
+ * @param name the name of the set, or NULL
+ * @return true if the set was selected
+ */
+bool simdSelectKernels(const char *name);
+
+#endif /* ALU_SIMD_H_ */
@@ -0,0 +1,40 @@
+/*
+ * alu_single.h
+ *
+ * This file is a single-header build of the word and arithmetic
+ * logic unit functions. It declares the word.h and alu.h API with
+ * the word accessors defined inline (WORD_INLINE).
+ *
+ * Define ALU_IMPLEMENTATION in exactly one translation unit before
+ * including this file to also compile the definitions of alu.c and
+ * the reference engines of alu_ref.c into that unit, where the
+ * compiler can inline them into the caller's loops without LTO.
+ * Other units include it without ALU_IMPLEMENTATION and link to
+ * those definitions. Do not also link alu.c or alu_ref.c, nor
+ * alu_instrument.c in ALU_INSTRUMENT builds, which compile it in.
+ *
+ * Include this file before word.h. The batch functions of
+ * alu_batch.h are not part of this build.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_SINGLE_H_
+#define ALU_SINGLE_H_
+
+#ifndef WORD_INLINE
+#define WORD_INLINE
+#endif
+
+#include "word.h"
+#include "alu.h"
+#include "alu_ref.h"
+
+#ifdef ALU_IMPLEMENTATION
+#include "alu_ref.c"
+#include "alu.c"
+#ifdef ALU_INSTRUMENT
+#include "alu_instrument.c"
+#endif
+#endif
+
+#endif /* ALU_SINGLE_H_ */
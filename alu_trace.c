@@ -0,0 +1,227 @@
+/*
+ * alu_trace.c
+ *
+ * This file implements the trace format and its replay. Each
+ * chunk of records is sorted by opcode with a counting sort into
+ * an index array, the operands of each opcode are gathered into
+ * contiguous arrays so one batch call computes them, and the
+ * results are scattered back to record order. The N and Z flags
+ * of the whole chunk are then found with two batch tests.
+ *
+ * @since 2026-10-14
+ */
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "alu_batch.h"
+#include "alu_trace.h"
+
+_Static_assert(sizeof(traceheader) == 16, "trace header must not be padded");
+_Static_assert(sizeof(tracerecord) == 4 + 2 * WORDBYTES, "trace record must not be padded");
+
+/**
+ * Initializes a trace header for the words of this build.
+ *
+ * @param header the header
+ */
+void traceHeader(traceheader *header) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, TRACE_MAGIC, sizeof(header->magic));
+    header->version = TRACE_VERSION;
+    header->wordsize = WORDSIZE;
+    header->endian = (byte)wordendian;
+}
+
+/**
+ * Returns whether a trace header is valid and matches the word
+ * size and byte order of this build.
+ *
+ * @param header the header
+ * @return true if the trace can be replayed by this build
+ */
+bool traceCheckHeader(const traceheader *header) {
+    return memcmp(header->magic, TRACE_MAGIC, sizeof(header->magic)) == 0
+        && header->version == TRACE_VERSION
+        && header->wordsize == WORDSIZE
+        && header->endian == (byte)wordendian;
+}
+
+/**
+ * Initializes a trace record.
+ *
+ * @param record the record
+ * @param op the operation
+ * @param op1 the first operand
+ * @param op2 the second operand or shift count
+ */
+void traceRecord(tracerecord *record, traceop op, const word op1, const word op2) {
+    memset(record, 0, sizeof(*record));
+    record->op = (byte)op;
+    setWord(record->op1, op1);
+    setWord(record->op2, op2);
+}
+
+/**
+ * Returns whether an operation takes a shift count as op2.
+ *
+ * @param op the operation
+ * @return true for the shift and mask operations
+ */
+static inline bool isShift(traceop op) {
+    return op == traceAsh || op == traceCsh || op == traceLsh || op == traceMask;
+}
+
+/**
+ * Returns the shift count of a word: its signed value clamped to
+ * the range of int.
+ *
+ * @param op the word
+ * @return the shift count
+ */
+static inline int countOf(const word op) {
+    intmax_t c = (sword)loadWord(op);
+    return (c < INT_MIN) ? INT_MIN : (c > INT_MAX) ? INT_MAX : (int)c;
+}
+
+/**
+ * Computes n gathered operations of one opcode into the result,
+ * carry and overflow buffers.
+ *
+ * @param op the operation
+ * @param n the number of operations
+ * @param b the buffers
+ */
+static void replayOp(traceop op, size_t n, tracebuffer *b) {
+    switch (op) {
+    case traceAdd:       addCarryWordN(b->result, b->carry, b->overflow, b->op1, b->op2, n); break;
+    case traceSub:       subCarryWordN(b->result, b->carry, b->overflow, b->op1, b->op2, n); break;
+    case traceMul:       mulWordN(b->result, b->op1, b->op2, n); break;
+    case traceDiv:       divWordN(b->result, b->op1, b->op2, n); break;
+    case traceRemainder: remainderWordN(b->result, b->op1, b->op2, n); break;
+    case traceAnd:       andWordN(b->result, b->op1, b->op2, n); break;
+    case traceOr:        orWordN(b->result, b->op1, b->op2, n); break;
+    case traceXor:       xorWordN(b->result, b->op1, b->op2, n); break;
+    case traceNot:       notWordN(b->result, b->op1, n); break;
+    case traceNegative:  negativeWordN(b->result, b->op1, n); break;
+    case traceAsh:       ashWordNv(b->result, b->op1, b->count, n); break;
+    case traceCsh:       cshWordNv(b->result, b->op1, b->count, n); break;
+    case traceLsh:       lshWordNv(b->result, b->op1, b->count, n); break;
+    case traceMask:
+        // no per-element form, so one batch for each run of equal counts
+        for (size_t k = 0; k < n;) {
+            size_t end = k + 1;
+            while (end < n && b->count[end] == b->count[k]) {
+                end++;
+            }
+            maskWordN(b->result + k, b->op1 + k, b->count[k], end - k);
+            k = end;
+        }
+        break;
+    case traceSmin:      sminWordN(b->result, b->op1, b->op2, n); break;
+    case traceSmax:      smaxWordN(b->result, b->op1, b->op2, n); break;
+    case traceUmin:      uminWordN(b->result, b->op1, b->op2, n); break;
+    case traceUmax:      umaxWordN(b->result, b->op1, b->op2, n); break;
+    default:             break;
+    }
+}
+
+/**
+ * Replays at most TRACE_CHUNK trace records.
+ *
+ * @param result the result array
+ * @param flags the flags array
+ * @param record the record array
+ * @param n the number of records
+ * @param b the scratch buffers
+ * @return the number of records with an invalid opcode
+ */
+static size_t replayChunk(word *result, byte *flags, const tracerecord *record,
+                          size_t n, tracebuffer *b) {
+    // counting sort of the records by opcode
+    size_t start[traceOps + 1] = {0};
+    size_t invalid = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (record[i].op < traceOps) {
+            start[record[i].op + 1]++;
+        } else {
+            invalid++;
+        }
+    }
+    for (int op = 0; op < traceOps; op++) {
+        start[op + 1] += start[op];
+    }
+    size_t next[traceOps];
+    memcpy(next, start, sizeof(next));
+    for (size_t i = 0; i < n; i++) {
+        if (record[i].op < traceOps) {
+            b->index[next[record[i].op]++] = (uint32_t)i;
+        } else {
+            setWord(result[i], zeroWord);
+            flags[i] = TRACE_FLAG_INVALID;
+        }
+    }
+
+    for (int op = 0; op < traceOps; op++) {
+        const uint32_t *index = b->index + start[op];
+        size_t m = start[op + 1] - start[op];
+        if (m == 0) {
+            continue;
+        }
+
+        // gather the operands, compute, and scatter the results
+        bool shift = isShift((traceop)op);
+        for (size_t k = 0; k < m; k++) {
+            const tracerecord *r = &record[index[k]];
+            setWord(b->op1[k], r->op1);
+            if (shift) {
+                b->count[k] = countOf(r->op2);
+            } else {
+                setWord(b->op2[k], r->op2);
+            }
+        }
+        replayOp((traceop)op, m, b);
+        bool carries = (op == traceAdd || op == traceSub);
+        for (size_t k = 0; k < m; k++) {
+            setWord(result[index[k]], b->result[k]);
+            flags[index[k]] = carries
+                ? (byte)((b->carry[k] ? TRACE_FLAG_C : 0) | (b->overflow[k] ? TRACE_FLAG_V : 0))
+                : 0;
+        }
+    }
+
+    testLtWordN(b->negative, result, n);
+    testEqWordN(b->zero, result, n);
+    for (size_t i = 0; i < n; i++) {
+        if (!(flags[i] & TRACE_FLAG_INVALID)) {
+            flags[i] |= (byte)((b->negative[i] ? TRACE_FLAG_N : 0) | (b->zero[i] ? TRACE_FLAG_Z : 0));
+        }
+    }
+    return invalid;
+}
+
+/**
+ * Replays trace records. Records are replayed in chunks of up to
+ * TRACE_CHUNK: the operands of each chunk are gathered by opcode
+ * and each opcode is computed with one call of its batch function.
+ * Result i and flags i are those of record i. A record with an
+ * invalid opcode has a zero result and the flag TRACE_FLAG_INVALID.
+ *
+ * @param result the result array
+ * @param flags the flags array
+ * @param record the record array
+ * @param n the number of records
+ * @param buffer the scratch buffers
+ * @return the number of records with an invalid opcode
+ */
+size_t traceReplay(word *result, byte *flags, const tracerecord *record,
+                   size_t n, tracebuffer *buffer) {
+    size_t invalid = 0;
+    for (size_t i = 0; i < n; i += TRACE_CHUNK) {
+        size_t m = (n - i < TRACE_CHUNK) ? n - i : TRACE_CHUNK;
+        invalid += replayChunk(result + i, flags + i, record + i, m, buffer);
+    }
+    return invalid;
+}
@@ -0,0 +1,148 @@
+/*
+ * alu_trace.h
+ *
+ * This file declares a binary trace format of arithmetic logic
+ * unit operations and the function that replays a trace through
+ * the batch functions of alu_batch.h.
+ *
+ * A trace file is a traceheader followed by tracerecords. Each
+ * record holds an opcode and two word operands in the byte order
+ * of word.h, so a record is 4 + 2 * WORDBYTES bytes with no
+ * padding, and the records of a memory-mapped file can be read in
+ * place. The header records the word size and byte order of the
+ * build that wrote the trace, and a trace is only replayed by a
+ * build with the same ones.
+ *
+ * The unary operations ignore op2. The shift count of the shift
+ * and mask operations is op2 as a signed word, clamped to the
+ * range of int.
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_TRACE_H_
+#define ALU_TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "word.h"
+
+/** magic number at the start of a trace file */
+#define TRACE_MAGIC "ALUTRACE"
+
+/** version of the trace format */
+#define TRACE_VERSION 1
+
+/** maximum number of records replayed as one batch */
+#ifndef TRACE_CHUNK
+#define TRACE_CHUNK 4096
+#endif
+
+/** flag bits of a replayed record */
+#define TRACE_FLAG_V 0x01        // overflow, from add and sub
+#define TRACE_FLAG_C 0x02        // carry, from add and sub
+#define TRACE_FLAG_Z 0x04        // result is zero
+#define TRACE_FLAG_N 0x08        // sign bit of the result
+#define TRACE_FLAG_INVALID 0x10  // opcode is not a traceop
+
+/** operations of a trace record */
+typedef enum traceop {
+    traceAdd,        // addWord, with carry and overflow
+    traceSub,        // subWord, with carry and overflow
+    traceMul,        // mulWord
+    traceDiv,        // divWord
+    traceRemainder,  // remainderWord
+    traceAnd,        // andWord
+    traceOr,         // orWord
+    traceXor,        // xorWord
+    traceNot,        // notWord of op1
+    traceNegative,   // negativeWord of op1
+    traceAsh,        // ashWord of op1 by op2
+    traceCsh,        // cshWord of op1 by op2
+    traceLsh,        // lshWord of op1 by op2
+    traceMask,       // maskWord of op1 by op2
+    traceSmin,       // sminWord
+    traceSmax,       // smaxWord
+    traceUmin,       // uminWord
+    traceUmax,       // umaxWord
+    traceOps         // number of operations
+} traceop;
+
+/** definition of the header of a trace file */
+typedef struct traceheader {
+    char magic[8];     // TRACE_MAGIC, not terminated
+    byte version;      // TRACE_VERSION
+    byte wordsize;     // WORDSIZE of the words
+    byte endian;       // byte order of the words, as wordendian
+    byte reserved[5];  // zero
+} traceheader;
+
+/** definition of a trace record */
+typedef struct tracerecord {
+    byte op;           // traceop
+    byte reserved[3];  // zero
+    word op1;          // first operand
+    word op2;          // second operand or shift count
+} tracerecord;
+
+/**
+ * Scratch buffers of a replay. A replay allocates nothing, so the
+ * caller provides these, once for any number of replays; they are
+ * too large for most thread stacks.
+ */
+typedef struct tracebuffer {
+    uint32_t index[TRACE_CHUNK];  // records of a chunk, by opcode
+    int count[TRACE_CHUNK];       // shift counts
+    word op1[TRACE_CHUNK];        // gathered first operands
+    word op2[TRACE_CHUNK];        // gathered second operands
+    word result[TRACE_CHUNK];     // results of one opcode
+    bit carry[TRACE_CHUNK];       // carries of add and sub
+    bit overflow[TRACE_CHUNK];    // overflows of add and sub
+    bool negative[TRACE_CHUNK];   // N of each result
+    bool zero[TRACE_CHUNK];       // Z of each result
+} tracebuffer;
+
+/**
+ * Initializes a trace header for the words of this build.
+ *
+ * @param header the header
+ */
+void traceHeader(traceheader *header);
+
+/**
+ * Returns whether a trace header is valid and matches the word
+ * size and byte order of this build.
+ *
+ * @param header the header
+ * @return true if the trace can be replayed by this build
+ */
+bool traceCheckHeader(const traceheader *header);
+
+/**
+ * Initializes a trace record.
+ *
+ * @param record the record
+ * @param op the operation
+ * @param op1 the first operand
+ * @param op2 the second operand or shift count
+ */
+void traceRecord(tracerecord *record, traceop op, const word op1, const word op2);
+
+/**
+ * Replays trace records. Records are replayed in chunks of up to
+ * TRACE_CHUNK: the operands of each chunk are gathered by opcode
+ * and each opcode is computed with one call of its batch function.
+ * Result i and flags i are those of record i. A record with an
+ * invalid opcode has a zero result and the flag TRACE_FLAG_INVALID.
+ *
+ * @param result the result array
+ * @param flags the flags array
+ * @param record the record array
+ * @param n the number of records
+ * @param buffer the scratch buffers
+ * @return the number of records with an invalid opcode
+ */
+size_t traceReplay(word *result, byte *flags, const tracerecord *record,
+                   size_t n, tracebuffer *buffer);
+
+#endif /* ALU_TRACE_H_ */
@@ -0,0 +1,253 @@
+/*
+ * alu_wordbuf.c
+ *
+ * This file implements the operation buffers and their arenas.
+ * An arena hands out storage by bumping an offset, and a buffer
+ * takes one aligned run of it for each column. The operations on
+ * a buffer load a block of each operand column into native
+ * integers with loadWords(), compute the results and their flags
+ * in a loop without branches that the compiler can vectorize, and
+ * store the results with storeWords().
+ *
+ * @since 2026-10-14
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alu.h"
+#include "alu_native.h"
+#include "alu_wordbuf.h"
+
+/** number of elements loaded into native integers at a time */
+#define WORDBUF_BLOCK 64
+
+/**
+ * Rounds a size up to a multiple of WORDBUF_ALIGN.
+ *
+ * @param size the size
+ * @return the rounded size
+ */
+static inline size_t alignUp(size_t size) {
+    return (size + WORDBUF_ALIGN - 1) & ~(size_t)(WORDBUF_ALIGN - 1);
+}
+
+/**
+ * Allocates the storage of an arena.
+ *
+ * @param arena the arena
+ * @param size the bytes of storage, rounded up to WORDBUF_ALIGN
+ * @return true if the storage was allocated
+ */
+bool wordArenaInit(wordarena *arena, size_t size) {
+    arena->size = alignUp(size);
+    arena->used = 0;
+    arena->base = (arena->size > 0) ? aligned_alloc(WORDBUF_ALIGN, arena->size) : NULL;
+    if (arena->base == NULL) {
+        arena->size = 0;
+        return size == 0;
+    }
+    return true;
+}
+
+/**
+ * Returns all the storage of an arena for reuse. Buffers
+ * allocated from the arena are no longer valid.
+ *
+ * @param arena the arena
+ */
+void wordArenaReset(wordarena *arena) {
+    arena->used = 0;
+}
+
+/**
+ * Frees the storage of an arena.
+ *
+ * @param arena the arena
+ */
+void wordArenaFree(wordarena *arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+}
+
+/**
+ * Returns the arena storage taken by a buffer of a capacity, for
+ * sizing arenas.
+ *
+ * @param capacity the number of elements of each column
+ * @return the bytes of storage
+ */
+size_t wordbufBytes(size_t capacity) {
+    return 3 * alignUp(capacity * sizeof(word)) + alignUp(capacity);
+}
+
+/**
+ * Allocates the columns of an empty buffer from an arena.
+ *
+ * @param buf the buffer
+ * @param arena the arena
+ * @param capacity the number of elements of each column
+ * @return true if the arena had room for the buffer
+ */
+bool wordbufInit(wordbuf *buf, wordarena *arena, size_t capacity) {
+    memset(buf, 0, sizeof(*buf));
+    if (capacity == 0) {
+        return true;
+    }
+    if (capacity > SIZE_MAX / 4 / sizeof(word)
+            || wordbufBytes(capacity) > arena->size - arena->used) {
+        return false;
+    }
+
+    // one aligned column after another
+    size_t column = alignUp(capacity * sizeof(word));
+    byte *p = arena->base + arena->used;
+    buf->op1 = (word *)p;
+    buf->op2 = (word *)(p + column);
+    buf->result = (word *)(p + 2 * column);
+    buf->flags = p + 3 * column;
+    buf->capacity = capacity;
+    arena->used += wordbufBytes(capacity);
+    return true;
+}
+
+/**
+ * Loads operations from word arrays into a buffer, replacing
+ * its operations. The results and flags are not changed.
+ *
+ * @param buf the buffer
+ * @param op1 the first operand array
+ * @param op2 the second operand array, or NULL for unary operations
+ * @param n the number of operations, at most the capacity
+ */
+void wordbufLoad(wordbuf *buf, const word *op1, const word *op2, size_t n) {
+    buf->n = n;
+    memcpy(buf->op1, op1, n * sizeof(word));
+    if (op2 != NULL) {
+        memcpy(buf->op2, op2, n * sizeof(word));
+    }
+}
+
+/**
+ * Loads operations from an array of interleaved operand pairs
+ * into a buffer, replacing its operations. The results and flags
+ * are not changed.
+ *
+ * @param buf the buffer
+ * @param pairs the pairs, with the first operand of each first
+ * @param n the number of operations, at most the capacity
+ */
+void wordbufLoadPairs(wordbuf *buf, const word (*pairs)[2], size_t n) {
+    buf->n = n;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(buf->op1[i], pairs[i][0], sizeof(word));
+        memcpy(buf->op2[i], pairs[i][1], sizeof(word));
+    }
+}
+
+/**
+ * Copies the results and flags of a buffer's operations to arrays.
+ *
+ * @param buf the buffer
+ * @param result the result array, or NULL
+ * @param flags the flags array, or NULL
+ */
+void wordbufStore(const wordbuf *buf, word *result, byte *flags) {
+    if (result != NULL) {
+        memcpy(result, buf->result, buf->n * sizeof(word));
+    }
+    if (flags != NULL) {
+        memcpy(flags, buf->flags, buf->n);
+    }
+}
+
+/**
+ * Returns the flags of a result.
+ *
+ * @param r the native result
+ * @param c the carry, 0 or 1
+ * @param v the overflow, 0 or 1
+ * @return the WORDBUF_FLAG bits
+ */
+static inline byte flagsOf(uword r, unsigned c, unsigned v) {
+    return (byte)(((unsigned)(r >> wordtopbit) << 3) | ((unsigned)(r == 0) << 2) | (c << 1) | v);
+}
+
+/**
+ * Sets the flags of each operation to the N and Z flags of its
+ * result, with C and V cleared.
+ *
+ * @param buf the buffer
+ */
+void wordbufSetFlags(wordbuf *buf) {
+    uword r[WORDBUF_BLOCK];
+    for (size_t i = 0; i < buf->n; i += WORDBUF_BLOCK) {
+        size_t m = (buf->n - i < WORDBUF_BLOCK) ? buf->n - i : WORDBUF_BLOCK;
+        loadWords(r, (const word *)buf->result + i, m);
+        byte *flags = buf->flags + i;
+        for (size_t k = 0; k < m; k++) {
+            flags[k] = flagsOf(r[k], 0, 0);
+        }
+    }
+}
+
+/**
+ * Computes op1 + op2 for each operation with its NZCV flags.
+ *
+ * @param buf the buffer
+ */
+void wordbufAddCarry(wordbuf *buf) {
+#ifdef ALU_REFERENCE
+    for (size_t i = 0; i < buf->n; i++) {
+        bit carry, overflow;
+        addCarryWord(buf->result[i], &carry, &overflow, buf->op1[i], buf->op2[i]);
+        buf->flags[i] = flagsOf(loadWord(buf->result[i]), carry, overflow);
+    }
+#else
+    uword a[WORDBUF_BLOCK], b[WORDBUF_BLOCK], r[WORDBUF_BLOCK];
+    for (size_t i = 0; i < buf->n; i += WORDBUF_BLOCK) {
+        size_t m = (buf->n - i < WORDBUF_BLOCK) ? buf->n - i : WORDBUF_BLOCK;
+        loadWords(a, (const word *)buf->op1 + i, m);
+        loadWords(b, (const word *)buf->op2 + i, m);
+        byte *flags = buf->flags + i;
+        for (size_t k = 0; k < m; k++) {
+            r[k] = a[k] + b[k];
+            flags[k] = flagsOf(r[k], r[k] < a[k], (unsigned)(((a[k] ^ r[k]) & (b[k] ^ r[k])) >> wordtopbit));
+        }
+        storeWords(buf->result + i, r, m);
+    }
+#endif
+}
+
+/**
+ * Computes op1 - op2 for each operation with its NZCV flags,
+ * C being set if there is no borrow.
+ *
+ * @param buf the buffer
+ */
+void wordbufSubCarry(wordbuf *buf) {
+#ifdef ALU_REFERENCE
+    for (size_t i = 0; i < buf->n; i++) {
+        bit carry, overflow;
+        subCarryWord(buf->result[i], &carry, &overflow, buf->op1[i], buf->op2[i]);
+        buf->flags[i] = flagsOf(loadWord(buf->result[i]), carry, overflow);
+    }
+#else
+    uword a[WORDBUF_BLOCK], b[WORDBUF_BLOCK], r[WORDBUF_BLOCK];
+    for (size_t i = 0; i < buf->n; i += WORDBUF_BLOCK) {
+        size_t m = (buf->n - i < WORDBUF_BLOCK) ? buf->n - i : WORDBUF_BLOCK;
+        loadWords(a, (const word *)buf->op1 + i, m);
+        loadWords(b, (const word *)buf->op2 + i, m);
+        byte *flags = buf->flags + i;
+        for (size_t k = 0; k < m; k++) {
+            r[k] = a[k] - b[k];
+            flags[k] = flagsOf(r[k], a[k] >= b[k], (unsigned)(((a[k] ^ b[k]) & (a[k] ^ r[k])) >> wordtopbit));
+        }
+        storeWords(buf->result + i, r, m);
+    }
+#endif
+}
@@ -0,0 +1,151 @@
+/*
+ * alu_wordbuf.h
+ *
+ * This file declares buffers of operations for the batch functions
+ * of alu_batch.h, held as a structure of arrays: a column of first
+ * operands, one of second operands, one of results and one of
+ * condition flags. Each column is contiguous and starts on a
+ * WORDBUF_ALIGN boundary, so the batch functions and their SIMD
+ * kernels stream whole cache lines of one column at a time, and a
+ * column can be passed to any batch function as its word array.
+ *
+ * Buffers are carved from an arena, a single aligned block, so a
+ * set of buffers costs one allocation and is released or reused
+ * at once with wordArenaReset(). Operations held elsewhere as
+ * word arrays or as interleaved operand pairs are converted with
+ * wordbufLoad() and wordbufLoadPairs(), and results are copied
+ * back with wordbufStore().
+ *
+ * @since 2026-10-14
+ */
+#ifndef ALU_WORDBUF_H_
+#define ALU_WORDBUF_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "word.h"
+
+/** alignment of the arena and of each column, a cache line */
+#define WORDBUF_ALIGN 64
+
+/** flag bits of the flags column, set from the result */
+#define WORDBUF_FLAG_V 0x01  // signed overflow
+#define WORDBUF_FLAG_C 0x02  // carry out, or no borrow
+#define WORDBUF_FLAG_Z 0x04  // result is zero
+#define WORDBUF_FLAG_N 0x08  // result is negative
+
+/** definition of an arena of buffer storage */
+typedef struct wordarena {
+    byte *base;   // storage, WORDBUF_ALIGN aligned
+    size_t size;  // bytes of storage
+    size_t used;  // bytes given to buffers
+} wordarena;
+
+/** definition of a buffer of operations with aligned columns */
+typedef struct wordbuf {
+    word *op1;        // first operands
+    word *op2;        // second operands
+    word *result;     // results
+    byte *flags;      // WORDBUF_FLAG bits of each result
+    size_t n;         // number of operations held
+    size_t capacity;  // number of elements of each column
+} wordbuf;
+
+/**
+ * Allocates the storage of an arena.
+ *
+ * @param arena the arena
+ * @param size the bytes of storage, rounded up to WORDBUF_ALIGN
+ * @return true if the storage was allocated
+ */
+bool wordArenaInit(wordarena *arena, size_t size);
+
+/**
+ * Returns all the storage of an arena for reuse. Buffers
+ * allocated from the arena are no longer valid.
+ *
+ * @param arena the arena
+ */
+void wordArenaReset(wordarena *arena);
+
+/**
+ * Frees the storage of an arena.
+ *
+ * @param arena the arena
+ */
+void wordArenaFree(wordarena *arena);
+
+/**
+ * Returns the arena storage taken by a buffer of a capacity, for
+ * sizing arenas.
+ *
+ * @param capacity the number of elements of each column
+ * @return the bytes of storage
+ */
+size_t wordbufBytes(size_t capacity);
+
+/**
+ * Allocates the columns of an empty buffer from an arena.
+ *
+ * @param buf the buffer
+ * @param arena the arena
+ * @param capacity the number of elements of each column
+ * @return true if the arena had room for the buffer
+ */
+bool wordbufInit(wordbuf *buf, wordarena *arena, size_t capacity);
+
+/**
+ * Loads operations from word arrays into a buffer, replacing
+ * its operations. The results and flags are not changed.
+ *
+ * @param buf the buffer
+ * @param op1 the first operand array
+ * @param op2 the second operand array, or NULL for unary operations
+ * @param n the number of operations, at most the capacity
+ */
+void wordbufLoad(wordbuf *buf, const word *op1, const word *op2, size_t n);
+
+/**
+ * Loads operations from an array of interleaved operand pairs
+ * into a buffer, replacing its operations. The results and flags
+ * are not changed.
+ *
+ * @param buf the buffer
+ * @param pairs the pairs, with the first operand of each first
+ * @param n the number of operations, at most the capacity
+ */
+void wordbufLoadPairs(wordbuf *buf, const word (*pairs)[2], size_t n);
+
+/**
+ * Copies the results and flags of a buffer's operations to arrays.
+ *
+ * @param buf the buffer
+ * @param result the result array, or NULL
+ * @param flags the flags array, or NULL
+ */
+void wordbufStore(const wordbuf *buf, word *result, byte *flags);
+
+/**
+ * Sets the flags of each operation to the N and Z flags of its
+ * result, with C and V cleared.
+ *
+ * @param buf the buffer
+ */
+void wordbufSetFlags(wordbuf *buf);
+
+/**
+ * Computes op1 + op2 for each operation with its NZCV flags.
+ *
+ * @param buf the buffer
+ */
+void wordbufAddCarry(wordbuf *buf);
+
+/**
+ * Computes op1 - op2 for each operation with its NZCV flags,
+ * C being set if there is no borrow.
+ *
+ * @param buf the buffer
+ */
+void wordbufSubCarry(wordbuf *buf);
+
+#endif /* ALU_WORDBUF_H_ */
@@ -10,8 +10,27 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
 #include "alu.h"
+#include "alu_async.h"
+#include "alu_batch.h"
+#include "alu_diff.h"
+#include "alu_divisor.h"
+#include "alu_exec.h"
+#include "alu_flags.h"
+#include "alu_instrument.h"
+#include "alu_memo.h"
+#include "alu_micro.h"
+#include "alu_mp.h"
+#include "alu_parallel.h"
+#include "alu_ref.h"
+#include "alu_sat.h"
+#include "alu_trace.h"
+#include "alu_wordbuf.h"
 #include "CUnit/CUnit.h"
 #include "CUnit/Basic.h"
 
@@ -31,6 +50,47 @@
 #define CU_ASSERT_WORD_NOT_EQUAL_FATAL(actual, expected) \
   { CU_assertImplementation((0!=memcmp((actual),(expected),wordbytes)), __LINE__, ("CU_ASSERT_WORD_NOT_EQUAL_FATAL(" #actual "," #expected ")"), __FILE__, "", CU_TRUE); }
 
+/**
+ * Test word size and native conversions for any word size
+ */
+void test_width(void) {
+	CU_ASSERT_EQUAL(sizeof(word) * 8, wordsize);
+	CU_ASSERT_EQUAL(sizeof(uword) * 8, wordsize);
+	CU_ASSERT_EQUAL(loadWord(zeroWord), 0);
+	CU_ASSERT_EQUAL(loadWord(maxWord), (uword)~((uword)1 << wordtopbit));
+	CU_ASSERT_EQUAL(loadWord(minWord), (uword)1 << wordtopbit);
+	CU_ASSERT_EQUAL((sword)loadWord(maxWord) + 1 + (sword)loadWord(minWord), 0);
+
+	// bit n of the native value is bit n of the word
+	word w;
+	uword val = (uword)0x8107F0F78107F0F7u;
+	storeWord(w, val);
+	CU_ASSERT_EQUAL(loadWord(w), val);
+	for (int b = 0; b < wordsize; b++) {
+		CU_ASSERT_EQUAL(getBitOfWord(w, b), (val >> b) & 1);
+	}
+
+	// bulk conversions agree with loadWord() and storeWord()
+	word ops[5], results[5];
+	uword vals[5];
+	for (int i = 0; i < 5; i++) {
+		storeWord(ops[i], val * (uword)(i + 1));
+	}
+	loadWords(vals, (const word *)ops, 5);
+	for (int i = 0; i < 5; i++) {
+		CU_ASSERT_EQUAL(vals[i], loadWord(ops[i]));
+	}
+	storeWords(results, vals, 5);
+	for (int i = 0; i < 5; i++) {
+		CU_ASSERT_WORD_EQUAL(results[i], ops[i]);
+	}
+	CU_ASSERT_EQUAL(swapBytes(swapBytes(val)), val);
+	CU_ASSERT_EQUAL((byte)swapBytes(val), (byte)(val >> (wordsize - 8)));
+}
+
+// the tests below use literal 32-bit big-endian words
+#if WORDSIZE == 32 && !defined(WORD_LITTLE_ENDIAN)
+
 /**
  * Test basic word functions
  */
@@ -100,6 +160,26 @@ void test_math(void) {
 	word expected8 = {0x00, 0x00, 0x00, 0x02};
 	CU_ASSERT_WORD_EQUAL(w8, expected8);
 
+	word hi6, lo6;
+	mulWideWord(hi6, lo6, w4, w4);  // -2 * -2 = 4
+	CU_ASSERT_WORD_EQUAL(lo6, expected6);
+	CU_ASSERT_WORD_EQUAL(hi6, zeroWord);
+
+	mulWideWord(hi6, lo6, w4, w2);  // -2 * 1 = -2
+	CU_ASSERT_WORD_EQUAL(lo6, expected4);
+	CU_ASSERT_WORD_EQUAL(hi6, w1);
+
+	word expectedhi = {0x3f, 0xff, 0xff, 0xff};
+	word expectedlo = {0x00, 0x00, 0x00, 0x01};
+	mulWideWord(hi6, lo6, maxWord, maxWord);  // max * max
+	CU_ASSERT_WORD_EQUAL(hi6, expectedhi);
+	CU_ASSERT_WORD_EQUAL(lo6, expectedlo);
+
+	word expectedminhi = {0x40, 0x00, 0x00, 0x00};
+	mulWideWord(hi6, lo6, minWord, minWord);  // min * min
+	CU_ASSERT_WORD_EQUAL(hi6, expectedminhi);
+	CU_ASSERT_WORD_EQUAL(lo6, zeroWord);
+
 	word w9;
 	word w10;
 	div2Word(w9, w10, w6, w8);  // 4 / 2 = 2 r 0
@@ -143,10 +223,74 @@ void test_math(void) {
 	word expected20 = {0x00, 0x00, 0x00, 0x01};  // 1
 	CU_ASSERT_WORD_EQUAL(w19, expected14);
 	CU_ASSERT_WORD_EQUAL(w20, expected20);
+
+	word w21;
+	word w22;
+	div2Word(w21, w22, minWord, w1);  // min / -1 = min r 0
+	CU_ASSERT_WORD_EQUAL(w21, minWord);
+	CU_ASSERT_WORD_EQUAL(w22, zeroWord);
+
+	word w23;
+	word w24;
+	div2Word(w23, w24, w8, zeroWord);  // 2 / 0 = maxWord r 0
+	CU_ASSERT_WORD_EQUAL(w23, maxWord);
+	CU_ASSERT_WORD_EQUAL(w24, zeroWord);
+
+	word w25;
+	word w26;
+	div2Word(w25, w26, w7, minWord);  // -3 / min = 0 r -3
+	CU_ASSERT_WORD_EQUAL(w25, zeroWord);
+	CU_ASSERT_WORD_EQUAL(w26, w7);
+
+	word w27;
+	divWord(w27, w6, w7);  // 4 / -3 = -1
+	CU_ASSERT_WORD_EQUAL(w27, expected14);
+
+	word w28;
+	remainderWord(w28, w6, w7);  // 4 % -3 = 1
+	CU_ASSERT_WORD_EQUAL(w28, expected20);
+}
+
+/**
+ * Test carry and overflow functions (addCarry, subCarry)
+ */
+void test_carry(void) {
+	word w1 = {0xff, 0xff, 0xff, 0xff};  // -1
+	word w2 = {0x00, 0x00, 0x00, 0x01};  // 1
+	word w3;
+	bit carry, overflow;
+
+	addCarryWord(w3, &carry, &overflow, w1, w2);  // -1 + 1 = 0 carry
+	CU_ASSERT_WORD_EQUAL(w3, zeroWord);
+	CU_ASSERT_EQUAL(carry, 1);
+	CU_ASSERT_EQUAL(overflow, 0);
+
+	addCarryWord(w3, &carry, &overflow, maxWord, w2);  // max + 1 overflows
+	CU_ASSERT_WORD_EQUAL(w3, minWord);
+	CU_ASSERT_EQUAL(carry, 0);
+	CU_ASSERT_EQUAL(overflow, 1);
+
+	addCarryWord(w3, &carry, &overflow, minWord, minWord);  // min + min
+	CU_ASSERT_WORD_EQUAL(w3, zeroWord);
+	CU_ASSERT_EQUAL(carry, 1);
+	CU_ASSERT_EQUAL(overflow, 1);
+
+	subCarryWord(w3, &carry, &overflow, zeroWord, w2);  // 0 - 1 borrows
+	CU_ASSERT_WORD_EQUAL(w3, w1);
+	CU_ASSERT_EQUAL(carry, 0);
+	CU_ASSERT_EQUAL(overflow, 0);
+
+	subCarryWord(w3, &carry, &overflow, minWord, w2);  // min - 1 overflows
+	CU_ASSERT_WORD_EQUAL(w3, maxWord);
+	CU_ASSERT_EQUAL(carry, 1);
+	CU_ASSERT_EQUAL(overflow, 1);
+
+	subCarryWord(w3, NULL, NULL, w2, w2);  // flags are optional
+	CU_ASSERT_WORD_EQUAL(w3, zeroWord);
 }
 
 /**
- * Test compare functions (lt, eq, ge)
+ * Test compare functions (lt, eq, ge, cmp, min, max)
  */
 void test_compare(void) {
 	word w0 = {0xff, 0xff, 0xff, 0xfe};  // -2
@@ -221,6 +365,29 @@ void test_compare(void) {
 	bool gemax = testGeWord(maxWord);  // largest word
 	CU_ASSERT_TRUE(gemax);
 
+	// test signed and unsigned compare
+	CU_ASSERT_EQUAL(cmpWord(w0, w1), -1);  // -2 < -1
+	CU_ASSERT_EQUAL(cmpWord(w1, w3), -1);  // -1 < 1
+	CU_ASSERT_EQUAL(cmpWord(w4, w3), 1);   // 2 > 1
+	CU_ASSERT_EQUAL(cmpWord(w2, zeroWord), 0);
+	CU_ASSERT_EQUAL(cmpWord(minWord, maxWord), -1);
+	CU_ASSERT_EQUAL(cmpuWord(w1, w3), 1);  // 0xffffffff > 1
+	CU_ASSERT_EQUAL(cmpuWord(minWord, maxWord), 1);
+	CU_ASSERT_EQUAL(cmpuWord(w3, w4), -1);
+	CU_ASSERT_EQUAL(cmpuWord(w1, w1), 0);
+
+	// test min and max
+	word m;
+	sminWord(m, w1, w3);
+	CU_ASSERT_WORD_EQUAL(m, w1);
+	smaxWord(m, w1, w3);
+	CU_ASSERT_WORD_EQUAL(m, w3);
+	uminWord(m, w1, w3);
+	CU_ASSERT_WORD_EQUAL(m, w3);
+	umaxWord(m, w1, w3);
+	CU_ASSERT_WORD_EQUAL(m, w1);
+	sminWord(m, maxWord, minWord);
+	CU_ASSERT_WORD_EQUAL(m, minWord);
 }
 
 /**
@@ -371,6 +538,48 @@ void test_shift(void) {
 	word lsh8;
 	lshWord(lsh8, w2, -wordsize/2);
 	CU_ASSERT_WORD_EQUAL(lsh8, w5);
+
+	word lsh9;
+	lshWord(lsh9, w10, wordsize);  // everything shifted out
+	CU_ASSERT_WORD_EQUAL(lsh9, w0);
+
+	word lsh10;
+	lshWord(lsh10, w10, -wordsize);
+	CU_ASSERT_WORD_EQUAL(lsh10, w0);
+
+	word lsh11;
+	lshWord(lsh11, w10, INT_MIN);
+	CU_ASSERT_WORD_EQUAL(lsh11, w0);
+
+	// csh by counts other than a half word
+	word w12 = {0x12, 0x34, 0x56, 0x78};
+	word w13 = {0x23, 0x45, 0x67, 0x81};
+	word w14 = {0x81, 0x23, 0x45, 0x67};
+
+	word csh10;
+	cshWord(csh10, w12, 4);
+	CU_ASSERT_WORD_EQUAL(csh10, w13);
+
+	word csh11;
+	cshWord(csh11, w12, -4);
+	CU_ASSERT_WORD_EQUAL(csh11, w14);
+
+	word csh12;
+	cshWord(csh12, w12, wordsize + 4);
+	CU_ASSERT_WORD_EQUAL(csh12, w13);
+
+	word csh13;
+	cshWord(csh13, w12, -3*wordsize - 4);
+	CU_ASSERT_WORD_EQUAL(csh13, w14);
+
+	word csh14;
+	setWord(csh14, w12);
+	cshWord(csh14, csh14, 4);  // in place
+	CU_ASSERT_WORD_EQUAL(csh14, w13);
+
+	word ash13;
+	ashWord(ash13, w7, INT_MIN);
+	CU_ASSERT_WORD_EQUAL(ash13, w10);
 }
 
 /**
@@ -489,6 +698,2298 @@ void test_logical(void) {
 	CU_ASSERT_WORD_EQUAL(mask7, w4);
 }
 
+#endif /* WORDSIZE == 32 && !WORD_LITTLE_ENDIAN */
+
+/** operand values used to compare engines, sign extended or truncated to a word */
+static const int32_t engine_vals[] = {
+	0x00000000, 0x00000001,
+	-1, -2,
+	INT32_MAX, INT32_MIN,  // replaced by maxWord and minWord
+	(int32_t)0x8107f0f7, 0x00ffff00,
+	0x12345678, (int32_t)0xdeadbeef,
+	0x00000007, -7,
+};
+
+/** number of engine operand vectors */
+#define engine_nops ((int)(sizeof(engine_vals) / sizeof(engine_vals[0])))
+
+/** operand vectors used to compare native and reference engines */
+static word engine_ops[engine_nops];
+
+/**
+ * Initialize the engine operand vectors for the word size.
+ *
+ * @return 0 on success
+ */
+static int init_engine_ops(void) {
+	for (int i = 0; i < engine_nops; i++) {
+		storeWord(engine_ops[i], (uword)(int64_t)engine_vals[i]);
+	}
+	setWord(engine_ops[4], maxWord);
+	setWord(engine_ops[5], minWord);
+	return 0;
+}
+
+/**
+ * Test that the native engines match the reference
+ * bit-serial implementations.
+ */
+void test_engines(void) {
+	for (int i = 0; i < engine_nops; i++) {
+		const byte *op1 = engine_ops[i];
+		word expected, actual;
+
+		notWordRef(expected, op1);
+		notWord(actual, op1);
+		CU_ASSERT_WORD_EQUAL(actual, expected);
+
+		negativeWordRef(expected, op1);
+		negativeWord(actual, op1);
+		CU_ASSERT_WORD_EQUAL(actual, expected);
+
+		CU_ASSERT_EQUAL(testLtWord(op1), testLtWordRef(op1));
+		CU_ASSERT_EQUAL(testGeWord(op1), testGeWordRef(op1));
+		CU_ASSERT_EQUAL(testEqWord(op1), testEqWordRef(op1));
+
+		for (int count = -2*wordsize; count <= 2*wordsize; count++) {
+			ashWordRef(expected, op1, count);
+			ashWord(actual, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			cshWordRef(expected, op1, count);
+			cshWord(actual, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			lshWordRef(expected, op1, count);
+			lshWord(actual, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			maskWordRef(expected, op1, count);
+			maskWord(actual, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+		}
+
+		maskWordRef(expected, op1, INT_MIN);
+		maskWord(actual, op1, INT_MIN);
+		CU_ASSERT_WORD_EQUAL(actual, expected);
+
+		for (int j = 0; j < engine_nops; j++) {
+			const byte *op2 = engine_ops[j];
+
+			CU_ASSERT_EQUAL(cmpWord(op1, op2), cmpWordRef(op1, op2));
+			CU_ASSERT_EQUAL(cmpuWord(op1, op2), cmpuWordRef(op1, op2));
+
+			sminWordRef(expected, op1, op2);
+			sminWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			smaxWordRef(expected, op1, op2);
+			smaxWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			uminWordRef(expected, op1, op2);
+			uminWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			umaxWordRef(expected, op1, op2);
+			umaxWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			andWordRef(expected, op1, op2);
+			andWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			orWordRef(expected, op1, op2);
+			orWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			xorWordRef(expected, op1, op2);
+			xorWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			addWordRef(expected, op1, op2);
+			addWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			subWordRef(expected, op1, op2);
+			subWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			bit ecarry, eoverflow, acarry, aoverflow;
+			addCarryWordRef(expected, &ecarry, &eoverflow, op1, op2);
+			addCarryWord(actual, &acarry, &aoverflow, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			CU_ASSERT_EQUAL(acarry, ecarry);
+			CU_ASSERT_EQUAL(aoverflow, eoverflow);
+
+			mulWordRef(expected, op1, op2);
+			mulWord(actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+
+			word ehi, ahi;
+			mulWideWordRef(ehi, expected, op1, op2);
+			mulWideWord(ahi, actual, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			CU_ASSERT_WORD_EQUAL(ahi, ehi);
+
+			word eremainder, aremainder;
+			div2WordRef(expected, eremainder, op1, op2);
+			div2Word(actual, aremainder, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			CU_ASSERT_WORD_EQUAL(aremainder, eremainder);
+
+			subCarryWordRef(expected, &ecarry, &eoverflow, op1, op2);
+			subCarryWord(actual, &acarry, &aoverflow, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			CU_ASSERT_EQUAL(acarry, ecarry);
+			CU_ASSERT_EQUAL(aoverflow, eoverflow);
+		}
+	}
+}
+
+/** number of random cases in differential tests */
+#define DIFF_N 100000
+
+/**
+ * Test the native engines against the reference engines on the
+ * edge cases and on random cases of the differential harness.
+ */
+void test_diff(void) {
+	diffmismatch m;
+	uint64_t edges = diffEdges(&m);
+	CU_ASSERT_TRUE(edges > 0);
+	if (edges == 0) {
+		diffPrint(stderr, &m);
+		fprintf(stderr, "\n");
+	}
+	bool match = diffRun(&m, 1, 0, DIFF_N);
+	CU_ASSERT_TRUE(match);
+	if (!match) {
+		diffPrint(stderr, &m);
+		fprintf(stderr, "\n");
+	}
+
+	// every function is covered, and cases do not depend on the order they run
+	CU_ASSERT_TRUE(diffRun(&m, 2, DIFF_N - diffOps, diffOps));
+	CU_ASSERT_TRUE(diffCase(&m, diffDiv2, maxWord, zeroWord, 0));
+	CU_ASSERT_TRUE(diffCase(&m, diffAsh, minWord, zeroWord, INT_MIN));
+	CU_ASSERT_STRING_EQUAL(diffName(diffRemainder), "remainderWord");
+	CU_ASSERT_PTR_NULL(diffName(diffOps));
+	CU_ASSERT_TRUE(diffHasCount(diffMask));
+	CU_ASSERT_FALSE(diffHasCount(diffMul));
+
+	// a mismatch is written with its case and both outputs
+	memset(&m, 0, sizeof(m));
+	m.op = diffMulWide;
+	m.index = 42;
+	setWord(m.op1, maxWord);
+	setWord(m.op2, minWord);
+	FILE *out = tmpfile();
+	if (out != NULL) {
+		char text[512] = "";
+		diffPrint(out, &m);
+		rewind(out);
+		CU_ASSERT_PTR_NOT_NULL(fgets(text, sizeof(text), out));
+		CU_ASSERT_PTR_NOT_NULL(strstr(text, "\"name\": \"mulWideWord\", \"case\": 42"));
+		CU_ASSERT_PTR_NOT_NULL(strstr(text, "\"result2\""));
+		fclose(out);
+	}
+}
+
+/**
+ * Test the bit-manipulation functions against examples, each
+ * other and the reference engines
+ */
+void test_bits(void) {
+	word op, mask, result, result2, expected;
+
+	// examples, placed in the low bits of any word size
+	storeWord(op, 0x16);
+	CU_ASSERT_EQUAL(popcountWord(op), 3);
+	CU_ASSERT_EQUAL(clzWord(op), wordsize - 5);
+	CU_ASSERT_EQUAL(ctzWord(op), 1);
+	bitReverseWord(result, op);
+	storeWord(expected, (uword)((uword)0x68 << (wordsize - 8)));
+	CU_ASSERT_WORD_EQUAL(result, expected);
+	byteSwapWord(result, op);
+	storeWord(expected, (uword)((uword)0x16 << (wordsize - 8)));
+	CU_ASSERT_WORD_EQUAL(result, expected);
+	CU_ASSERT_EQUAL(popcountWord(zeroWord), 0);
+	CU_ASSERT_EQUAL(clzWord(zeroWord), wordsize);
+	CU_ASSERT_EQUAL(ctzWord(zeroWord), wordsize);
+	CU_ASSERT_EQUAL(popcountWord(engine_ops[2]), wordsize);
+	CU_ASSERT_EQUAL(clzWord(minWord), 0);
+	CU_ASSERT_EQUAL(ctzWord(minWord), wordtopbit);
+	CU_ASSERT_EQUAL(clzWord(maxWord), 1);
+	bitReverseWord(result, engine_ops[1]);
+	CU_ASSERT_WORD_EQUAL(result, minWord);
+	if (wordsize >= 16) {
+		storeWord(op, (uword)0xABCDu);
+		storeWord(mask, (uword)0x0F03u);
+		extractField(result, op, mask);
+		storeWord(expected, 0x2D);
+		CU_ASSERT_WORD_EQUAL(result, expected);
+		depositField(result, expected, mask);
+		storeWord(expected, (uword)0x0B01u);
+		CU_ASSERT_WORD_EQUAL(result, expected);
+	}
+
+	// every pair of engine operands and pseudo-random words
+	uint32_t seed = 5;
+	int failures = 0;
+	for (int i = 0; i < engine_nops * engine_nops + 5000; i++) {
+		if (i < engine_nops * engine_nops) {
+			setWord(op, engine_ops[i / engine_nops]);
+			setWord(mask, engine_ops[i % engine_nops]);
+		} else {
+			for (int b = 0; b < wordbytes; b++) {
+				seed = seed * 1103515245 + 12345;
+				op[b] = (byte)(seed >> 16);
+				mask[b] = (byte)(seed >> 8);
+			}
+		}
+		failures += popcountWord(op) != popcountWordRef(op);
+		failures += clzWord(op) != clzWordRef(op);
+		failures += ctzWord(op) != ctzWordRef(op);
+
+		// reversing twice restores the word, in place
+		bitReverseWord(result, op);
+		bitReverseWordRef(expected, op);
+		failures += memcmp(result, expected, sizeof(word)) != 0;
+		bitReverseWord(result, result);
+		failures += memcmp(result, op, sizeof(word)) != 0;
+		byteSwapWord(result, op);
+		byteSwapWordRef(expected, op);
+		failures += memcmp(result, expected, sizeof(word)) != 0;
+		byteSwapWord(result, result);
+		failures += memcmp(result, op, sizeof(word)) != 0;
+
+		// deposit then extract keeps popcount(mask) low bits of op,
+		// and extract then deposit keeps the bits of op in mask
+		extractField(result, op, mask);
+		extractFieldRef(expected, op, mask);
+		failures += memcmp(result, expected, sizeof(word)) != 0;
+		depositField(result2, result, mask);
+		andWord(expected, op, mask);
+		failures += memcmp(result2, expected, sizeof(word)) != 0;
+		depositField(result, op, mask);
+		depositFieldRef(expected, op, mask);
+		failures += memcmp(result, expected, sizeof(word)) != 0;
+		extractField(result, result, mask);
+		maskWord(expected, op, popcountWord(mask));
+		failures += memcmp(result, expected, sizeof(word)) != 0;
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+}
+
+/**
+ * Test the unsigned compare, multiply and divide functions
+ */
+void test_unsigned(void) {
+	word q, r, result, expected;
+
+	// examples
+	CU_ASSERT_TRUE(cmpLtuWord(maxWord, minWord));
+	CU_ASSERT_FALSE(cmpLtuWord(engine_ops[2], engine_ops[1]));
+	CU_ASSERT_TRUE(cmpGeuWord(engine_ops[2], engine_ops[1]));
+	CU_ASSERT_TRUE(cmpGeuWord(minWord, minWord));
+	CU_ASSERT_FALSE(cmpLtuWord(minWord, minWord));
+	storeWord(result, 2);
+	mulHighuWord(result, engine_ops[2], result);
+	CU_ASSERT_WORD_EQUAL(result, engine_ops[1]);
+	storeWord(result, 2);
+	div2uWord(q, r, engine_ops[2], result);
+	CU_ASSERT_WORD_EQUAL(q, maxWord);
+	CU_ASSERT_WORD_EQUAL(r, engine_ops[1]);
+	div2uWord(q, r, minWord, engine_ops[2]);
+	CU_ASSERT_WORD_EQUAL(q, zeroWord);
+	CU_ASSERT_WORD_EQUAL(r, minWord);
+
+	// divide by 0 gives the largest unsigned number
+	div2uWord(q, r, engine_ops[8], zeroWord);
+	CU_ASSERT_WORD_EQUAL(q, engine_ops[2]);
+	CU_ASSERT_WORD_EQUAL(r, zeroWord);
+	div2uWordRef(q, r, engine_ops[8], zeroWord);
+	CU_ASSERT_WORD_EQUAL(q, engine_ops[2]);
+	CU_ASSERT_WORD_EQUAL(r, zeroWord);
+
+	// n = q * d + r with r < d, and the product high word from the
+	// signed one: mulhu(a, b) = mulh(a, b) + (a < 0 ? b : 0) + (b < 0 ? a : 0)
+	int failures = 0;
+	for (int i = 0; i < engine_nops; i++) {
+		for (int j = 0; j < engine_nops; j++) {
+			const byte *n = engine_ops[i], *d = engine_ops[j];
+			failures += cmpLtuWord(n, d) != (cmpuWord(n, d) < 0);
+			failures += cmpGeuWord(n, d) != (cmpuWord(n, d) >= 0);
+
+			word hi, lo;
+			mulWideWord(hi, lo, n, d);
+			if (testLtWord(n)) {
+				addWord(hi, hi, d);
+			}
+			if (testLtWord(d)) {
+				addWord(hi, hi, n);
+			}
+			mulHighuWord(result, n, d);
+			failures += memcmp(result, hi, sizeof(word)) != 0;
+			mulHighuWordRef(result, n, d);
+			failures += memcmp(result, hi, sizeof(word)) != 0;
+
+			if (testEqWord(d)) {
+				continue;
+			}
+			div2uWord(q, r, n, d);
+			mulWord(expected, q, d);
+			addWord(expected, expected, r);
+			failures += memcmp(expected, n, sizeof(word)) != 0;
+			failures += !cmpLtuWord(r, d);
+			divuWord(result, n, d);
+			failures += memcmp(result, q, sizeof(word)) != 0;
+			remainderuWord(result, n, d);
+			failures += memcmp(result, r, sizeof(word)) != 0;
+
+			// in place, and the reference engine
+			setWord(result, n);
+			setWord(expected, d);
+			div2uWordRef(result, expected, result, expected);
+			failures += memcmp(result, q, sizeof(word)) != 0 || memcmp(expected, r, sizeof(word)) != 0;
+		}
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+}
+
+/**
+ * Check flags against the tests of the result word.
+ *
+ * @param flags the flags
+ * @param result the result
+ * @param carry the expected carry
+ * @param overflow the expected overflow
+ */
+static void check_flags(const aluflags *flags, const word result, bit carry, bit overflow) {
+	CU_ASSERT_EQUAL(flags->n, testLtWord(result));
+	CU_ASSERT_EQUAL(flags->z, testEqWord(result));
+	CU_ASSERT_EQUAL(flags->c, carry);
+	CU_ASSERT_EQUAL(flags->v, overflow);
+}
+
+/**
+ * Test that the flag-returning functions match the results
+ * and flags of the plain functions.
+ */
+void test_flags(void) {
+	word minusone;
+	notWord(minusone, zeroWord);
+
+	for (int i = 0; i < engine_nops; i++) {
+		const byte *op1 = engine_ops[i];
+		word expected, actual;
+		aluflags flags;
+
+		notWord(expected, op1);
+		notWordFlags(actual, &flags, op1);
+		CU_ASSERT_WORD_EQUAL(actual, expected);
+		check_flags(&flags, actual, 0, 0);
+
+		negativeWord(expected, op1);
+		negativeWordFlags(actual, &flags, op1);
+		CU_ASSERT_WORD_EQUAL(actual, expected);
+		check_flags(&flags, actual, testEqWord(op1), memcmp(op1, minWord, wordbytes) == 0);
+
+		for (int count = -wordsize-2; count <= wordsize+2; count++) {
+			unsigned c = (count < 0) ? -count : count;
+			bit carry = 0;
+			word back;
+
+			lshWord(expected, op1, count);
+			lshWordFlags(actual, &flags, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			if (c > 0 && c <= (unsigned)wordsize) {
+				carry = getBitOfWord(op1, (count < 0) ? c - 1 : wordsize - c);
+			}
+			check_flags(&flags, actual, carry, 0);
+
+			cshWord(expected, op1, count);
+			cshWordFlags(actual, &flags, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			carry = 0;
+			if (c % wordsize != 0) {
+				carry = getBitOfWord(actual, (count < 0) ? wordtopbit : 0);
+			}
+			check_flags(&flags, actual, carry, 0);
+
+			ashWord(expected, op1, count);
+			ashWordFlags(actual, &flags, op1, count);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			c = (c > (unsigned)wordtopbit) ? (unsigned)wordtopbit : c;
+			carry = 0;
+			bit overflow = 0;
+			if (c > 0 && count < 0) {
+				carry = getBitOfWord(op1, c - 1);
+			} else if (c > 0) {
+				carry = getBitOfWord(op1, wordtopbit - c);
+				ashWord(back, actual, -(int)c);
+				overflow = memcmp(back, op1, wordbytes) != 0;
+			}
+			check_flags(&flags, actual, carry, overflow);
+		}
+
+		for (int j = 0; j < engine_nops; j++) {
+			const byte *op2 = engine_ops[j];
+			bit carry, overflow;
+
+			andWord(expected, op1, op2);
+			andWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, 0, 0);
+
+			orWord(expected, op1, op2);
+			orWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, 0, 0);
+
+			xorWord(expected, op1, op2);
+			xorWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, 0, 0);
+
+			addCarryWord(expected, &carry, &overflow, op1, op2);
+			addWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry, overflow);
+
+			adcWordFlags(actual, &flags, op1, op2, 0);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry, overflow);
+
+			subCarryWord(expected, &carry, &overflow, op1, op2);
+			subWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry, overflow);
+
+			sbcWordFlags(actual, &flags, op1, op2, 1);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry, overflow);
+
+			// with a carry in: op1 + op2 + 1 and op1 - op2 - 1
+			word sum, one;
+			storeWord(one, 1);
+			bit carry2, overflow2;
+			addCarryWord(sum, &carry, &overflow, op1, op2);
+			addCarryWord(expected, &carry2, &overflow2, sum, one);
+			adcWordFlags(actual, &flags, op1, op2, 1);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry | carry2, overflow ^ overflow2);
+
+			subCarryWord(sum, &carry, &overflow, op1, op2);
+			subCarryWord(expected, &carry2, &overflow2, sum, one);
+			sbcWordFlags(actual, &flags, op1, op2, 0);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, carry & carry2, overflow ^ overflow2);
+
+			word hi, sign;
+			mulWideWord(hi, expected, op1, op2);
+			ashWord(sign, expected, -wordtopbit);
+			mulWordFlags(actual, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			check_flags(&flags, actual, 0, memcmp(hi, sign, wordbytes) != 0);
+
+			word eremainder, aremainder;
+			div2Word(expected, eremainder, op1, op2);
+			div2WordFlags(actual, aremainder, &flags, op1, op2);
+			CU_ASSERT_WORD_EQUAL(actual, expected);
+			CU_ASSERT_WORD_EQUAL(aremainder, eremainder);
+			overflow = testEqWord(op2) || (memcmp(op1, minWord, wordbytes) == 0
+										   && memcmp(op2, minusone, wordbytes) == 0);
+			check_flags(&flags, actual, 0, overflow);
+		}
+	}
+
+	// flags of a few named cases
+	word result;
+	aluflags flags;
+	addWordFlags(result, &flags, maxWord, engine_ops[1]);
+	CU_ASSERT_TRUE(flags.n && !flags.z && !flags.c && flags.v);
+	addWordFlags(result, &flags, minusone, engine_ops[1]);
+	CU_ASSERT_TRUE(!flags.n && flags.z && flags.c && !flags.v);
+	subWordFlags(result, &flags, zeroWord, engine_ops[1]);
+	CU_ASSERT_TRUE(flags.n && !flags.z && !flags.c && !flags.v);
+	mulWordFlags(result, &flags, minWord, minusone);
+	CU_ASSERT_TRUE(flags.n && !flags.z && flags.v);
+
+	// result may be an operand
+	word op;
+	setWord(op, maxWord);
+	lshWordFlags(op, &flags, op, 1);
+	CU_ASSERT_TRUE(flags.c == 0 && flags.n);
+	setWord(op, minWord);
+	ashWordFlags(op, &flags, op, -1);
+	CU_ASSERT_TRUE(flags.c == 0 && flags.n && !flags.v);
+}
+
+/** maximum number of limbs in multi-precision tests */
+#define MP_N 70
+
+/**
+ * Fill a number with pseudo-random limbs.
+ *
+ * @param op the number
+ * @param n the number of limbs
+ * @param seed the generator state
+ */
+static void fill_mp(word *op, size_t n, uint32_t *seed) {
+	for (size_t i = 0; i < n; i++) {
+		for (int b = 0; b < wordbytes; b++) {
+			*seed = *seed * 1103515245 + 12345;
+			op[i][b] = (byte)(*seed >> 16);
+		}
+	}
+}
+
+/**
+ * Test multi-precision functions against the word functions
+ * for single limbs and against each other for many limbs
+ */
+void test_mp(void) {
+	static word scratch[8 * MP_N];
+	word q[MP_N], r[MP_N];
+
+	// single limbs agree with the word functions
+	for (int i = 0; i < engine_nops; i++) {
+		const word *op1 = &engine_ops[i];
+		word expected, expected2;
+
+		for (int count = -wordsize-1; count <= wordsize+1; count++) {
+			lshWord(expected, *op1, count);
+			lshMp(r, op1, 1, count);
+			CU_ASSERT_WORD_EQUAL(r[0], expected);
+			ashWord(expected, *op1, count);
+			ashMp(r, op1, 1, count);
+			CU_ASSERT_WORD_EQUAL(r[0], expected);
+		}
+
+		for (int j = 0; j < engine_nops; j++) {
+			const word *op2 = &engine_ops[j];
+			bit carry;
+
+			addCarryWord(expected, &carry, NULL, *op1, *op2);
+			CU_ASSERT_EQUAL(addMp(r, op1, op2, 1), carry);
+			CU_ASSERT_WORD_EQUAL(r[0], expected);
+			subCarryWord(expected, &carry, NULL, *op1, *op2);
+			CU_ASSERT_EQUAL(subMp(r, op1, op2, 1), carry);
+			CU_ASSERT_WORD_EQUAL(r[0], expected);
+
+			mulWord(expected, *op1, *op2);
+			mulMp(r, op1, 1, op2, 1, NULL);
+			CU_ASSERT_WORD_EQUAL(r[0], expected);
+
+			div2Word(expected, expected2, *op1, *op2);
+			div2Mp(q, r, op1, op2, 1, scratch);
+			CU_ASSERT_WORD_EQUAL(q[0], expected);
+			CU_ASSERT_WORD_EQUAL(r[0], expected2);
+		}
+	}
+
+	// many limbs, across the Karatsuba threshold
+	static const size_t sizes[][2] = {
+		{2, 1}, {3, 3}, {5, 2}, {ALU_MP_KARATSUBA, ALU_MP_KARATSUBA},
+		{ALU_MP_KARATSUBA + 1, ALU_MP_KARATSUBA + 1}, {MP_N / 2, MP_N / 2},
+		{MP_N - ALU_MP_KARATSUBA, ALU_MP_KARATSUBA}, {40, 27},
+	};
+	uint32_t seed = 4321;
+	for (size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) {
+		size_t n1 = sizes[t][0], n2 = sizes[t][1];
+		word a[MP_N], b[MP_N], c[MP_N], product[2 * MP_N], expected[2 * MP_N];
+		fill_mp(a, n1, &seed);
+		fill_mp(b, n2, &seed);
+		if (t == 0) {
+			setWord(b[0], maxWord);  // single-limb divisor that needs normalizing
+		}
+
+		// product against a sum of single-limb products
+		CU_ASSERT_TRUE(mulMpScratch(n1, n2) <= sizeof(scratch) / sizeof(scratch[0]));
+		mulMp(product, (const word *)a, n1, (const word *)b, n2, scratch);
+		for (size_t i = 0; i < n1 + n2; i++) {
+			setWord(expected[i], zeroWord);
+		}
+		for (size_t j = 0; j < n2; j++) {
+			word row[MP_N + 1];
+			mulMp(row, (const word *)a, n1, (const word *)&b[j], 1, NULL);
+			CU_ASSERT_FALSE(addInMp(expected + j, n1 + n2 - j, (const word *)row, n1 + 1));
+		}
+		CU_ASSERT_EQUAL(cmpMp((const word *)product, (const word *)expected, n1 + n2), 0);
+
+		// (a b + c) / b is a with remainder c for c < b
+		fill_mp(c, n2, &seed);
+		setWord(c[n2 - 1], zeroWord);
+		CU_ASSERT_FALSE(addInMp(product, n1 + n2, (const word *)c, n2));
+		CU_ASSERT_TRUE(divuMpScratch(n1 + n2, n2) <= sizeof(scratch) / sizeof(scratch[0]));
+		word quotient[2 * MP_N];
+		divuMp(quotient, r, (const word *)product, n1 + n2, (const word *)b, n2, scratch);
+		CU_ASSERT_EQUAL(cmpMp((const word *)quotient, (const word *)a, n1), 0);
+		CU_ASSERT_TRUE(testEqWord(quotient[n1 + n2 - 1]));
+		CU_ASSERT_EQUAL(cmpMp((const word *)r, (const word *)c, n2), 0);
+
+		// a - b + b is a, in place
+		for (size_t i = 0; i < n1; i++) {
+			setWord(c[i], a[i]);
+		}
+		bit borrow = subInMp(c, n1, (const word *)b, n2);
+		CU_ASSERT_EQUAL(addInMp(c, n1, (const word *)b, n2), !borrow);
+		CU_ASSERT_EQUAL(cmpMp((const word *)c, (const word *)a, n1), 0);
+
+		// shift left by one is a + a, and back again after clearing the top bit
+		word doubled[MP_N];
+		bit carry = addMp(doubled, (const word *)a, (const word *)a, n1);
+		lshMp(c, (const word *)a, n1, 1);
+		CU_ASSERT_EQUAL(cmpMp((const word *)c, (const word *)doubled, n1), 0);
+		CU_ASSERT_EQUAL(carry, getBitOfWord(a[n1 - 1], wordtopbit));
+		lshMp(c, (const word *)c, n1, -1);
+		setBitOfWord(a[n1 - 1], wordtopbit, 0);
+		CU_ASSERT_EQUAL(cmpMp((const word *)c, (const word *)a, n1), 0);
+
+		// shift across limbs and back keeps the low bits
+		int count = wordsize + 3;
+		lshMp(c, (const word *)a, n1, count);
+		lshMp(c, (const word *)c, n1, -count);
+		lshMp(doubled, (const word *)a, n1, count - (int)(n1 * wordsize));
+		lshMp(doubled, (const word *)doubled, n1, -count + (int)(n1 * wordsize));
+		CU_ASSERT_FALSE(addMp(doubled, (const word *)doubled, (const word *)c, n1));
+		CU_ASSERT_EQUAL(cmpMp((const word *)doubled, (const word *)a, n1), 0);
+
+		// arithmetic shift right of a negative number fills with ones
+		setBitOfWord(a[n1 - 1], wordtopbit, 1);
+		ashMp(c, (const word *)a, n1, -(int)(n1 * wordsize));
+		for (size_t i = 0; i < n1; i++) {
+			CU_ASSERT_EQUAL(loadWord(c[i]), (uword)~(uword)0);
+		}
+	}
+
+	// signed division of many limbs by parts: -7 B^2 / 2 and divide by 0
+	word a[3], b[3], expected[3];
+	for (int i = 0; i < 3; i++) {
+		setWord(a[i], zeroWord);
+		setWord(b[i], zeroWord);
+	}
+	storeWord(a[2], (uword)(int64_t)-7);
+	storeWord(b[0], 2);
+	div2Mp(q, r, (const word *)a, (const word *)b, 3, scratch);
+	storeWord(expected[0], 0);  // -(3 B^2 + B/2 B)
+	storeWord(expected[1], (uword)1 << wordtopbit);
+	storeWord(expected[2], (uword)(int64_t)-4);
+	CU_ASSERT_EQUAL(cmpMp((const word *)q, (const word *)expected, 3), 0);
+	CU_ASSERT_TRUE(testEqWord(r[0]) && testEqWord(r[1]) && testEqWord(r[2]));
+	storeWord(b[0], 0);
+	div2Mp(q, r, (const word *)a, (const word *)b, 3, scratch);
+	CU_ASSERT_WORD_EQUAL(q[2], minWord);
+	CU_ASSERT_TRUE(testEqWord(q[0]) && testEqWord(q[1]) && testEqWord(r[0]));
+}
+
+/**
+ * Test the instrumentation counters, which are all zero unless
+ * built with ALU_INSTRUMENT
+ */
+void test_instrument(void) {
+	instcounts counts, total;
+	word result;
+	CU_ASSERT_STRING_EQUAL(instrumentName(instAdd), "addWord");
+	CU_ASSERT_STRING_EQUAL(instrumentName(instRemainder), "remainderWord");
+	CU_ASSERT_PTR_NULL(instrumentName(instOps));
+
+	instrumentClear();
+	instrumentClearTotals();
+	for (int i = 0; i < 10; i++) {
+		addWord(result, engine_ops[i % engine_nops], engine_ops[1]);
+	}
+	divWord(result, maxWord, engine_ops[1]);
+	mulWord(result, maxWord, maxWord);
+	(void)testLtWord(result);
+	instrumentGet(&counts);
+
+	uint64_t expect = instrumentEnabled() ? 1 : 0;
+	CU_ASSERT_EQUAL(counts.calls[instAdd], 10 * expect);
+	CU_ASSERT_EQUAL(counts.calls[instDiv], expect);
+	CU_ASSERT_EQUAL(counts.calls[instDiv2], expect);
+	CU_ASSERT_EQUAL(counts.calls[instMul], expect);
+	CU_ASSERT_EQUAL(counts.calls[instTestLt], expect);
+	CU_ASSERT_EQUAL(counts.calls[instSub], 0);
+	for (int op = 0; op < instOps; op++) {
+		uint64_t calls = 0;
+		for (int b = 0; b < INSTRUMENT_BUCKETS; b++) {
+			calls += counts.histogram[op][b];
+		}
+		CU_ASSERT_EQUAL(calls, counts.calls[op]);
+	}
+#ifdef ALU_REFERENCE
+	// the bit-serial divide runs one iteration per significant bit
+	// of the dividend, so wordsize - 1 for maxWord
+	CU_ASSERT_EQUAL(counts.iterations[instDiv2], wordtopbit * expect);
+	CU_ASSERT_TRUE(counts.iterations[instMul] >= (uint64_t)(wordtopbit * expect));
+#endif
+
+	// collect into the totals twice, clearing the thread counters
+	instrumentCollect();
+	instrumentGet(&counts);
+	CU_ASSERT_EQUAL(counts.calls[instAdd], 0);
+	addWord(result, result, result);
+	instrumentCollect();
+	instrumentTotals(&total);
+	CU_ASSERT_EQUAL(total.calls[instAdd], 11 * expect);
+
+	memset(&counts, 0, sizeof(counts));
+	counts.calls[instAdd] = 5;
+	counts.histogram[instAdd][3] = 5;
+	instrumentMerge(&total, &counts);
+	CU_ASSERT_EQUAL(total.calls[instAdd], 11 * expect + 5);
+
+	// the dump names each function that was called
+	FILE *out = tmpfile();
+	CU_ASSERT_PTR_NOT_NULL_FATAL(out);
+	instrumentDump(out, &total);
+	rewind(out);
+	char text[4096] = {0};
+	CU_ASSERT_TRUE(fread(text, 1, sizeof(text) - 1, out) > 0);
+	fclose(out);
+	CU_ASSERT_PTR_NOT_NULL(strstr(text, "\"name\": \"addWord\""));
+	CU_ASSERT_EQUAL(strstr(text, "\"subWord\""), NULL);
+	CU_ASSERT_EQUAL(text[0], '[');
+
+	instrumentClear();
+	instrumentClearTotals();
+}
+
+/**
+ * Test the caching multiply and divide against the alu.h functions
+ */
+void test_memo(void) {
+	word op1, op2, result, remainder, expected, expected2;
+	memostats stats;
+	memoClear();
+	memoStats(&stats);
+	CU_ASSERT_EQUAL(stats.mulHits + stats.mulMisses + stats.divHits + stats.divMisses, 0);
+
+	// every pair twice: the second pass of each pair may hit
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < engine_nops; i++) {
+			for (int j = 0; j < engine_nops; j++) {
+				memoMulWord(result, engine_ops[i], engine_ops[j]);
+				mulWord(expected, engine_ops[i], engine_ops[j]);
+				CU_ASSERT_WORD_EQUAL(result, expected);
+				memoDiv2Word(result, remainder, engine_ops[i], engine_ops[j]);
+				div2Word(expected, expected2, engine_ops[i], engine_ops[j]);
+				CU_ASSERT_WORD_EQUAL(result, expected);
+				CU_ASSERT_WORD_EQUAL(remainder, expected2);
+			}
+		}
+	}
+	memoStats(&stats);
+	CU_ASSERT_EQUAL(stats.mulHits + stats.mulMisses, 2 * engine_nops * engine_nops);
+	CU_ASSERT_EQUAL(stats.divHits + stats.divMisses, 2 * engine_nops * engine_nops);
+	CU_ASSERT_TRUE(stats.mulMisses >= (uint64_t)(engine_nops * engine_nops));
+
+	// a repeated pair hits after its first call
+	memoClear();
+	setWord(op1, engine_ops[3]);
+	setWord(op2, engine_ops[5]);
+	for (int k = 0; k < 4; k++) {
+		memoDiv2Word(result, remainder, op1, op2);
+	}
+	memoStats(&stats);
+	CU_ASSERT_EQUAL(stats.divMisses, 1);
+	CU_ASSERT_EQUAL(stats.divHits, 3);
+	CU_ASSERT_EQUAL(stats.mulHits + stats.mulMisses, 0);
+
+	// results may be the same words as the operands, on hits and misses
+	for (int k = 0; k < 2; k++) {
+		setWord(op1, engine_ops[3]);
+		setWord(op2, engine_ops[5]);
+		div2Word(expected, expected2, op1, op2);
+		memoDiv2Word(op1, op2, op1, op2);
+		CU_ASSERT_WORD_EQUAL(op1, expected);
+		CU_ASSERT_WORD_EQUAL(op2, expected2);
+		setWord(op1, engine_ops[3]);
+		setWord(op2, engine_ops[5]);
+		mulWord(expected, op1, op2);
+		memoMulWord(op2, op1, op2);
+		CU_ASSERT_WORD_EQUAL(op2, expected);
+	}
+	memoClear();
+}
+
+/** number of elements in batch test arrays */
+#define BATCH_N 144
+
+/**
+ * Fill batch operand arrays with every pair of engine operands.
+ *
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ */
+static void fill_batch(word *op1, word *op2) {
+	for (int i = 0; i < BATCH_N; i++) {
+		setWord(op1[i], engine_ops[i / engine_nops]);
+		setWord(op2[i], engine_ops[i % engine_nops]);
+	}
+}
+
+/**
+ * Check division by a prepared divisor against div2Word.
+ *
+ * @param op1 the dividend
+ * @param op2 the divisor
+ * @return true if the results match
+ */
+static bool check_divisor(const word op1, const word op2) {
+	divisor d;
+	word q, r, expected, expected2;
+	prepareDivisor(&d, op2);
+	div2WordBy(q, r, op1, &d);
+	div2Word(expected, expected2, op1, op2);
+	return memcmp(q, expected, sizeof(word)) == 0 && memcmp(r, expected2, sizeof(word)) == 0;
+}
+
+/**
+ * Test division by prepared divisors against div2Word
+ */
+void test_divisor(void) {
+	word op1, op2;
+
+	// every pair of engine operands, and pseudo-random pairs
+	for (int i = 0; i < engine_nops; i++) {
+		for (int j = 0; j < engine_nops; j++) {
+			CU_ASSERT_TRUE(check_divisor(engine_ops[i], engine_ops[j]));
+		}
+	}
+	uint32_t seed = 99;
+	int failures = 0;
+	for (int i = 0; i < 20000; i++) {
+		for (int b = 0; b < wordbytes; b++) {
+			seed = seed * 1103515245 + 12345;
+			op1[b] = (byte)(seed >> 16);
+			op2[b] = (byte)(seed >> 8);
+		}
+		// small divisors are the common case for prepared divisors
+		if (i % 2 == 0) {
+			for (int b = 0; b < wordbytes - 1; b++) {
+				op2[wordByteIndex(b + 1)] = (i % 4 == 0) ? 0 : 0xFF;
+			}
+		}
+		failures += !check_divisor(op1, op2);
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+
+	// every divisor with a few dividends, and every pair for small words
+	failures = 0;
+	for (uint32_t v = 0; v < (wordsize <= 16 ? (1u << wordsize) : 70000u); v++) {
+		storeWord(op2, (uword)(v * (wordsize <= 16 ? 1u : 0x9E3779B1u)));
+		for (int i = 0; i < engine_nops; i++) {
+			failures += !check_divisor(engine_ops[i], op2);
+		}
+		if (wordsize == 8) {
+			for (uint32_t u = 0; u < 256; u++) {
+				storeWord(op1, (uword)u);
+				failures += !check_divisor(op1, op2);
+			}
+		}
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+
+	// single and batch quotients and remainders, in place
+	word ops[BATCH_N], result[BATCH_N], remainder[BATCH_N], expected, expected2;
+	for (int k = 0; k < engine_nops; k++) {
+		divisor d;
+		prepareDivisor(&d, engine_ops[k]);
+		for (int i = 0; i < BATCH_N; i++) {
+			setWord(ops[i], engine_ops[i % engine_nops]);
+		}
+		divWordByN(result, (const word *)ops, &d, BATCH_N);
+		remainderWordByN(remainder, (const word *)ops, &d, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			div2Word(expected, expected2, ops[i], engine_ops[k]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+			CU_ASSERT_WORD_EQUAL(remainder[i], expected2);
+			divWordBy(op1, ops[i], &d);
+			CU_ASSERT_WORD_EQUAL(op1, expected);
+			remainderWordBy(op1, ops[i], &d);
+			CU_ASSERT_WORD_EQUAL(op1, expected2);
+		}
+		div2WordByN(ops, remainder, (const word *)ops, &d, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			div2Word(expected, expected2, engine_ops[i % engine_nops], engine_ops[k]);
+			CU_ASSERT_WORD_EQUAL(ops[i], expected);
+			CU_ASSERT_WORD_EQUAL(remainder[i], expected2);
+		}
+	}
+}
+
+#if defined(__SIZEOF_INT128__)
+/** signed integer wide enough for the product of two words */
+typedef __int128 wideint;
+#define HAVE_WIDEINT 1
+#elif WORDSIZE <= 32
+typedef int64_t wideint;
+#define HAVE_WIDEINT 1
+#endif
+
+#ifdef HAVE_WIDEINT
+/**
+ * Store a wide integer clamped to the range of a word.
+ *
+ * @param result the result
+ * @param v the wide integer
+ */
+static void clamp_wide(word result, wideint v) {
+	wideint max = (sword)loadWord(maxWord), min = (sword)loadWord(minWord);
+	storeWord(result, (uword)(sword)(v > max ? max : v < min ? min : v));
+}
+#endif
+
+/**
+ * Test saturating and fixed-point functions against wide integer
+ * arithmetic
+ */
+void test_sat(void) {
+	word result, expected;
+
+	// clamps in both directions
+	addSatWord(result, maxWord, engine_ops[1]);
+	CU_ASSERT_WORD_EQUAL(result, maxWord);
+	subSatWord(result, minWord, engine_ops[1]);
+	CU_ASSERT_WORD_EQUAL(result, minWord);
+	mulSatWord(result, minWord, minWord);
+	CU_ASSERT_WORD_EQUAL(result, maxWord);
+	mulQWord(result, minWord, minWord, wordtopbit);
+	CU_ASSERT_WORD_EQUAL(result, maxWord);
+	ashSatWord(result, minWord, 1);
+	CU_ASSERT_WORD_EQUAL(result, minWord);
+
+	// 0.5 * 0.5 = 0.25 and -0.5 * 0.5 = -0.25 in full Q format
+	word half, quarter;
+	setWord(half, zeroWord);
+	setBitOfWord(half, wordtopbit - 1, 1);
+	setWord(quarter, zeroWord);
+	setBitOfWord(quarter, wordtopbit - 2, 1);
+	mulQWord(result, half, half, wordtopbit);
+	CU_ASSERT_WORD_EQUAL(result, quarter);
+	word minusHalf;
+	negativeWord(minusHalf, half);
+	mulQWord(result, minusHalf, half, wordtopbit);
+	negativeWord(expected, quarter);
+	CU_ASSERT_WORD_EQUAL(result, expected);
+
+#ifdef HAVE_WIDEINT
+	for (int i = 0; i < engine_nops; i++) {
+		wideint a = (sword)loadWord(engine_ops[i]);
+		for (int j = 0; j < engine_nops; j++) {
+			wideint b = (sword)loadWord(engine_ops[j]);
+			clamp_wide(expected, a + b);
+			addSatWord(result, engine_ops[i], engine_ops[j]);
+			CU_ASSERT_WORD_EQUAL(result, expected);
+			clamp_wide(expected, a - b);
+			subSatWord(result, engine_ops[i], engine_ops[j]);
+			CU_ASSERT_WORD_EQUAL(result, expected);
+			clamp_wide(expected, a * b);
+			mulSatWord(result, engine_ops[i], engine_ops[j]);
+			CU_ASSERT_WORD_EQUAL(result, expected);
+			for (int frac = 0; frac < wordsize; frac += (frac < 2 || frac > wordsize - 3) ? 1 : 7) {
+				wideint round = frac > 0 ? (wideint)1 << (frac - 1) : 0;
+				clamp_wide(expected, (a * b + round) >> frac);
+				mulQWord(result, engine_ops[i], engine_ops[j], frac);
+				CU_ASSERT_WORD_EQUAL(result, expected);
+			}
+		}
+		for (int count = -wordsize - 1; count <= wordsize + 1; count++) {
+			if (count <= 0) {
+				ashWord(expected, engine_ops[i], count);
+			} else {
+				// clamp a * 2^count, stopping once it is out of range
+				wideint v = a;
+				for (int k = 0; k < count && v != 0 && v == (sword)v; k++) {
+					v *= 2;
+				}
+				clamp_wide(expected, v);
+			}
+			ashSatWord(result, engine_ops[i], count);
+			CU_ASSERT_WORD_EQUAL(result, expected);
+		}
+	}
+#endif
+
+	// batch forms in place against the scalar functions
+	word op1[BATCH_N], op2[BATCH_N], r[BATCH_N];
+	void (*const binary[])(word, const word, const word) = {addSatWord, subSatWord, mulSatWord};
+	void (*const binaryN[])(word *, const word *, const word *, size_t) = {
+		addSatWordN, subSatWordN, mulSatWordN
+	};
+	for (int k = 0; k < 3; k++) {
+		fill_batch(op1, op2);
+		binaryN[k](op1, (const word *)op1, (const word *)op2, BATCH_N);
+		fill_batch(r, op2);
+		for (int i = 0; i < BATCH_N; i++) {
+			binary[k](expected, r[i], op2[i]);
+			CU_ASSERT_WORD_EQUAL(op1[i], expected);
+		}
+	}
+	fill_batch(op1, op2);
+	for (int count = -3; count <= wordsize; count += 5) {
+		ashSatWordN(r, (const word *)op1, count, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			ashSatWord(expected, op1[i], count);
+			CU_ASSERT_WORD_EQUAL(r[i], expected);
+		}
+	}
+	for (int frac = -1; frac <= wordsize; frac += 3) {
+		mulQWordN(r, (const word *)op1, (const word *)op2, frac, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			mulQWord(expected, op1[i], op2[i], frac);
+			CU_ASSERT_WORD_EQUAL(r[i], expected);
+		}
+	}
+}
+
+/**
+ * Test batch functions against the scalar functions
+ */
+void test_batch(void) {
+	word op1[BATCH_N], op2[BATCH_N];
+	word result[BATCH_N], result2[BATCH_N];
+	bit carry[BATCH_N], overflow[BATCH_N];
+	bool flags[BATCH_N];
+	uint64_t mask[(BATCH_N + 63) / 64];
+	word expected, expected2;
+	fill_batch(op1, op2);
+
+	testLtWordN(flags, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(flags[i], testLtWord(op1[i]));
+	}
+	testGeWordN(flags, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(flags[i], testGeWord(op1[i]));
+	}
+	testEqWordN(flags, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(flags[i], testEqWord(op2[i]));
+	}
+
+	cmpLtWordMask(mask, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, cmpWord(op1[i], op2[i]) < 0);
+	}
+	CU_ASSERT_EQUAL(mask[BATCH_N / 64] >> (BATCH_N % 64), 0);
+	cmpLtuWordMask(mask, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, cmpuWord(op1[i], op2[i]) < 0);
+	}
+	cmpGeuWordMask(mask, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, cmpGeuWord(op1[i], op2[i]));
+	}
+	cmpLtuWordN(flags, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(flags[i], cmpLtuWord(op1[i], op2[i]));
+	}
+	cmpGeuWordN(flags, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(flags[i], cmpGeuWord(op1[i], op2[i]));
+	}
+	cmpEqWordMask(mask, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, cmpWord(op1[i], op2[i]) == 0);
+	}
+
+	sminWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		sminWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	smaxWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		smaxWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	uminWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		uminWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	umaxWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		umaxWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	for (int count = -wordsize-1; count <= wordsize+1; count += 3) {
+		ashWordN(result, op1, count, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			ashWord(expected, op1[i], count);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+		cshWordN(result, op1, count, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			cshWord(expected, op1[i], count);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+		lshWordN(result, op1, count, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			lshWord(expected, op1[i], count);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+		maskWordN(result, op1, count, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			maskWord(expected, op1[i], count);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+	}
+
+	andWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		andWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	orWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		orWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	xorWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		xorWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	notWordN(result, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		notWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	negativeWordN(result, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		negativeWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	addWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		addWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	subWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		subWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	addCarryWordN(result, carry, overflow, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		bit c, v;
+		addCarryWord(expected, &c, &v, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+		CU_ASSERT_EQUAL(carry[i], c);
+		CU_ASSERT_EQUAL(overflow[i], v);
+	}
+	subCarryWordN(result, carry, NULL, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		bit c;
+		subCarryWord(expected, &c, NULL, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+		CU_ASSERT_EQUAL(carry[i], c);
+	}
+	mulWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		mulWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	mulWideWordN(result, result2, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		mulWideWord(expected, expected2, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+		CU_ASSERT_WORD_EQUAL(result2[i], expected2);
+	}
+	div2WordN(result, result2, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		div2Word(expected, expected2, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+		CU_ASSERT_WORD_EQUAL(result2[i], expected2);
+	}
+	divWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		divWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	remainderWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		remainderWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	mulHighuWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		mulHighuWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	div2uWordN(result, result2, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		div2uWord(expected, expected2, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+		CU_ASSERT_WORD_EQUAL(result2[i], expected2);
+	}
+	divuWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		divuWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	remainderuWordN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		remainderuWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	// bit counts, reversals and fields
+	int counts[BATCH_N];
+	popcountWordN(counts, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(counts[i], popcountWord(op1[i]));
+	}
+	clzWordN(counts, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(counts[i], clzWord(op1[i]));
+	}
+	ctzWordN(counts, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_EQUAL(counts[i], ctzWord(op1[i]));
+	}
+	bitReverseWordN(result, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		bitReverseWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	byteSwapWordN(result, op1, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		byteSwapWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	extractFieldN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		extractField(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	depositFieldN(result, op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		depositField(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	// division in place: the results are the operand arrays
+	word a[BATCH_N], b[BATCH_N];
+	int failures = 0;
+	for (int k = 0; k < 4; k++) {
+		memcpy(a, op1, sizeof(a));
+		memcpy(b, op2, sizeof(b));
+		switch (k) {
+		case 0:
+			divWordN(a, (const word *)a, b, BATCH_N);
+			break;
+		case 1:
+			remainderWordN(b, a, (const word *)b, BATCH_N);
+			break;
+		case 2:
+			div2WordN(a, b, (const word *)a, (const word *)b, BATCH_N);
+			break;
+		default:
+			div2WordN(b, a, (const word *)a, (const word *)b, BATCH_N);
+			break;
+		}
+		for (int i = 0; i < BATCH_N; i++) {
+			div2Word(expected, expected2, op1[i], op2[i]);
+			switch (k) {
+			case 0:
+				failures += memcmp(a[i], expected, sizeof(word)) != 0;
+				break;
+			case 1:
+				failures += memcmp(b[i], expected2, sizeof(word)) != 0;
+				break;
+			case 2:
+				failures += memcmp(a[i], expected, sizeof(word)) != 0
+						|| memcmp(b[i], expected2, sizeof(word)) != 0;
+				break;
+			default:
+				failures += memcmp(b[i], expected, sizeof(word)) != 0
+						|| memcmp(a[i], expected2, sizeof(word)) != 0;
+				break;
+			}
+		}
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+
+	// in place: result array is the first operand array
+	subWordN(result, op1, op2, BATCH_N);
+	subWordN(op1, (const word *)op1, op2, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		CU_ASSERT_WORD_EQUAL(op1[i], result[i]);
+	}
+}
+
+/** number of elements in SIMD test arrays, not a multiple of any vector width */
+#define SIMD_N 203
+
+/**
+ * Check the SIMD batch functions of the selected kernel set
+ * against the scalar functions.
+ *
+ * @param op1 the first operand array
+ * @param op2 the second operand array
+ * @param counts the per-element shift counts
+ */
+static void check_simd(const word *op1, const word *op2, const int *counts) {
+	word result[SIMD_N];
+	uint64_t mask[(SIMD_N + 63) / 64];
+	word expected;
+
+	andWordN(result, op1, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		andWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	orWordN(result, op1, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		orWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	xorWordN(result, op1, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		xorWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	notWordN(result, op1, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		notWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	addWordN(result, op1, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		addWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	subWordN(result, op1, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		subWord(expected, op1[i], op2[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	const int uniform[] = {0, 1, 7, -7, 31, -31, 32, -32, 45, -45, INT_MIN};
+	for (size_t c = 0; c < sizeof(uniform) / sizeof(uniform[0]); c++) {
+		ashWordN(result, op1, uniform[c], SIMD_N);
+		for (int i = 0; i < SIMD_N; i++) {
+			ashWord(expected, op1[i], uniform[c]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+		cshWordN(result, op1, uniform[c], SIMD_N);
+		for (int i = 0; i < SIMD_N; i++) {
+			cshWord(expected, op1[i], uniform[c]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+		lshWordN(result, op1, uniform[c], SIMD_N);
+		for (int i = 0; i < SIMD_N; i++) {
+			lshWord(expected, op1[i], uniform[c]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+	}
+
+	ashWordNv(result, op1, counts, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		ashWord(expected, op1[i], counts[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	cshWordNv(result, op1, counts, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		cshWord(expected, op1[i], counts[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+	lshWordNv(result, op1, counts, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		lshWord(expected, op1[i], counts[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	testLtWordMask(mask, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, testLtWord(op2[i]));
+	}
+	CU_ASSERT_EQUAL(mask[SIMD_N / 64] >> (SIMD_N % 64), 0);
+	testGeWordMask(mask, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, testGeWord(op2[i]));
+	}
+	CU_ASSERT_EQUAL(mask[SIMD_N / 64] >> (SIMD_N % 64), 0);
+	testEqWordMask(mask, op2, SIMD_N);
+	for (int i = 0; i < SIMD_N; i++) {
+		CU_ASSERT_EQUAL((mask[i / 64] >> (i % 64)) & 1, testEqWord(op2[i]));
+	}
+}
+
+/**
+ * Test microprograms against the alu.h functions
+ */
+void test_micro(void) {
+	word op1[BATCH_N], op2[BATCH_N], op3[BATCH_N];
+	word result[BATCH_N], expected;
+	fill_batch(op1, op2);
+	for (int i = 0; i < BATCH_N; i++) {
+		setWord(op3[i], op1[BATCH_N - 1 - i]);
+	}
+	const word *inputs[] = {op1, op2, op3};
+	microprogram p;
+
+	// (a + b) << 3 ^ mask
+	microInit(&p, 3);
+	int r = microBinary(&p, microAdd, 0, 1);
+	r = microShift(&p, microLsh, r, 3);
+	r = microBinary(&p, microXor, r, 2);
+	CU_ASSERT_TRUE(microFuse(&p, r));
+	microRunN(&p, result, inputs, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		addWord(expected, op1[i], op2[i]);
+		lshWord(expected, expected, 3);
+		xorWord(expected, expected, op3[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+
+		word in[3], single;
+		setWord(in[0], op1[i]);
+		setWord(in[1], op2[i]);
+		setWord(in[2], op3[i]);
+		microRun(&p, single, in);
+		CU_ASSERT_WORD_EQUAL(single, expected);
+	}
+
+	// every operation as a single step
+	void (*const unary[])(word, const word) = {notWord, negativeWord};
+	for (int k = 0; k < 2; k++) {
+		microInit(&p, 1);
+		CU_ASSERT_TRUE(microFuse(&p, microUnary(&p, microNot + k, 0)));
+		microRunN(&p, result, inputs, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			unary[k](expected, op1[i]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+	}
+	void (*const binary[])(word, const word, const word) = {
+		andWord, orWord, xorWord, addWord, subWord, mulWord, divWord,
+		remainderWord, sminWord, smaxWord, uminWord, umaxWord
+	};
+	for (int k = 0; k < 12; k++) {
+		microInit(&p, 2);
+		CU_ASSERT_TRUE(microFuse(&p, microBinary(&p, microAnd + k, 0, 1)));
+		microRunN(&p, result, inputs, BATCH_N);
+		for (int i = 0; i < BATCH_N; i++) {
+			binary[k](expected, op1[i], op2[i]);
+			CU_ASSERT_WORD_EQUAL(result[i], expected);
+		}
+	}
+	void (*const shift[])(word, const word, int) = {ashWord, cshWord, lshWord, maskWord};
+	for (int k = 0; k < 4; k++) {
+		for (int count = -wordsize-1; count <= wordsize+1; count += 5) {
+			microInit(&p, 1);
+			CU_ASSERT_TRUE(microFuse(&p, microShift(&p, microAsh + k, 0, count)));
+			microRunN(&p, result, inputs, BATCH_N);
+			for (int i = 0; i < BATCH_N; i++) {
+				shift[k](expected, op1[i], count);
+				CU_ASSERT_WORD_EQUAL(result[i], expected);
+			}
+		}
+	}
+
+	// constant steps are folded and dead steps removed
+	word three, four;
+	storeWord(three, 3);
+	storeWord(four, 4);
+	microInit(&p, 1);
+	r = microBinary(&p, microAdd, microConstant(&p, three), microConstant(&p, four));
+	microUnary(&p, microNot, 0);  // dead
+	r = microBinary(&p, microMul, r, 0);
+	CU_ASSERT_TRUE(microFuse(&p, r));
+	CU_ASSERT_EQUAL(p.nsteps, 2);
+	CU_ASSERT_EQUAL(p.steps[0].op, microConst);
+	CU_ASSERT_EQUAL(loadWord(p.steps[0].value), 7);
+	microRunN(&p, result, inputs, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		mulWord(expected, op1[i], p.steps[0].value);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	// the result may be an input, and an input array may be the result
+	microInit(&p, 2);
+	CU_ASSERT_TRUE(microFuse(&p, 1));
+	CU_ASSERT_EQUAL(p.nsteps, 0);
+	microRunN(&p, result, inputs, BATCH_N);
+	CU_ASSERT_EQUAL(memcmp(result, op2, sizeof(result)), 0);
+	microInit(&p, 1);
+	CU_ASSERT_TRUE(microFuse(&p, microUnary(&p, microNot, 0)));
+	memcpy(result, op1, sizeof(result));
+	const word *inplace[] = {result};
+	microRunN(&p, result, inplace, BATCH_N);
+	for (int i = 0; i < BATCH_N; i++) {
+		notWord(expected, op1[i]);
+		CU_ASSERT_WORD_EQUAL(result[i], expected);
+	}
+
+	// invalid steps
+	microInit(&p, 2);
+	CU_ASSERT_EQUAL(microBinary(&p, microAdd, 0, 2), -1);  // no register 2
+	CU_ASSERT_EQUAL(microShift(&p, microAdd, 0, 1), -1);  // not a shift
+	CU_ASSERT_EQUAL(microUnary(&p, microNot, -1), -1);
+	CU_ASSERT_FALSE(microFuse(&p, 2));
+	for (int k = 0; k < MICRO_STEPS; k++) {
+		CU_ASSERT_NOT_EQUAL(microUnary(&p, microNot, 0), -1);
+	}
+	CU_ASSERT_EQUAL(microUnary(&p, microNot, 0), -1);  // full
+}
+
+/**
+ * Run a single instruction on operands in registers 1 and 2.
+ *
+ * @param s the executor
+ * @param insn the instruction
+ * @param op1 the first operand
+ * @param op2 the second operand
+ */
+static void exec_one(execstate *s, uint32_t insn, const word op1, const word op2) {
+	execInit(s);
+	setWord(s->regs[1], op1);
+	setWord(s->regs[2], op2);
+	CU_ASSERT_EQUAL(execRun(s, &insn, 1, 10), 1);
+	CU_ASSERT_EQUAL(s->pc, 1);
+}
+
+/**
+ * Test the instruction executor against the alu.h functions
+ */
+void test_exec(void) {
+	void (*const binary[])(word, const word, const word) = {
+		andWord, orWord, xorWord, NULL, NULL, addWord, subWord, NULL, NULL,
+		mulWord, NULL, NULL, divWord, remainderWord, sminWord, smaxWord, uminWord, umaxWord
+	};
+	execstate s;
+	word expected, expected2;
+
+	for (int i = 0; i < engine_nops; i++) {
+		const byte *op1 = engine_ops[i];
+
+		exec_one(&s, execEncode(execNot, 3, 1, 0, 0), op1, zeroWord);
+		notWord(expected, op1);
+		CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+		exec_one(&s, execEncode(execNegative, 3, 1, 0, 0), op1, zeroWord);
+		negativeWord(expected, op1);
+		CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+		exec_one(&s, execEncode(execTestLt, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), testLtWord(op1));
+		exec_one(&s, execEncode(execTestGe, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), testGeWord(op1));
+		exec_one(&s, execEncode(execTestEq, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), testEqWord(op1));
+		exec_one(&s, execEncode(execPopcount, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), (uword)popcountWord(op1));
+		exec_one(&s, execEncode(execClz, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), (uword)clzWord(op1));
+		exec_one(&s, execEncode(execCtz, 3, 1, 0, 0), op1, zeroWord);
+		CU_ASSERT_EQUAL(loadWord(s.regs[3]), (uword)ctzWord(op1));
+		exec_one(&s, execEncode(execBitReverse, 3, 1, 0, 0), op1, zeroWord);
+		bitReverseWord(expected, op1);
+		CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+		exec_one(&s, execEncode(execByteSwap, 3, 1, 0, 0), op1, zeroWord);
+		byteSwapWord(expected, op1);
+		CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+
+		for (int count = -wordsize-1; count <= wordsize+1; count += 3) {
+			exec_one(&s, execEncode(execAsh, 3, 1, 0, count), op1, zeroWord);
+			ashWord(expected, op1, count);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execCsh, 3, 1, 0, count), op1, zeroWord);
+			cshWord(expected, op1, count);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execLsh, 3, 1, 0, count), op1, zeroWord);
+			lshWord(expected, op1, count);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execMask, 3, 1, 0, count), op1, zeroWord);
+			maskWord(expected, op1, count);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+		}
+
+		for (int j = 0; j < engine_nops; j++) {
+			const byte *op2 = engine_ops[j];
+
+			for (int k = 0; k < 18; k++) {
+				if (binary[k] != NULL) {
+					exec_one(&s, execEncode(execAnd + k, 3, 1, 2, 0), op1, op2);
+					binary[k](expected, op1, op2);
+					CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+				}
+			}
+
+			exec_one(&s, execEncode(execCmp, 3, 1, 2, 0), op1, op2);
+			CU_ASSERT_EQUAL((sword)loadWord(s.regs[3]), cmpWord(op1, op2));
+			exec_one(&s, execEncode(execCmpu, 3, 1, 2, 0), op1, op2);
+			CU_ASSERT_EQUAL((sword)loadWord(s.regs[3]), cmpuWord(op1, op2));
+			exec_one(&s, execEncode(execExtract, 3, 1, 2, 0), op1, op2);
+			extractField(expected, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execDeposit, 3, 1, 2, 0), op1, op2);
+			depositField(expected, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execCmpLtu, 3, 1, 2, 0), op1, op2);
+			CU_ASSERT_EQUAL(loadWord(s.regs[3]), cmpLtuWord(op1, op2));
+			exec_one(&s, execEncode(execCmpGeu, 3, 1, 2, 0), op1, op2);
+			CU_ASSERT_EQUAL(loadWord(s.regs[3]), cmpGeuWord(op1, op2));
+			exec_one(&s, execEncode(execMulHighu, 3, 1, 2, 0), op1, op2);
+			mulHighuWord(expected, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execDivu, 3, 1, 2, 0), op1, op2);
+			divuWord(expected, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			exec_one(&s, execEncode(execRemainderu, 3, 1, 2, 0), op1, op2);
+			remainderuWord(expected, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+
+			bit carry, overflow;
+			exec_one(&s, execEncode(execAddCarry, 3, 1, 2, 0), op1, op2);
+			addCarryWord(expected, &carry, &overflow, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			CU_ASSERT_EQUAL(s.carry, carry);
+			CU_ASSERT_EQUAL(s.overflow, overflow);
+			exec_one(&s, execEncode(execSubCarry, 3, 1, 2, 0), op1, op2);
+			subCarryWord(expected, &carry, &overflow, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			CU_ASSERT_EQUAL(s.carry, carry);
+			CU_ASSERT_EQUAL(s.overflow, overflow);
+
+			exec_one(&s, execEncode(execMulWide, 3, 1, 2, 4), op1, op2);
+			mulWideWord(expected, expected2, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			CU_ASSERT_WORD_EQUAL(s.regs[4], expected2);
+			exec_one(&s, execEncode(execDiv2, 3, 1, 2, 4), op1, op2);
+			div2Word(expected, expected2, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			CU_ASSERT_WORD_EQUAL(s.regs[4], expected2);
+			exec_one(&s, execEncode(execDiv2u, 3, 1, 2, 4), op1, op2);
+			div2uWord(expected, expected2, op1, op2);
+			CU_ASSERT_WORD_EQUAL(s.regs[3], expected);
+			CU_ASSERT_WORD_EQUAL(s.regs[4], expected2);
+		}
+	}
+
+	// sum of 1 .. 10 by a loop
+	const uint32_t sum[] = {
+		execEncode(execLoadImmediate, 1, 0, 0, 10),   // r1 = 10
+		execEncode(execLoadImmediate, 2, 0, 0, 0),    // r2 = 0
+		execEncode(execLoadImmediate, 3, 0, 0, 1),    // r3 = 1
+		execEncode(execAdd, 2, 2, 1, 0),              // loop: r2 += r1
+		execEncode(execSub, 1, 1, 3, 0),              // r1 -= 1
+		execEncode(execBranchNonzero, 0, 1, 0, -3),   // until r1 is 0
+		execEncode(execHalt, 0, 0, 0, 0),
+		execEncode(execMove, 4, 2, 0, 0),             // not reached
+	};
+	execInit(&s);
+	CU_ASSERT_EQUAL(execRun(&s, sum, 8, UINT64_MAX), 3 + 3 * 10 + 1);
+	CU_ASSERT_EQUAL(loadWord(s.regs[2]), 55);
+	CU_ASSERT_TRUE(testEqWord(s.regs[4]));
+	CU_ASSERT_EQUAL(s.pc, 6);  // on the halt
+	CU_ASSERT_EQUAL(s.counts[execAdd], 10);
+	CU_ASSERT_EQUAL(s.counts[execBranchNonzero], 10);
+	CU_ASSERT_EQUAL(s.counts[execHalt], 1);
+	CU_ASSERT_EQUAL(s.counts[execMove], 0);
+
+	// a run stopped by the limit resumes where it stopped
+	execInit(&s);
+	CU_ASSERT_EQUAL(execRun(&s, sum, 8, 5), 5);
+	CU_ASSERT_EQUAL(s.pc, 5);
+	CU_ASSERT_EQUAL(execRun(&s, sum, 8, UINT64_MAX), 3 * 10 + 1 - 2);
+	CU_ASSERT_EQUAL(loadWord(s.regs[2]), 55);
+	CU_ASSERT_EQUAL(s.counts[execAdd], 10);
+
+	// negative immediates, unknown opcodes and the end of the program stop
+	const uint32_t other[] = {
+		execEncode(execLoadImmediate, 5, 0, 0, -2048),
+		(uint32_t)execOps << 24,
+	};
+	execInit(&s);
+	CU_ASSERT_EQUAL(execRun(&s, other, 2, UINT64_MAX), 2);
+	CU_ASSERT_EQUAL((sword)loadWord(s.regs[5]), wordsize > 8 ? -2048 : 0);
+	CU_ASSERT_EQUAL(s.pc, 1);
+	CU_ASSERT_EQUAL(s.counts[execHalt], 1);
+	execInit(&s);
+	CU_ASSERT_EQUAL(execRun(&s, other, 1, UINT64_MAX), 1);
+	CU_ASSERT_EQUAL(s.pc, 1);
+}
+
+/** number of elements in parallel test arrays: several chunks and a partial one */
+#define PARALLEL_N (5 * PARALLEL_CHUNK + 37)
+
+/**
+ * Test parallel batch calls against single batch calls
+ */
+void test_parallel(void) {
+	// one extra element so that the results start off a cache line
+	word *op1 = malloc((PARALLEL_N + 1) * sizeof(word));
+	word *op2 = malloc((PARALLEL_N + 1) * sizeof(word));
+	word *result = malloc((PARALLEL_N + 1) * sizeof(word));
+	word *result2 = malloc((PARALLEL_N + 1) * sizeof(word));
+	word *expected = malloc(PARALLEL_N * sizeof(word));
+	word *expected2 = malloc(PARALLEL_N * sizeof(word));
+	bit *carry = malloc(PARALLEL_N), *overflow = malloc(PARALLEL_N);
+	bit *expectedCarry = malloc(PARALLEL_N), *expectedOverflow = malloc(PARALLEL_N);
+	uint64_t mask[(PARALLEL_N + 63) / 64], expectedMask[(PARALLEL_N + 63) / 64];
+	CU_ASSERT_FATAL(op1 != NULL && op2 != NULL && result != NULL && result2 != NULL
+			&& expected != NULL && expected2 != NULL && carry != NULL && overflow != NULL
+			&& expectedCarry != NULL && expectedOverflow != NULL);
+
+	uint32_t seed = 2026;
+	for (int i = 0; i < PARALLEL_N; i++) {
+		for (int b = 0; b < wordbytes; b++) {
+			seed = seed * 1103515245 + 12345;
+			op1[i][b] = (byte)(seed >> 16);
+			op2[i][b] = (byte)(seed >> 8);
+		}
+		if (i < engine_nops * engine_nops) {
+			setWord(op1[i], engine_ops[i / engine_nops]);
+			setWord(op2[i], engine_ops[i % engine_nops]);
+		}
+	}
+
+	microprogram p;
+	microInit(&p, 2);
+	CU_ASSERT_TRUE(microFuse(&p, microShift(&p, microAsh,
+			microBinary(&p, microMul, 0, 1), -3)));
+	const word *inputs[] = {op1, op2};
+
+	const int threads[] = {1, 2, 3, 4, 0};
+	for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+		CU_ASSERT_TRUE(parallelSetThreads(threads[t]));
+		CU_ASSERT_TRUE(parallelThreads() >= 1);
+		if (threads[t] > 0) {
+			CU_ASSERT_EQUAL(parallelThreads(), threads[t]);
+		}
+		for (int offset = 0; offset < 2; offset++) {
+			word *r = result + offset, *r2 = result2 + offset;
+
+			notWordN(expected, op1, PARALLEL_N);
+			parallelUnaryN(notWordN, r, op1, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+
+			mulWordN(expected, op1, op2, PARALLEL_N);
+			parallelBinaryN(mulWordN, r, op1, op2, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+
+			ashWordN(expected, op1, -5, PARALLEL_N);
+			parallelShiftN(ashWordN, r, op1, -5, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+
+			div2WordN(expected, expected2, op1, op2, PARALLEL_N);
+			parallelTwoResultN(div2WordN, r, r2, op1, op2, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+			CU_ASSERT_EQUAL(memcmp(r2, expected2, PARALLEL_N * sizeof(word)), 0);
+
+			addCarryWordN(expected, expectedCarry, expectedOverflow, op1, op2, PARALLEL_N);
+			parallelCarryN(addCarryWordN, r, carry, overflow, op1, op2, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+			CU_ASSERT_EQUAL(memcmp(carry, expectedCarry, PARALLEL_N), 0);
+			CU_ASSERT_EQUAL(memcmp(overflow, expectedOverflow, PARALLEL_N), 0);
+			parallelCarryN(subCarryWordN, r, NULL, NULL, op1, op2, PARALLEL_N);
+			subCarryWordN(expected, NULL, NULL, op1, op2, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+
+			microRunN(&p, expected, inputs, PARALLEL_N);
+			parallelMicroN(&p, r, inputs, PARALLEL_N);
+			CU_ASSERT_EQUAL(memcmp(r, expected, PARALLEL_N * sizeof(word)), 0);
+		}
+
+		testLtWordMask(expectedMask, op1, PARALLEL_N);
+		parallelTestN(testLtWordMask, mask, op1, PARALLEL_N);
+		CU_ASSERT_EQUAL(memcmp(mask, expectedMask, sizeof(mask)), 0);
+		cmpLtuWordMask(expectedMask, op1, op2, PARALLEL_N);
+		parallelCompareN(cmpLtuWordMask, mask, op1, op2, PARALLEL_N);
+		CU_ASSERT_EQUAL(memcmp(mask, expectedMask, sizeof(mask)), 0);
+
+		// small and empty calls run on the calling thread
+		parallelBinaryN(addWordN, result, op1, op2, 3);
+		addWordN(expected, op1, op2, 3);
+		CU_ASSERT_EQUAL(memcmp(result, expected, 3 * sizeof(word)), 0);
+		parallelBinaryN(addWordN, result, op1, op2, 0);
+	}
+	CU_ASSERT_TRUE(parallelSetThreads(PARALLEL_MAX_THREADS + 1));
+	CU_ASSERT_EQUAL(parallelThreads(), PARALLEL_MAX_THREADS);
+	CU_ASSERT_TRUE(parallelSetThreads(1));
+	CU_ASSERT_EQUAL(parallelThreads(), 1);
+
+	free(op1);
+	free(op2);
+	free(result);
+	free(result2);
+	free(expected);
+	free(expected2);
+	free(carry);
+	free(overflow);
+	free(expectedCarry);
+	free(expectedOverflow);
+}
+
+/** number of records in trace tests: every opcode and an invalid one twice over */
+#define TRACE_N (2 * (traceOps + 1) * BATCH_N)
+
+/**
+ * Compute a trace record with the alu.h functions.
+ *
+ * @param result the result
+ * @param record the record
+ * @return the flags
+ */
+static byte trace_expected(word result, const tracerecord *record) {
+	bit c = 0, v = 0;
+	intmax_t wide = (sword)loadWord(record->op2);
+	int count = (wide < INT_MIN) ? INT_MIN : (wide > INT_MAX) ? INT_MAX : (int)wide;
+	switch (record->op) {
+	case traceAdd:       addCarryWord(result, &c, &v, record->op1, record->op2); break;
+	case traceSub:       subCarryWord(result, &c, &v, record->op1, record->op2); break;
+	case traceMul:       mulWord(result, record->op1, record->op2); break;
+	case traceDiv:       divWord(result, record->op1, record->op2); break;
+	case traceRemainder: remainderWord(result, record->op1, record->op2); break;
+	case traceAnd:       andWord(result, record->op1, record->op2); break;
+	case traceOr:        orWord(result, record->op1, record->op2); break;
+	case traceXor:       xorWord(result, record->op1, record->op2); break;
+	case traceNot:       notWord(result, record->op1); break;
+	case traceNegative:  negativeWord(result, record->op1); break;
+	case traceAsh:       ashWord(result, record->op1, count); break;
+	case traceCsh:       cshWord(result, record->op1, count); break;
+	case traceLsh:       lshWord(result, record->op1, count); break;
+	case traceMask:      maskWord(result, record->op1, count); break;
+	case traceSmin:      sminWord(result, record->op1, record->op2); break;
+	case traceSmax:      smaxWord(result, record->op1, record->op2); break;
+	case traceUmin:      uminWord(result, record->op1, record->op2); break;
+	case traceUmax:      umaxWord(result, record->op1, record->op2); break;
+	default:
+		setWord(result, zeroWord);
+		return TRACE_FLAG_INVALID;
+	}
+	return (byte)((testLtWord(result) ? TRACE_FLAG_N : 0) | (testEqWord(result) ? TRACE_FLAG_Z : 0)
+			| (c ? TRACE_FLAG_C : 0) | (v ? TRACE_FLAG_V : 0));
+}
+
+/**
+ * Test the trace format and replay against the alu.h functions
+ */
+void test_trace(void) {
+	traceheader header;
+	traceHeader(&header);
+	CU_ASSERT_EQUAL(memcmp(header.magic, TRACE_MAGIC, 8), 0);
+	CU_ASSERT_EQUAL(header.wordsize, wordsize);
+	CU_ASSERT_TRUE(traceCheckHeader(&header));
+	header.endian = !header.endian;
+	CU_ASSERT_FALSE(traceCheckHeader(&header));
+	traceHeader(&header);
+	header.wordsize = (byte)(wordsize == 32 ? 64 : 32);
+	CU_ASSERT_FALSE(traceCheckHeader(&header));
+	traceHeader(&header);
+	header.magic[0] = 'X';
+	CU_ASSERT_FALSE(traceCheckHeader(&header));
+	CU_ASSERT_EQUAL(sizeof(tracerecord), 4 + 2 * wordbytes);
+
+	// records in a trace hold their words in the byte order of word.h
+	tracerecord record;
+	traceRecord(&record, traceSub, maxWord, minWord);
+	CU_ASSERT_EQUAL(record.op, traceSub);
+	CU_ASSERT_EQUAL(record.reserved[0] | record.reserved[1] | record.reserved[2], 0);
+	CU_ASSERT_EQUAL(memcmp(record.op1, maxWord, sizeof(word)), 0);
+	CU_ASSERT_EQUAL(memcmp(record.op2, minWord, sizeof(word)), 0);
+
+	// every opcode and an invalid one with every pair of engine operands,
+	// interleaved across more than one chunk, and small and large shift counts
+	word op1[BATCH_N], op2[BATCH_N];
+	fill_batch(op1, op2);
+	tracerecord *records = malloc(TRACE_N * sizeof(tracerecord));
+	word *result = malloc(TRACE_N * sizeof(word));
+	byte *flags = malloc(TRACE_N);
+	tracebuffer *buffer = malloc(sizeof(tracebuffer));
+	size_t invalid = 0;
+	for (int i = 0; i < TRACE_N; i++) {
+		int op = (i * 7) % (traceOps + 1);
+		word count;
+		storeWord(count, (uword)(i % (2 * wordsize + 5) - wordsize - 2));
+		traceRecord(&records[i], (traceop)op, op1[i % BATCH_N],
+				(i % 3 == 0) ? count : op2[i % BATCH_N]);
+		if (op == traceOps) {
+			records[i].op = (byte)(200 + i % 56);
+			invalid++;
+		}
+	}
+	CU_ASSERT_EQUAL(traceReplay(result, flags, records, TRACE_N, buffer), invalid);
+	int failures = 0;
+	for (int i = 0; i < TRACE_N; i++) {
+		word expected;
+		byte expectedFlags = trace_expected(expected, &records[i]);
+		failures += memcmp(result[i], expected, sizeof(word)) != 0 || flags[i] != expectedFlags;
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+
+	// replaying a part of a trace gives the same results
+	word part[3];
+	byte partFlags[3];
+	traceReplay(part, partFlags, records + TRACE_CHUNK - 1, 3, buffer);
+	CU_ASSERT_EQUAL(memcmp(part, result + TRACE_CHUNK - 1, sizeof(part)), 0);
+	CU_ASSERT_EQUAL(memcmp(partFlags, flags + TRACE_CHUNK - 1, sizeof(partFlags)), 0);
+	CU_ASSERT_EQUAL(traceReplay(result, flags, records, 0, buffer), 0);
+
+	free(records);
+	free(result);
+	free(flags);
+	free(buffer);
+}
+
+/**
+ * Returns the flags of a result as set in a wordbuf.
+ *
+ * @param result the result
+ * @param c the carry
+ * @param v the overflow
+ * @return the WORDBUF_FLAG bits
+ */
+static byte wordbuf_expected(const word result, bit c, bit v) {
+	return (byte)((testLtWord(result) ? WORDBUF_FLAG_N : 0) | (testEqWord(result) ? WORDBUF_FLAG_Z : 0)
+			| (c ? WORDBUF_FLAG_C : 0) | (v ? WORDBUF_FLAG_V : 0));
+}
+
+/**
+ * Test word buffers, their arenas and their operations
+ */
+void test_wordbuf(void) {
+	wordarena arena;
+	CU_ASSERT_TRUE(wordArenaInit(&arena, 2 * wordbufBytes(BATCH_N) + 1));
+	CU_ASSERT_EQUAL((uintptr_t)arena.base % WORDBUF_ALIGN, 0);
+	CU_ASSERT_EQUAL(arena.size % WORDBUF_ALIGN, 0);
+
+	// columns of a buffer are aligned and do not overlap
+	wordbuf a, b, c;
+	CU_ASSERT_TRUE(wordbufInit(&a, &arena, BATCH_N));
+	CU_ASSERT_TRUE(wordbufInit(&b, &arena, BATCH_N - 1));
+	CU_ASSERT_EQUAL(a.capacity, BATCH_N);
+	CU_ASSERT_EQUAL(a.n, 0);
+	const void *columns[] = {a.op1, a.op2, a.result, a.flags, b.op1, b.op2, b.result, b.flags};
+	for (int k = 0; k < 8; k++) {
+		CU_ASSERT_EQUAL((uintptr_t)columns[k] % WORDBUF_ALIGN, 0);
+	}
+	CU_ASSERT_TRUE((byte *)a.op2 >= (byte *)(a.op1 + BATCH_N));
+	CU_ASSERT_TRUE((byte *)a.result >= (byte *)(a.op2 + BATCH_N));
+	CU_ASSERT_TRUE((byte *)a.flags >= (byte *)(a.result + BATCH_N));
+	CU_ASSERT_TRUE((byte *)b.op1 >= a.flags + BATCH_N);
+
+	// a full arena refuses a buffer until it is reset
+	CU_ASSERT_FALSE(wordbufInit(&c, &arena, BATCH_N));
+	CU_ASSERT_TRUE(wordbufInit(&c, &arena, 0));
+	wordArenaReset(&arena);
+	CU_ASSERT_TRUE(wordbufInit(&c, &arena, BATCH_N));
+	CU_ASSERT_PTR_EQUAL(c.op1, a.op1);
+
+	// from word arrays and from interleaved pairs
+	word op1[BATCH_N], op2[BATCH_N], pairs[BATCH_N][2];
+	fill_batch(op1, op2);
+	for (int i = 0; i < BATCH_N; i++) {
+		setWord(pairs[i][0], op1[i]);
+		setWord(pairs[i][1], op2[i]);
+	}
+	wordbufLoad(&a, (const word *)op1, (const word *)op2, BATCH_N);
+	CU_ASSERT_EQUAL(a.n, BATCH_N);
+	CU_ASSERT_EQUAL(memcmp(a.op1, op1, sizeof(op1)), 0);
+	CU_ASSERT_EQUAL(memcmp(a.op2, op2, sizeof(op2)), 0);
+	memset(a.op1, 0, BATCH_N * sizeof(word));
+	memset(a.op2, 0, BATCH_N * sizeof(word));
+	wordbufLoadPairs(&a, (const word (*)[2])pairs, BATCH_N);
+	CU_ASSERT_EQUAL(memcmp(a.op1, op1, sizeof(op1)), 0);
+	CU_ASSERT_EQUAL(memcmp(a.op2, op2, sizeof(op2)), 0);
+
+	// add and subtract with flags, and flags of results set by a batch call
+	word result[BATCH_N];
+	byte flags[BATCH_N];
+	int failures = 0;
+	for (int k = 0; k < 3; k++) {
+		if (k == 0) {
+			wordbufAddCarry(&a);
+		} else if (k == 1) {
+			wordbufSubCarry(&a);
+		} else {
+			mulWordN(a.result, (const word *)a.op1, (const word *)a.op2, a.n);
+			wordbufSetFlags(&a);
+		}
+		wordbufStore(&a, result, flags);
+		for (int i = 0; i < BATCH_N; i++) {
+			word expected;
+			bit carry = 0, overflow = 0;
+			if (k == 0) {
+				addCarryWord(expected, &carry, &overflow, op1[i], op2[i]);
+			} else if (k == 1) {
+				subCarryWord(expected, &carry, &overflow, op1[i], op2[i]);
+			} else {
+				mulWord(expected, op1[i], op2[i]);
+			}
+			failures += memcmp(result[i], expected, sizeof(word)) != 0
+					|| flags[i] != wordbuf_expected(expected, carry, overflow);
+		}
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+
+	// a partial buffer leaves the rest of its columns alone
+	memset(a.flags, 0xFF, BATCH_N);
+	wordbufLoad(&a, (const word *)op1, NULL, 65);
+	wordbufSetFlags(&a);
+	CU_ASSERT_EQUAL(a.flags[64], wordbuf_expected(a.result[64], 0, 0));
+	CU_ASSERT_EQUAL(a.flags[65], 0xFF);
+
+	wordArenaFree(&arena);
+	CU_ASSERT_PTR_NULL(arena.base);
+}
+
+/** number of jobs submitted by each producer thread of test_async */
+#define ASYNC_JOBS 200
+
+/** elements of the operand arrays of test_async */
+#define ASYNC_N (ASYNC_COALESCE + 2 * BATCH_N)
+
+static word async_op1[ASYNC_N], async_op2[ASYNC_N];
+
+/** gate of the job that holds the single worker of test_async */
+static atomic_bool async_entered, async_open;
+
+/** completions counted by async_count */
+static atomic_int async_completions;
+
+/**
+ * Callback that holds the worker until the gate opens.
+ *
+ * @param job the job
+ */
+static void async_gate(asyncjob *job) {
+	(void)job;
+	atomic_store(&async_entered, true);
+	while (!atomic_load(&async_open)) {
+		sched_yield();
+	}
+}
+
+/**
+ * Callback that counts completions.
+ *
+ * @param job the job
+ */
+static void async_count(asyncjob *job) {
+	(void)job;
+	atomic_fetch_add(&async_completions, 1);
+}
+
+/**
+ * Describes job i of a test: its kind, function, operands and size.
+ *
+ * @param job the job
+ * @param result the result array of the job
+ * @param i the number of the job
+ */
+static void async_job(asyncjob *job, word *result, int i) {
+	memset(job, 0, sizeof(*job));
+	size_t start = (size_t)(i * 7) % BATCH_N;
+	job->result = result;
+	job->op1 = (const word *)async_op1 + start;
+	job->op2 = (const word *)async_op2 + start;
+	job->n = (size_t)(i * 13) % BATCH_N;
+	switch (i % 4) {
+	case 0:
+		job->kind = asyncBinary;
+		job->f.binary = addWordN;
+		break;
+	case 1:
+		job->kind = asyncBinary;
+		job->f.binary = mulWordN;
+		break;
+	case 2:
+		job->kind = asyncShift;
+		job->f.shift = ashWordN;
+		job->count = (i % 8 == 2) ? -3 : 5;
+		break;
+	default:
+		job->kind = asyncUnary;
+		job->f.unary = notWordN;
+		break;
+	}
+}
+
+/**
+ * Returns whether the results of a completed job match a direct
+ * call of its batch function.
+ *
+ * @param job the job
+ * @return true if the results match
+ */
+static bool async_check(const asyncjob *job) {
+	word expected[ASYNC_N];
+	switch (job->kind) {
+	case asyncUnary:
+		job->f.unary(expected, job->op1, job->n);
+		break;
+	case asyncBinary:
+		job->f.binary(expected, job->op1, job->op2, job->n);
+		break;
+	case asyncShift:
+		job->f.shift(expected, job->op1, job->count, job->n);
+		break;
+	}
+	return memcmp(expected, job->result, job->n * sizeof(word)) == 0;
+}
+
+/** definition of the jobs of one producer thread */
+typedef struct asyncproducer {
+	asyncjob jobs[ASYNC_JOBS];
+	word results[ASYNC_JOBS][BATCH_N];
+	int first;
+} asyncproducer;
+
+/**
+ * Body of a producer thread: submits its jobs, retrying while the
+ * ring is full.
+ *
+ * @param arg the producer
+ * @return NULL
+ */
+static void *async_produce(void *arg) {
+	asyncproducer *p = arg;
+	for (int i = 0; i < ASYNC_JOBS; i++) {
+		async_job(&p->jobs[i], p->results[i], p->first + i);
+		p->jobs[i].done = async_count;
+		while (!asyncSubmit(&p->jobs[i])) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Test asynchronous batch jobs, their coalescing and submission
+ * from several threads
+ */
+void test_async(void) {
+	fill_batch(async_op1, async_op2);
+	uint32_t seed = 2026;
+	for (int i = BATCH_N; i < ASYNC_N; i++) {
+		for (int b = 0; b < wordbytes; b++) {
+			seed = seed * 1103515245 + 12345;
+			async_op1[i][b] = (byte)(seed >> 16);
+			async_op2[i][b] = (byte)(seed >> 8);
+		}
+	}
+
+	asyncjob job;
+	word result[ASYNC_N];
+	async_job(&job, result, 1);
+	CU_ASSERT_FALSE(asyncSubmit(&job));
+	CU_ASSERT_TRUE(asyncStart(1));
+	CU_ASSERT_FALSE(asyncStart(1));
+
+	// a job that is waited for
+	CU_ASSERT_TRUE(asyncSubmit(&job));
+	asyncWait(&job);
+	CU_ASSERT_TRUE(asyncDone(&job));
+	CU_ASSERT_TRUE(async_check(&job));
+
+	// jobs queued behind a held worker are coalesced, large ones run alone
+	enum { QUEUED = 40 };
+	static asyncjob queued[QUEUED + 1];
+	static word results[QUEUED][BATCH_N];
+	word gateResult[1];
+	asyncjob gate = {
+		.kind = asyncUnary, .f.unary = notWordN, .result = gateResult,
+		.op1 = (const word *)async_op1, .n = 1, .done = async_gate
+	};
+	atomic_store(&async_entered, false);
+	atomic_store(&async_open, false);
+	CU_ASSERT_TRUE(asyncSubmit(&gate));
+	while (!atomic_load(&async_entered)) {
+		sched_yield();
+	}
+	asyncstats before, after;
+	asyncStats(&before);
+	for (int i = 0; i < QUEUED; i++) {
+		async_job(&queued[i], results[i], i);
+		CU_ASSERT_TRUE(asyncSubmit(&queued[i]));
+	}
+	async_job(&queued[QUEUED], result, 1);
+	queued[QUEUED].n = ASYNC_N;
+	queued[QUEUED].op1 = (const word *)async_op1;
+	queued[QUEUED].op2 = (const word *)async_op2;
+	CU_ASSERT_TRUE(asyncSubmit(&queued[QUEUED]));
+	atomic_store(&async_open, true);
+	asyncWait(&gate);
+	int failures = 0;
+	for (int i = 0; i <= QUEUED; i++) {
+		asyncWait(&queued[i]);
+		failures += !async_check(&queued[i]);
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+	asyncStats(&after);
+	CU_ASSERT_EQUAL(after.jobs - before.jobs, QUEUED + 2);
+	CU_ASSERT_TRUE(after.coalesced - before.coalesced >= QUEUED / 2);
+	CU_ASSERT_TRUE(after.calls - before.calls < QUEUED / 2);
+	asyncStop();
+	CU_ASSERT_FALSE(asyncSubmit(&job));
+
+	// several producers and workers
+	static asyncproducer producers[3];
+	pthread_t threads[3];
+	atomic_store(&async_completions, 0);
+	CU_ASSERT_TRUE(asyncStart(3));
+	for (int t = 0; t < 3; t++) {
+		producers[t].first = t * ASYNC_JOBS;
+		CU_ASSERT_EQUAL(pthread_create(&threads[t], NULL, async_produce, &producers[t]), 0);
+	}
+	failures = 0;
+	for (int t = 0; t < 3; t++) {
+		pthread_join(threads[t], NULL);
+		for (int i = 0; i < ASYNC_JOBS; i++) {
+			asyncWait(&producers[t].jobs[i]);
+			failures += !async_check(&producers[t].jobs[i]);
+		}
+	}
+	CU_ASSERT_EQUAL(failures, 0);
+	CU_ASSERT_EQUAL(atomic_load(&async_completions), 3 * ASYNC_JOBS);
+	asyncStats(&after);
+	CU_ASSERT_EQUAL(after.jobs, 3 * ASYNC_JOBS);
+	asyncStop();
+}
+
+/**
+ * Test every SIMD kernel set available on this CPU
+ */
+void test_simd(void) {
+	word op1[SIMD_N], op2[SIMD_N];
+	int counts[SIMD_N];
+
+	// engine operands plus a deterministic pseudo-random sequence
+	uint32_t seed = 12345;
+	for (int i = 0; i < SIMD_N; i++) {
+		seed = seed * 1103515245 + 12345;
+		if (i < engine_nops) {
+			setWord(op1[i], engine_ops[i]);
+			setWord(op2[i], engine_ops[engine_nops - 1 - i]);
+		} else {
+			for (int b = 0; b < wordbytes; b++) {
+				op1[i][b] = (byte)(seed >> (8 + b));
+				op2[i][b] = (byte)(seed >> (16 - b));
+			}
+			if (i % 5 == 0) {
+				setWord(op2[i], zeroWord);
+			}
+		}
+		counts[i] = (i % 17 == 0) ? INT_MIN : (int)(seed % 81) - 40;
+	}
+
+	const char *names[] = {"scalar", "sse2", "avx2", "neon"};
+	for (size_t k = 0; k < sizeof(names) / sizeof(names[0]); k++) {
+		if (selectBatchKernels(names[k])) {
+			check_simd((const word *)op1, (const word *)op2, counts);
+		}
+	}
+	CU_ASSERT_TRUE(selectBatchKernels(NULL));
+}
+
 /**
  * Test all the functions for this application.
  *
@@ -499,14 +3000,36 @@ static CU_ErrorCode test_all() {
 	CU_initialize_registry();
 
 	// add a suite to the registry with no init or cleanup
-	CU_pSuite pSuite = CU_add_suite("word_tests", NULL, NULL);
+	CU_pSuite pSuite = CU_add_suite("word_tests", init_engine_ops, NULL);
 
 	// add the tests to the suite
+	CU_add_test(pSuite, "test_width", test_width);
+#if WORDSIZE == 32 && !defined(WORD_LITTLE_ENDIAN)
 	CU_add_test(pSuite, "test_word", test_word);
 	CU_add_test(pSuite, "test_math", test_math);
+	CU_add_test(pSuite, "test_carry", test_carry);
 	CU_add_test(pSuite, "test_compare", test_compare);
 	CU_add_test(pSuite, "test_shift", test_shift);
 	CU_add_test(pSuite, "test_logical", test_logical);
+#endif
+	CU_add_test(pSuite, "test_engines", test_engines);
+	CU_add_test(pSuite, "test_diff", test_diff);
+	CU_add_test(pSuite, "test_bits", test_bits);
+	CU_add_test(pSuite, "test_unsigned", test_unsigned);
+	CU_add_test(pSuite, "test_flags", test_flags);
+	CU_add_test(pSuite, "test_mp", test_mp);
+	CU_add_test(pSuite, "test_instrument", test_instrument);
+	CU_add_test(pSuite, "test_memo", test_memo);
+	CU_add_test(pSuite, "test_batch", test_batch);
+	CU_add_test(pSuite, "test_divisor", test_divisor);
+	CU_add_test(pSuite, "test_sat", test_sat);
+	CU_add_test(pSuite, "test_micro", test_micro);
+	CU_add_test(pSuite, "test_exec", test_exec);
+	CU_add_test(pSuite, "test_parallel", test_parallel);
+	CU_add_test(pSuite, "test_trace", test_trace);
+	CU_add_test(pSuite, "test_wordbuf", test_wordbuf);
+	CU_add_test(pSuite, "test_async", test_async);
+	CU_add_test(pSuite, "test_simd", test_simd);
 
 	// run all test suites using the basic interface
 	CU_basic_set_mode(CU_BRM_VERBOSE);
@@ -5,12 +5,19 @@
  * of a sequence of bytes. The word has a defined set of
  * characteristics including number of bytes and endian order.
  *
+ * When WORD_INLINE is defined, word.h includes this file and
+ * the functions are static inline.
+ *
  * @since 2019-01-15
  * @uathor: philip gust
  */
 
+#ifndef WORD_C_
+#define WORD_C_
+
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "word.h"
 
@@ -21,19 +28,13 @@
  * @param bitofword the bit number to set
  * @param val the bit value
  */
-void setBitOfWord(word op, unsigned bitofword, bit val) {
-	unsigned byteno = bitofword >> 3;  // divide by 8
-	if (wordendian == bigendian) {
-		byteno = (wordbytes-1) - byteno;
-	}
+WORD_API void setBitOfWord(word op, unsigned bitofword, bit val) {
+	unsigned byteno = wordByteIndex(bitofword >> 3);  // divide by 8
 
 	unsigned bitofbyte = bitofword & 0x7;  // mod 8
 	byte mask = 1 << bitofbyte; // mask for bit
-	if (val == 0) {
-		op[byteno] &=  ~mask;
-	} else {
-		op[byteno] |= mask;
-	}
+	byte fill = (byte)(0u - toBit(val)); // all ones if val is 1
+	op[byteno] = (op[byteno] & ~mask) | (fill & mask);
 }
 
 /**
@@ -44,11 +45,8 @@ void setBitOfWord(word op, unsigned bitofword, bit val) {
  * @param the bit number to get
  * @return the bit value
  */
-bit getBitOfWord(const word op, unsigned bitofword) {
-	unsigned byteno = bitofword >> 3;  // divide by 8
-	if (wordendian == bigendian) {
-		byteno = (wordbytes-1) - byteno;
-	}
+WORD_API bit getBitOfWord(const word op, unsigned bitofword) {
+	unsigned byteno = wordByteIndex(bitofword >> 3);  // divide by 8
 	unsigned bitofbyte = bitofword & 0x7;  // mod 8
 	return toBit(op[byteno] >> bitofbyte); // extract bit
 }
@@ -59,8 +57,52 @@ bit getBitOfWord(const word op, unsigned bitofword) {
  * @param result the result
  * @param op the operand
  */
-void setWord(word result, const word op) {
+WORD_API void setWord(word result, const word op) {
+	wordUnroll
 	for (int b = 0; b < wordbytes; b++) {
 		result[b] = op[b];
 	}
 }
+
+/**
+ * Load an array of words as native unsigned integers.
+ *
+ * @param result the native values
+ * @param op the operands
+ * @param n the number of elements
+ */
+WORD_API void loadWords(uword *result, const word *op, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+#if defined(WORD_HOST_ORDER)
+		memcpy(&result[i], op[i], sizeof(uword));
+#elif defined(WORD_SWAPPED_ORDER)
+		uword val;
+		memcpy(&val, op[i], sizeof(uword));
+		result[i] = swapBytes(val);
+#else
+		result[i] = loadWord(op[i]);
+#endif
+	}
+}
+
+/**
+ * Store an array of native unsigned integers into words.
+ *
+ * @param result the results
+ * @param val the native values
+ * @param n the number of elements
+ */
+WORD_API void storeWords(word *result, const uword *val, size_t n) {
+	for (size_t i = 0; i < n; i++) {
+#if defined(WORD_HOST_ORDER)
+		memcpy(result[i], &val[i], sizeof(uword));
+#elif defined(WORD_SWAPPED_ORDER)
+		uword swapped = swapBytes(val[i]);
+		memcpy(result[i], &swapped, sizeof(uword));
+#else
+		storeWord(result[i], val[i]);
+#endif
+	}
+}
+
+#endif /* WORD_C_ */
@@ -9,17 +9,71 @@
  * @uathor: philip gust
  */
 
+#ifndef WORD_H_
+#define WORD_H_
+
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+/**
+ * Number of bits in a word, chosen at build time with
+ * -DWORDSIZE=8, 16, 32 or 64. The native integer types and
+ * word constants below are generated from this definition.
+ */
+#ifndef WORDSIZE
+#define WORDSIZE 32
+#endif
+
+/** number of bytes in a word */
+#define WORDBYTES (WORDSIZE / 8)
+
+#if WORDSIZE == 8
+/** native unsigned integer holding the bits of a word */
+typedef uint8_t uword;
+/** native signed integer holding the bits of a word */
+typedef int8_t sword;
+/** initializers of big- and little-endian words from their top and other bytes */
+#define wordBytesBig(top, rest) {top}
+#define wordBytesLittle(top, rest) {top}
+#elif WORDSIZE == 16
+typedef uint16_t uword;
+typedef int16_t sword;
+#define wordBytesBig(top, rest) {top, rest}
+#define wordBytesLittle(top, rest) {rest, top}
+#elif WORDSIZE == 32
+typedef uint32_t uword;
+typedef int32_t sword;
+#define wordBytesBig(top, rest) {top, rest, rest, rest}
+#define wordBytesLittle(top, rest) {rest, rest, rest, top}
+#elif WORDSIZE == 64
+typedef uint64_t uword;
+typedef int64_t sword;
+#define wordBytesBig(top, rest) {top, rest, rest, rest, rest, rest, rest, rest}
+#define wordBytesLittle(top, rest) {rest, rest, rest, rest, rest, rest, rest, top}
+#else
+#error "WORDSIZE must be 8, 16, 32 or 64"
+#endif
+
+/**
+ * Unroll the following loop over the bytes of a word.
+ * The trip count is a constant, so each width compiles
+ * to straight-line code.
+ */
+#if defined(__GNUC__)
+#define wordUnroll _Pragma("GCC unroll 8")
+#else
+#define wordUnroll
+#endif
+
 /** number of bits in a word */
-static const int wordsize = 32;
+static const int wordsize = WORDSIZE;
 
 /** top bit of a word */
-static const int wordtopbit = 31; // wordsize-1
+static const int wordtopbit = WORDSIZE - 1; // wordsize-1
 
 /** number of bytes in a word */
-static const int wordbytes = 4; // wordsize>>3
+static const int wordbytes = WORDBYTES; // wordsize>>3
 
 /** Definition of a bit */
 typedef bool bit;
@@ -34,22 +88,65 @@ typedef bool bit;
 typedef uint8_t byte;
 
 /** definition of a word as a sequence of wordbytes bytes */
-typedef byte word[4];  // wordbytes
+typedef byte word[WORDBYTES];
 
 /** definition of endian designators */
 typedef enum endian { bigendian, littleendian} endian;
 
-/** endian configuration of word  */
+/**
+ * Endian configuration of word, chosen at build time:
+ * big-endian unless WORD_LITTLE_ENDIAN is defined. The
+ * byte index of each bit and the word constants are
+ * generated for that order, so accessors do not branch
+ * on it.
+ */
+#ifdef WORD_LITTLE_ENDIAN
+static const endian wordendian = littleendian;
+/** initializer of a word from its top and other bytes */
+#define wordBytes wordBytesLittle
+/** index of the byte holding bits 8n to 8n+7 of a word */
+#define wordByteIndex(n) (n)
+#else
 static const endian wordendian = bigendian;
+#define wordBytes wordBytesBig
+#define wordByteIndex(n) ((WORDBYTES - 1) - (n))
+#endif
+
+/**
+ * Whether words are stored in host byte order, so that
+ * their bytes can be copied to a native integer as is, or
+ * in the reverse order, so that the bytes must be swapped.
+ * Neither is defined if the host order is unknown.
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if defined(WORD_LITTLE_ENDIAN) == (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define WORD_HOST_ORDER 1
+#else
+#define WORD_SWAPPED_ORDER 1
+#endif
+#endif
 
 /** word representing 0 */
-static const word zeroWord = {0x0, 0x0, 0x0, 0x0};
+static const word zeroWord = wordBytes(0x0, 0x0);
+
+/** word representing largest positive word */
+static const word maxWord = wordBytes(0x7F, 0xFF);
 
-/** word representing largest positive word -- modify if endian changes */
-static const word maxWord = {0x7F, 0xFF, 0xFF, 0xFF};	// big-endian
+/** word representing largest negative word */
+static const word minWord = wordBytes(0x80, 0x0);
 
-/** word representing largest negative word - modify if endian changes */
-static const word minWord = {0x80, 0x0, 0x0, 0x0};	// big-endian
+/**
+ * Linkage of the word accessors. By default they are
+ * defined in word.c. Defining WORD_INLINE makes word.h
+ * header-only: word.c is included here and its functions
+ * become static inline, so the compiler can fold them into
+ * the loops of each translation unit without LTO.
+ */
+#ifdef WORD_INLINE
+#define WORD_API static inline
+#else
+#define WORD_API
+#endif
 
 /**
  * Set bit of word to specified bit.
@@ -58,7 +155,7 @@ static const word minWord = {0x80, 0x0, 0x0, 0x0};	// big-endian
  * @param bitofword the bit number to set
  * @param val the bit value
  */
-void setBitOfWord(word op, unsigned bitofword, bit bit);
+WORD_API void setBitOfWord(word op, unsigned bitofword, bit bit);
 
 /**
  * Get bit of word.
@@ -68,7 +165,7 @@ void setBitOfWord(word op, unsigned bitofword, bit bit);
  * @param the bit number to get
  * @return the bit value
  */
-bit getBitOfWord(const word op, unsigned bitofword);
+WORD_API bit getBitOfWord(const word op, unsigned bitofword);
 
 /**
  * Set word to word operand.
@@ -76,5 +173,91 @@ bit getBitOfWord(const word op, unsigned bitofword);
  * @param result the result
  * @param op the operand
  */
-void setWord(word result, const word op);
+WORD_API void setWord(word result, const word op);
+
+/**
+ * Load word as a native unsigned integer. Bit n of the
+ * word becomes bit n of the integer, in agreement with
+ * getBitOfWord().
+ *
+ * Defined inline so the word is read in a single load
+ * rather than one byte index computation per bit.
+ *
+ * @param op the operand
+ * @return the native value of the word
+ */
+static inline uword loadWord(const word op) {
+	uword val = 0;
+	wordUnroll
+	for (int b = 0; b < WORDBYTES; b++) {
+		val |= (uword)op[wordByteIndex(b)] << (8 * b);
+	}
+	return val;
+}
+
+/**
+ * Store native unsigned integer into word. Bit n of the
+ * integer becomes bit n of the word, in agreement with
+ * setBitOfWord().
+ *
+ * @param result the result
+ * @param val the native value
+ */
+static inline void storeWord(word result, uword val) {
+	wordUnroll
+	for (int b = 0; b < WORDBYTES; b++) {
+		result[wordByteIndex(b)] = (byte)(val >> (8 * b));
+	}
+}
+
+/**
+ * Reverse the bytes of a native unsigned integer, which
+ * converts it between big- and little-endian order.
+ *
+ * @param val the native value
+ * @return the value with its bytes reversed
+ */
+static inline uword swapBytes(uword val) {
+#if defined(__GNUC__) && WORDSIZE == 16
+	return __builtin_bswap16(val);
+#elif defined(__GNUC__) && WORDSIZE == 32
+	return __builtin_bswap32(val);
+#elif defined(__GNUC__) && WORDSIZE == 64
+	return __builtin_bswap64(val);
+#else
+	uword swapped = 0;
+	wordUnroll
+	for (int b = 0; b < WORDBYTES; b++) {
+		swapped |= (uword)(byte)(val >> (8 * b)) << (8 * (WORDBYTES - 1 - b));
+	}
+	return swapped;
+#endif
+}
+
+/**
+ * Load an array of words as native unsigned integers, as
+ * if by loadWord() on each element. Words are copied in
+ * bulk and byte swapped if their order differs from the
+ * host, so the loop can be vectorized.
+ *
+ * @param result the native values
+ * @param op the operands
+ * @param n the number of elements
+ */
+WORD_API void loadWords(uword *result, const word *op, size_t n);
+
+/**
+ * Store an array of native unsigned integers into words,
+ * as if by storeWord() on each element.
+ *
+ * @param result the results
+ * @param val the native values
+ * @param n the number of elements
+ */
+WORD_API void storeWords(word *result, const uword *val, size_t n);
+
+#ifdef WORD_INLINE
+#include "word.c"
+#endif
 
+#endif /* WORD_H_ */